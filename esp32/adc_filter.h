@@ -0,0 +1,106 @@
+/**
+ * Joystick Axis Filter - integer only
+ * Per-axis conditioning for oversampled 12-bit ADC readings:
+ *   1. optional median of the last three samples (kills single-sample spikes)
+ *   2. first-order IIR, y += (x - y) / 2^iirShift, state in Q16 counts
+ *   3. calibration: center/end points to a Q15 axis with a deadzone that
+ *      is rescaled out, so output leaves zero smoothly instead of jumping
+ * No Arduino or IDF dependencies; host/input_host.cpp runs it on the host.
+ */
+
+#ifndef ADC_FILTER_H
+#define ADC_FILTER_H
+
+#include <stdint.h>
+
+const int32_t ADC_RAW_MAX = 4095;          // 12-bit SAR
+const int32_t AXIS_Q15_FULL = 32767;
+
+struct AxisFilterConfig {
+    uint8_t iirShift;      // Time constant = 2^iirShift samples
+    bool median;           // Median-of-3 before the IIR
+};
+
+inline AxisFilterConfig defaultAxisFilterConfig() {
+    // At 2 kHz per axis: 16-sample (8 ms) time constant
+    AxisFilterConfig config = {4, true};
+    return config;
+}
+
+struct AxisCalibration {
+    int32_t minRaw;        // Full negative deflection
+    int32_t center;        // At rest
+    int32_t maxRaw;        // Full positive deflection
+    int32_t deadzoneQ15;   // |axis| below this reads 0
+};
+
+inline AxisCalibration defaultAxisCalibration() {
+    // Nominal pot travel, 2% deadzone
+    AxisCalibration calibration = {0, ADC_RAW_MAX / 2, ADC_RAW_MAX, AXIS_Q15_FULL / 50};
+    return calibration;
+}
+
+class AxisFilter {
+public:
+    AxisFilter() : config(defaultAxisFilterConfig()), filtered(0), count(0) {
+        history[0] = history[1] = history[2] = 0;
+    }
+
+    void configure(const AxisFilterConfig& newConfig) { config = newConfig; }
+
+    // Start from a known reading instead of ramping up from zero
+    void reset(uint16_t raw) {
+        history[0] = history[1] = history[2] = raw;
+        filtered = (int32_t)raw << 16;
+        count = 3;
+    }
+
+    void push(uint16_t raw) {
+        if (count == 0) {
+            reset(raw);
+            return;
+        }
+        history[0] = history[1];
+        history[1] = history[2];
+        history[2] = raw;
+
+        int32_t x = config.median ? median3(history[0], history[1], history[2]) : raw;
+        filtered += ((x << 16) - filtered) >> config.iirShift;
+    }
+
+    // Filtered reading in Q16 ADC counts
+    int32_t valueQ16() const { return filtered; }
+
+    // Calibrated axis in [-32767, 32767]
+    int16_t axisQ15(const AxisCalibration& cal) const {
+        // Round Q16 counts to the nearest 1/16 count for the scaling below
+        int32_t value = (filtered + (1 << 11)) >> 12;
+        int32_t offset = value - (cal.center << 4);
+        int32_t span = ((offset >= 0) ? (cal.maxRaw - cal.center) : (cal.center - cal.minRaw)) << 4;
+        if (span <= 0) return 0;
+
+        int32_t magnitude = offset >= 0 ? offset : -offset;
+        int32_t q15 = (int32_t)(((int64_t)magnitude * AXIS_Q15_FULL) / span);
+        if (q15 > AXIS_Q15_FULL) q15 = AXIS_Q15_FULL;
+
+        // Rescale past the deadzone so the output starts at 0
+        if (q15 <= cal.deadzoneQ15) return 0;
+        q15 = (int32_t)(((int64_t)(q15 - cal.deadzoneQ15) * AXIS_Q15_FULL) /
+                        (AXIS_Q15_FULL - cal.deadzoneQ15));
+        return (int16_t)(offset >= 0 ? q15 : -q15);
+    }
+
+private:
+    static int32_t median3(int32_t a, int32_t b, int32_t c) {
+        if (a > b) { int32_t t = a; a = b; b = t; }
+        if (b > c) b = c;
+        return a > b ? a : b;
+    }
+
+    AxisFilterConfig config;
+    int32_t history[3];
+    int32_t filtered;      // Q16 counts
+    uint8_t count;
+};
+
+#endif // ADC_FILTER_H
@@ -0,0 +1,166 @@
+/**
+ * Continuous ADC Joystick Input
+ * The ADC1 digital controller scans the three pot channels at
+ * ADC_SAMPLE_RATE_HZ and DMAs the conversions into the driver's ring buffer;
+ * a low-priority task on core 0 drains it in ADC_FRAME_BYTES frames and runs
+ * every sample through AxisFilter (adc_filter.h). The physics task reads the
+ * latest filtered axes from a TripleBuffer: no conversions and no waiting on
+ * its side.
+ *
+ * Uses the ESP-IDF 4.4 continuous-mode driver (driver/adc.h) shipped with
+ * the Arduino-ESP32 2.x core.
+ */
+
+#ifndef ADC_INPUT_H
+#define ADC_INPUT_H
+
+#include <Arduino.h>
+#include <driver/adc.h>
+#include <atomic>
+#include "adc_filter.h"
+#include "snapshot.h"
+
+const int ADC_AXES = 3;
+const uint32_t ADC_SAMPLE_RATE_HZ = ADC_AXES * 2000;     // 2 kHz per axis
+const uint32_t ADC_FRAME_BYTES = 256;                     // 64 conversions per read
+const uint32_t ADC_POOL_BYTES = 4 * ADC_FRAME_BYTES;
+
+// Filtered axes as published to the physics task
+struct AdcAxes {
+    int16_t q15[ADC_AXES];     // Calibrated, deadzoned: [-32767, 32767]
+    int32_t rawQ16[ADC_AXES];  // Filtered counts (for calibration)
+    uint32_t samples;          // Conversions consumed so far
+};
+
+class AdcJoystickInput {
+public:
+    AdcJoystickInput() : task(nullptr), running(false), samples(0), overruns(0) {
+        for (int i = 0; i < ADC_AXES; i++) {
+            channels[i] = -1;
+            calibration[i] = defaultAxisCalibration();
+        }
+    }
+
+    // Configure the scan over the three pins and start the reader task.
+    // false if a pin has no ADC1 channel or the driver refused.
+    bool begin(const int pins[ADC_AXES], const AxisFilterConfig& config,
+               BaseType_t core, UBaseType_t priority) {
+        uint32_t channelMask = 0;
+        adc_digi_pattern_config_t pattern[ADC_AXES] = {};
+
+        for (int i = 0; i < ADC_AXES; i++) {
+            channels[i] = digitalPinToAnalogChannel(pins[i]);
+            if (channels[i] < 0 || channels[i] >= SOC_ADC_CHANNEL_NUM(0)) return false;
+            channelMask |= 1u << channels[i];
+            filters[i].configure(config);
+
+            pattern[i].atten = ADC_ATTEN_DB_11;
+            pattern[i].channel = channels[i];
+            pattern[i].unit = 0;                  // ADC1
+            pattern[i].bit_width = SOC_ADC_DIGI_MAX_BITWIDTH;
+        }
+
+        adc_digi_init_config_t init = {};
+        init.max_store_buf_size = ADC_POOL_BYTES;
+        init.conv_num_each_intr = ADC_FRAME_BYTES;
+        init.adc1_chan_mask = channelMask;
+        init.adc2_chan_mask = 0;
+        if (adc_digi_initialize(&init) != ESP_OK) return false;
+
+        adc_digi_configuration_t digi = {};
+        digi.conv_limit_en = false;
+        digi.conv_limit_num = 250;
+        digi.pattern_num = ADC_AXES;
+        digi.adc_pattern = pattern;
+        digi.sample_freq_hz = ADC_SAMPLE_RATE_HZ;
+        digi.conv_mode = ADC_CONV_SINGLE_UNIT_1;
+        digi.format = ADC_DIGI_OUTPUT_FORMAT_TYPE2;
+        if (adc_digi_controller_configure(&digi) != ESP_OK || adc_digi_start() != ESP_OK) {
+            adc_digi_deinitialize();
+            return false;
+        }
+
+        running = true;
+        xTaskCreatePinnedToCore(readerTask, "adc", 3072, this, priority, &task, core);
+        return true;
+    }
+
+    // Physics side: latest filtered axes; false until the first frame
+    bool read(AdcAxes& axes) {
+        if (!published.update() && !hasData) return false;
+        hasData = true;
+        axes = published.read();
+        return true;
+    }
+
+    // Take the next filtered readings as the rest position (sticks centered)
+    void calibrateCenter() { centerRequested.store(true); }
+
+    uint32_t getOverruns() const { return overruns; }
+
+private:
+    static void readerTask(void* arg) {
+        static_cast<AdcJoystickInput*>(arg)->drain();
+    }
+
+    void drain() {
+        uint8_t frame[ADC_FRAME_BYTES];
+
+        while (running) {
+            uint32_t length = 0;
+            esp_err_t err = adc_digi_read_bytes(frame, sizeof(frame), &length, ADC_MAX_DELAY);
+            if (err == ESP_ERR_INVALID_STATE) {
+                // Ring buffer overflowed: samples lost, data still valid
+                overruns++;
+            } else if (err != ESP_OK) {
+                continue;
+            }
+
+            for (uint32_t offset = 0; offset + SOC_ADC_DIGI_RESULT_BYTES <= length;
+                 offset += SOC_ADC_DIGI_RESULT_BYTES) {
+                const adc_digi_output_data_t* result =
+                    reinterpret_cast<const adc_digi_output_data_t*>(frame + offset);
+                if (result->type2.unit != 0) continue;
+
+                for (int i = 0; i < ADC_AXES; i++) {
+                    if (result->type2.channel == (uint32_t)channels[i]) {
+                        filters[i].push(result->type2.data);
+                        samples++;
+                        break;
+                    }
+                }
+            }
+
+            if (centerRequested.exchange(false)) {
+                for (int i = 0; i < ADC_AXES; i++) {
+                    calibration[i].center = (filters[i].valueQ16() + (1 << 15)) >> 16;
+                }
+            }
+
+            AdcAxes& axes = published.writeSlot();
+            for (int i = 0; i < ADC_AXES; i++) {
+                axes.q15[i] = filters[i].axisQ15(calibration[i]);
+                axes.rawQ16[i] = filters[i].valueQ16();
+            }
+            axes.samples = samples;
+            published.publish();
+        }
+
+        vTaskDelete(nullptr);
+    }
+
+    TaskHandle_t task;
+    volatile bool running;
+    int8_t channels[ADC_AXES];
+    AxisFilter filters[ADC_AXES];                 // Reader task only
+    AxisCalibration calibration[ADC_AXES];        // Reader task only
+    std::atomic<bool> centerRequested{false};
+
+    TripleBuffer<AdcAxes> published;              // Reader -> physics
+    bool hasData = false;                         // Consumer only
+
+    uint32_t samples;
+    volatile uint32_t overruns;
+};
+
+#endif // ADC_INPUT_H
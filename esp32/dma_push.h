@@ -0,0 +1,177 @@
+/**
+ * DMA Push Queue
+ * Streams rectangles of a PSRAM sprite to the panel through a ping-pong pair
+ * of DMA-capable staging buffers in internal RAM. While one buffer is on the
+ * wire the CPU copies the next band into the other; TFT_eSPI waits for the
+ * previous transaction before queuing a new one, so a buffer is never
+ * refilled while the DMA engine still reads it. endFrame() returns with the
+ * last band still in flight, so the next frame is composed during it.
+ *
+ * Completion is observed by poll() (dmaBusy() gone false) and reported once
+ * per frame through an optional callback.
+ */
+
+#ifndef DMA_PUSH_H
+#define DMA_PUSH_H
+
+#include <TFT_eSPI.h>
+#include <esp_heap_caps.h>
+
+const int DMA_STAGING_BUFFERS = 2;
+const int DMA_STAGING_PIXELS = 480 * 16;   // 15 KB per buffer
+
+// frameId as given to beginFrame(); micros from endFrame() to observed completion
+typedef void (*DmaFrameCallback)(uint32_t frameId, uint32_t transferMicros, void* context);
+
+class DmaPushQueue {
+private:
+    TFT_eSPI* tft;
+    uint16_t* staging[DMA_STAGING_BUFFERS];
+    int nextBuffer;
+    bool ready;
+
+    // Frame submitted but not yet seen complete
+    bool pending;
+    uint32_t pendingFrame;
+    uint32_t pendingSince;
+    uint32_t currentFrame;
+    uint32_t currentBands;
+    bool savedSwapBytes;
+
+    DmaFrameCallback callback;
+    void* callbackContext;
+
+    uint32_t waitMicros;   // CPU time blocked on the DMA engine
+
+public:
+    DmaPushQueue(TFT_eSPI* display)
+        : tft(display), nextBuffer(0), ready(false), pending(false),
+          pendingFrame(0), pendingSince(0), currentFrame(0), currentBands(0),
+          savedSwapBytes(false),
+          callback(nullptr), callbackContext(nullptr), waitMicros(0) {
+        for (int i = 0; i < DMA_STAGING_BUFFERS; i++) staging[i] = nullptr;
+    }
+
+    ~DmaPushQueue() {
+        end();
+    }
+
+    // Allocate staging buffers and start the DMA channel. Holds the SPI bus
+    // from here on (DMA transfers need it). false = stay on blocking pushes.
+    bool begin() {
+        if (ready) return true;
+
+        for (int i = 0; i < DMA_STAGING_BUFFERS; i++) {
+            staging[i] = (uint16_t*)heap_caps_malloc(DMA_STAGING_PIXELS * sizeof(uint16_t),
+                                                     MALLOC_CAP_DMA | MALLOC_CAP_INTERNAL);
+            if (staging[i] == nullptr) {
+                end();
+                return false;
+            }
+        }
+        if (!tft->initDMA()) {
+            end();
+            return false;
+        }
+
+        tft->startWrite();
+        ready = true;
+        return true;
+    }
+
+    void end() {
+        if (ready) {
+            tft->dmaWait();
+            tft->endWrite();
+            tft->deInitDMA();
+            ready = false;
+        }
+        for (int i = 0; i < DMA_STAGING_BUFFERS; i++) {
+            heap_caps_free(staging[i]);
+            staging[i] = nullptr;
+        }
+    }
+
+    bool isReady() const { return ready; }
+
+    void setCallback(DmaFrameCallback cb, void* context) {
+        callback = cb;
+        callbackContext = context;
+    }
+
+    void beginFrame(uint32_t frameId) {
+        poll();
+        currentFrame = frameId;
+        currentBands = 0;
+        
+        // Sprite pixels are already in panel byte order
+        savedSwapBytes = tft->getSwapBytes();
+        tft->setSwapBytes(false);
+    }
+
+    // Queue a rect of a 16-bit sprite (panel byte order) in staging-sized bands
+    void pushRect(const uint16_t* source, int stride, int x, int y, int w, int h) {
+        if (w <= 0 || h <= 0) return;
+        int bandRows = max(1, DMA_STAGING_PIXELS / w);
+
+        for (int row = 0; row < h; row += bandRows) {
+            int rows = min(bandRows, h - row);
+            uint16_t* buffer = staging[nextBuffer];
+            nextBuffer = (nextBuffer + 1) % DMA_STAGING_BUFFERS;
+
+            // Safe: the transfer that last used this buffer finished before
+            // the one after it could be queued
+            const uint16_t* src = source + (size_t)(y + row) * stride + x;
+            for (int r = 0; r < rows; r++) {
+                memcpy(buffer + r * w, src + (size_t)r * stride, w * sizeof(uint16_t));
+            }
+
+            uint32_t start = micros();
+            tft->pushImageDMA(x, y + row, w, rows, buffer);
+            waitMicros += micros() - start;
+            currentBands++;
+            
+            // Queuing waited for the previous transaction, so the previous
+            // frame's last band is done by now
+            completePending();
+        }
+    }
+
+    // Close the frame; its last band may still be on the wire
+    void endFrame() {
+        tft->setSwapBytes(savedSwapBytes);
+        if (currentBands == 0) return;
+        pending = true;
+        pendingFrame = currentFrame;
+        pendingSince = micros();
+        poll();
+    }
+
+    // Report the pending frame once the DMA engine has gone idle
+    void poll() {
+        if (pending && !tft->dmaBusy()) completePending();
+    }
+
+    // Block until everything queued is on the panel
+    void waitIdle() {
+        uint32_t start = micros();
+        tft->dmaWait();
+        waitMicros += micros() - start;
+        poll();
+    }
+
+    uint32_t takeWaitMicros() {
+        uint32_t value = waitMicros;
+        waitMicros = 0;
+        return value;
+    }
+    
+private:
+    void completePending() {
+        if (!pending) return;
+        pending = false;
+        if (callback) callback(pendingFrame, micros() - pendingSince, callbackContext);
+    }
+};
+
+#endif // DMA_PUSH_H
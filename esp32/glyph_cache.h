@@ -0,0 +1,108 @@
+/**
+ * Readout Glyph Cache
+ * The numeric readouts only ever show digits, sign and a few letters. Each
+ * of those is rasterized once with the sprite's own font (drawString into a
+ * scratch sprite) and kept as a 1-bit mask; drawing a readout is then a
+ * masked store of one precomputed pixel word per lit pixel, straight into
+ * the sprite buffer. Colors are captured the same way, so the stored words
+ * are in whatever byte order the sprite uses.
+ */
+
+#ifndef GLYPH_CACHE_H
+#define GLYPH_CACHE_H
+
+#include <TFT_eSPI.h>
+
+const char GLYPH_CHARSET[] = "0123456789-:RPY ";
+const int GLYPH_COUNT = sizeof(GLYPH_CHARSET) - 1;
+const int GLYPH_MAX_SIZE = 2;              // Text sizes 1 and 2
+const int GLYPH_MAX_COLORS = 3;
+
+class GlyphCache {
+public:
+    GlyphCache() : size(0), colorCount(0) {
+        for (int i = 0; i < 128; i++) slot[i] = -1;
+    }
+
+    // Rasterize the charset at a text size in up to GLYPH_MAX_COLORS colors
+    bool build(TFT_eSPI* display, uint8_t textSize, const uint16_t* colors, int count) {
+        if (textSize < 1 || textSize > GLYPH_MAX_SIZE || count > GLYPH_MAX_COLORS) return false;
+
+        TFT_eSprite scratch(display);
+        if (scratch.createSprite(6 * textSize, 8 * textSize) == nullptr) return false;
+        const uint16_t* pixels = (const uint16_t*)scratch.getPointer();
+
+        size = textSize;
+        colorCount = count;
+        for (int c = 0; c < count; c++) {
+            scratch.fillSprite(colors[c]);
+            rawColors[c] = pixels[0];
+        }
+
+        char text[2] = {0, 0};
+        scratch.setTextSize(textSize);
+        scratch.setTextDatum(TL_DATUM);
+        scratch.setTextColor(TFT_WHITE);
+        for (int g = 0; g < GLYPH_COUNT; g++) {
+            scratch.fillSprite(TFT_BLACK);
+            uint16_t background = pixels[0];
+            text[0] = GLYPH_CHARSET[g];
+            scratch.drawString(text, 0, 0);
+
+            for (int row = 0; row < cellHeight(); row++) {
+                uint16_t bits = 0;
+                for (int col = 0; col < cellWidth(); col++) {
+                    if (pixels[row * cellWidth() + col] != background) bits |= 1 << col;
+                }
+                masks[g][row] = bits;
+            }
+            slot[(uint8_t)GLYPH_CHARSET[g]] = g;
+        }
+
+        scratch.deleteSprite();
+        return true;
+    }
+
+    bool isBuilt() const { return size != 0; }
+    int cellWidth() const { return 6 * size; }
+    int cellHeight() const { return 8 * size; }
+
+    // True when every character of text is in the cache
+    bool covers(const char* text) const {
+        for (const char* c = text; *c; c++) {
+            if ((uint8_t)*c >= 128 || slot[(uint8_t)*c] < 0) return false;
+        }
+        return true;
+    }
+
+    // Draw one cached character with its cell's top-left at (x, y), clipped
+    // to the target; returns pixels written
+    uint32_t blit(uint16_t* target, int width, int height, int x, int y, char c, int color) const {
+        const uint16_t* mask = masks[slot[(uint8_t)c]];
+        uint16_t raw = rawColors[color];
+        uint32_t written = 0;
+
+        for (int row = 0; row < cellHeight(); row++) {
+            int py = y + row;
+            if (py < 0 || py >= height || mask[row] == 0) continue;
+            uint16_t* line = target + (size_t)py * width;
+            for (int col = 0; col < cellWidth(); col++) {
+                int px = x + col;
+                if ((mask[row] >> col) & 1 && px >= 0 && px < width) {
+                    line[px] = raw;
+                    written++;
+                }
+            }
+        }
+        return written;
+    }
+
+private:
+    uint8_t size;
+    int colorCount;
+    int8_t slot[128];                                  // Char -> glyph, -1 = not cached
+    uint16_t masks[GLYPH_COUNT][8 * GLYPH_MAX_SIZE];   // Bit col set = lit pixel
+    uint16_t rawColors[GLYPH_MAX_COLORS];              // Sprite-native pixel words
+};
+
+#endif // GLYPH_CACHE_H
@@ -1,27 +1,71 @@
 /**
  * Project Mercury Attitude Indicator - ESP32-S3 Version
  * Displays attitude gauges on ST7796 LCD with physics simulation
+ *
+ * Task layout: input sampling and physics run in a 100 Hz task pinned to
+ * core 1; rendering runs at 50 Hz on core 0. The two sides only share a
+ * triple-buffered state snapshot, so a slow sprite push never delays a tick.
+ *
+ * With WIFI_SSID/WIFI_PASSWORD set at build time the board also accepts the
+ * desktop's UDP joystick stream (udp_input.h); while packets keep arriving
+ * they override the potentiometers.
  */
 
 #include <TFT_eSPI.h>
 #include <WiFi.h>
-#include <WiFiUdp.h>
 #include "state.h"
 #include "render.h"
+#include "snapshot.h"
+#include "udp_input.h"
+#include "adc_input.h"
+#include <esp_timer.h>
 
 // TFT Display
 TFT_eSPI tft = TFT_eSPI();
-SpacecraftRenderer renderer(&tft);
+SpacecraftRender renderer(&tft);
 
-// Spacecraft state and physics
+// Spacecraft state and physics (owned by the physics task)
 SpacecraftState state;
 
+// UDP joystick stream (lwIP callback -> physics task)
+UdpJoystickInput udpInput;
+const uint32_t UDP_INPUT_TIMEOUT_MS = 500;       // Back to the pots after this
+const uint32_t WIFI_CONNECT_TIMEOUT_MS = 10000;
+
 // Timing
-unsigned long lastUpdate = 0;
-unsigned long lastDisplayUpdate = 0;
-const unsigned long INPUT_SAMPLE_INTERVAL = 10;   // 100 Hz input sampling
-const unsigned long DISPLAY_UPDATE_INTERVAL = 20; // 50 Hz display update
-const float PHYSICS_TIMESTEP = 0.01f;             // 100Hz physics
+const uint32_t PHYSICS_PERIOD_MS = 10;           // 100 Hz input sampling + physics
+const uint32_t DISPLAY_PERIOD_MS = 20;           // 50 Hz display update
+const unsigned long STATS_INTERVAL = 1000;       // Stats over serial
+
+// Task placement: physics owns core 1 at high priority; rendering shares
+// core 0 with the WiFi stack
+const BaseType_t PHYSICS_CORE = 1;
+const BaseType_t RENDER_CORE = 0;
+const UBaseType_t PHYSICS_PRIORITY = configMAX_PRIORITIES - 2;
+const UBaseType_t RENDER_PRIORITY = 2;
+
+// Tick timing summary, published once per STATS_INTERVAL by the physics task
+struct TickStats {
+    uint32_t ticks;
+    uint32_t periodMinUs;
+    uint32_t periodMaxUs;
+    float periodMeanUs;
+    float jitterRmsUs;      // RMS deviation from PHYSICS_PERIOD_MS
+    uint32_t overruns;      // Ticks that arrived a full period late
+    uint32_t cyclesAvg;     // updateSpacecraft() cost
+    uint32_t cyclesMax;
+    int core;               // Core the physics task ran on, sampled in the task
+    
+    // UDP joystick: packets used, packets overwritten before a tick saw
+    // them, and lwIP arrival -> physics tick latency
+    uint32_t udpPackets;
+    uint32_t udpSuperseded;
+    uint32_t udpLatencyAvgUs;
+    uint32_t udpLatencyMaxUs;
+};
+
+TripleBuffer<SpacecraftState> stateSnapshots;   // Physics -> render
+TripleBuffer<TickStats> tickStatsSnapshots;      // Physics -> loop()
 
 // Joystick/potentiometer pins
 const int ROLL_POT_PIN = A0;
@@ -31,6 +75,12 @@ const int YAW_POT_PIN = A2;
 // Button pins for mode switching
 const int BTN_MODE_PIN = 15;
 
+// Oversampled, filtered pot readings (ADC DMA -> reader task -> physics task)
+AdcJoystickInput adcInput;
+const BaseType_t ADC_CORE = 0;
+const UBaseType_t ADC_PRIORITY = 1;
+bool adcReady = false;
+
 void setup() {
     Serial.begin(115200);
     Serial.println("Project Mercury Attitude Indicator - ESP32-S3");
@@ -50,46 +100,239 @@ void setup() {
     delay(2000);
     tft.fillScreen(TFT_BLACK);
     
+    // Overlap panel transfers with composing the next frame
+    if (!renderer.enableDma()) {
+        Serial.println("DMA unavailable, using blocking sprite pushes");
+    }
+    
     // Initialize input pins
     pinMode(ROLL_POT_PIN, INPUT);
     pinMode(PITCH_POT_PIN, INPUT);
     pinMode(YAW_POT_PIN, INPUT);
     pinMode(BTN_MODE_PIN, INPUT_PULLUP);
     
+    // Continuous ADC scan; sticks must rest centered for the calibration
+    const int axisPins[ADC_AXES] = {ROLL_POT_PIN, PITCH_POT_PIN, YAW_POT_PIN};
+    adcReady = adcInput.begin(axisPins, defaultAxisFilterConfig(), ADC_CORE, ADC_PRIORITY);
+    if (adcReady) {
+        delay(50);
+        adcInput.calibrateCenter();
+    } else {
+        Serial.println("ADC: continuous mode unavailable, polling analogRead()");
+    }
+    
+    startUdpInput();
+    
     // Initialize spacecraft state
     state.mode = RATE_COMMAND;
+    stateSnapshots.write(state);
+    
+    xTaskCreatePinnedToCore(physicsTask, "physics", 4096, nullptr,
+                            PHYSICS_PRIORITY, nullptr, PHYSICS_CORE);
+    xTaskCreatePinnedToCore(renderTask, "render", 8192, nullptr,
+                            RENDER_PRIORITY, nullptr, RENDER_CORE);
     
     Serial.println("Initialization complete");
 }
 
 void loop() {
-    unsigned long now = millis();
+    // Physics and rendering run in their own tasks; loop() only reports
+    if (tickStatsSnapshots.update()) {
+        reportTickStats(tickStatsSnapshots.read());
+    }
+    vTaskDelay(pdMS_TO_TICKS(100));
+}
+
+// ============================================================================
+// TASKS
+// ============================================================================
+
+void physicsTask(void* arg) {
+    const uint32_t periodUs = PHYSICS_PERIOD_MS * 1000;
+    TickType_t lastWake = xTaskGetTickCount();
+    int64_t lastTickUs = esp_timer_get_time();
+    int64_t windowStartUs = lastTickUs;
+    
+    TickStats window = {};
+    uint64_t periodSum = 0, deviationSquares = 0, cyclesSum = 0, udpLatencySum = 0;
+    window.periodMinUs = UINT32_MAX;
+    
+    JoystickInputPacket udpAxes = {};
+    int64_t lastUdpUs = 0;
+    bool udpActive = false;
     
-    // Input sampling at 100 Hz
-    if (now - lastUpdate >= INPUT_SAMPLE_INTERVAL) {
-        float deltaTime = (now - lastUpdate) / 1000.0f;
+    for (;;) {
+        vTaskDelayUntil(&lastWake, pdMS_TO_TICKS(PHYSICS_PERIOD_MS));
+        int64_t nowUs = esp_timer_get_time();
+        uint32_t period = (uint32_t)(nowUs - lastTickUs);
+        lastTickUs = nowUs;
         
         // Handle button inputs
         handleButtons();
         
-        // Read joystick
-        readControlInputs();
+        // Newest UDP packet, if any arrived since the last tick
+        JoystickSample sample;
+        uint32_t superseded;
+        if (udpInput.poll(sample, superseded)) {
+            uint32_t latency = (uint32_t)(esp_timer_get_time() - sample.arrivalUs);
+            udpAxes = sample.packet;
+            lastUdpUs = sample.arrivalUs;
+            window.udpPackets++;
+            window.udpSuperseded += superseded;
+            udpLatencySum += latency;
+            if (latency > window.udpLatencyMaxUs) window.udpLatencyMaxUs = latency;
+        }
+        
+        // Read joystick: the UDP stream while it is live, else the pots
+        bool udpLive = lastUdpUs != 0 && nowUs - lastUdpUs < (int64_t)UDP_INPUT_TIMEOUT_MS * 1000;
+        if (udpLive != udpActive) {
+            udpActive = udpLive;
+            Serial.println(udpLive ? "Input: UDP joystick" : "Input: potentiometers");
+        }
+        if (udpLive) {
+            applyStickInputs(state, udpAxes.rollInput, udpAxes.pitchInput, udpAxes.yawInput);
+        } else {
+            readControlInputs();
+        }
         
         // Update physics
-        updateSpacecraft(state, deltaTime);
+        uint32_t startCycles = ESP.getCycleCount();
+        updateSpacecraft(state, period / 1000000.0f);
+        uint32_t cycles = ESP.getCycleCount() - startCycles;
+        
+        stateSnapshots.write(state);
         
-        lastUpdate = now;
+        // Tick statistics
+        int32_t deviation = (int32_t)period - (int32_t)periodUs;
+        window.ticks++;
+        periodSum += period;
+        deviationSquares += (int64_t)deviation * deviation;
+        cyclesSum += cycles;
+        if (period < window.periodMinUs) window.periodMinUs = period;
+        if (period > window.periodMaxUs) window.periodMaxUs = period;
+        if (period >= 2 * periodUs) window.overruns++;
+        if (cycles > window.cyclesMax) window.cyclesMax = cycles;
+        
+        if (nowUs - windowStartUs >= (int64_t)STATS_INTERVAL * 1000) {
+            window.periodMeanUs = (float)periodSum / window.ticks;
+            window.jitterRmsUs = sqrtf((float)deviationSquares / window.ticks);
+            window.cyclesAvg = (uint32_t)(cyclesSum / window.ticks);
+            window.core = xPortGetCoreID();
+            if (window.udpPackets) {
+                window.udpLatencyAvgUs = (uint32_t)(udpLatencySum / window.udpPackets);
+            }
+            tickStatsSnapshots.write(window);
+            
+            window = TickStats();
+            window.periodMinUs = UINT32_MAX;
+            periodSum = deviationSquares = cyclesSum = udpLatencySum = 0;
+            windowStartUs = nowUs;
+        }
     }
+}
+
+void renderTask(void* arg) {
+    TickType_t lastWake = xTaskGetTickCount();
+    unsigned long lastStatsReport = millis();
     
-    // Display update at 50 Hz
-    if (now - lastDisplayUpdate >= DISPLAY_UPDATE_INTERVAL) {
-        // Render display
-        renderer.drawMainDisplay(state);
+    for (;;) {
+        vTaskDelayUntil(&lastWake, pdMS_TO_TICKS(DISPLAY_PERIOD_MS));
         
-        lastDisplayUpdate = now;
+        // Render the newest complete physics state; skip if nothing changed
+        if (stateSnapshots.update()) {
+            renderer.drawMainDisplay(stateSnapshots.read());
+        }
+        
+        if (millis() - lastStatsReport >= STATS_INTERVAL) {
+            reportRenderStats();
+            lastStatsReport = millis();
+        }
+    }
+}
+
+// ============================================================================
+// STATISTICS
+// ============================================================================
+
+void reportRenderStats() {
+    const RenderStats& stats = renderer.getStats();
+    if (stats.frames == 0) return;
+    
+    Serial.printf("Render (core %d): %lu frames, %lu us/frame, %lu bytes/frame (%s)\n",
+                  xPortGetCoreID(),
+                  (unsigned long)stats.frames,
+                  (unsigned long)(stats.totalMicros / stats.frames),
+                  (unsigned long)(stats.totalBytes / stats.frames),
+                  renderer.getPartialUpdates() ? "dirty rects" : "full frames");
+    if (renderer.getDmaEnabled()) {
+        Serial.printf("  DMA: %lu us/frame blocked, last transfer %lu us after submit\n",
+                      (unsigned long)(stats.totalWaitMicros / stats.frames),
+                      (unsigned long)stats.lastTransferMicros);
+    }
+    renderer.resetStats();
+}
+
+void reportTickStats(const TickStats& stats) {
+    // Budget: one tick of CPU time
+    uint32_t budget = ESP.getCpuFreqMHz() * 1000UL * PHYSICS_PERIOD_MS;
+    
+    Serial.printf("Physics (core %d%s): %lu ticks, period %lu/%.1f/%lu us min/mean/max, "
+                  "jitter %.1f us rms, %lu overruns\n",
+                  stats.core, stats.core == PHYSICS_CORE ? "" : ", NOT the pinned core",
+                  (unsigned long)stats.ticks,
+                  (unsigned long)stats.periodMinUs, stats.periodMeanUs,
+                  (unsigned long)stats.periodMaxUs, stats.jitterRmsUs,
+                  (unsigned long)stats.overruns);
+    Serial.printf("Physics (%s): %lu cycles/tick avg, %lu max, %.2f%% of tick budget\n",
+#ifdef PHYSICS_FIXED_POINT
+                  "Q16.16/Q2.30",
+#else
+                  "float",
+#endif
+                  (unsigned long)stats.cyclesAvg, (unsigned long)stats.cyclesMax,
+                  100.0f * stats.cyclesMax / budget);
+    
+    if (adcReady && adcInput.getOverruns()) {
+        Serial.printf("ADC: %lu ring buffer overruns\n", (unsigned long)adcInput.getOverruns());
+    }
+    
+    if (udpInput.isRunning()) {
+        Serial.printf("UDP input: %lu used, %lu superseded, latency %lu us avg / %lu us max "
+                      "(%lu received, %lu rejected)\n",
+                      (unsigned long)stats.udpPackets, (unsigned long)stats.udpSuperseded,
+                      (unsigned long)stats.udpLatencyAvgUs, (unsigned long)stats.udpLatencyMaxUs,
+                      (unsigned long)udpInput.getReceived(), (unsigned long)udpInput.getRejected());
     }
 }
 
+// ============================================================================
+// INPUT
+// ============================================================================
+
+// Join the network given at build time and listen for joystick packets
+void startUdpInput() {
+#ifdef WIFI_SSID
+    WiFi.mode(WIFI_STA);
+    WiFi.begin(WIFI_SSID, WIFI_PASSWORD);
+    
+    unsigned long start = millis();
+    while (WiFi.status() != WL_CONNECTED && millis() - start < WIFI_CONNECT_TIMEOUT_MS) {
+        delay(100);
+    }
+    if (WiFi.status() != WL_CONNECTED) {
+        Serial.println("WiFi: not connected, potentiometer input only");
+        return;
+    }
+    
+    if (udpInput.begin(UDP_DEFAULT_PORT)) {
+        Serial.printf("UDP input: listening on %s:%d\n",
+                      WiFi.localIP().toString().c_str(), UDP_DEFAULT_PORT);
+    } else {
+        Serial.println("UDP input: bind failed");
+    }
+#endif
+}
+
 void handleButtons() {
     static unsigned long lastModePress = 0;
     static bool lastModeState = HIGH;
@@ -116,6 +359,10 @@ void cycleMode() {
             Serial.println("Mode: FLY_BY_WIRE");
             break;
         case FLY_BY_WIRE:
+            state.mode = ATTITUDE_HOLD;
+            Serial.println("Mode: ATTITUDE_HOLD");
+            break;
+        case ATTITUDE_HOLD:
             state.mode = MANUAL;
             Serial.println("Mode: MANUAL");
             break;
@@ -131,6 +378,19 @@ void cycleMode() {
 }
 
 void readControlInputs() {
+    AdcAxes axes;
+    if (!adcReady || !adcInput.read(axes)) {
+        readControlInputsPolled();
+        return;
+    }
+    
+    // Filtered, deadzoned Q15 axes; full deflection = ±15 deg/s or ±100%
+    float scale = (state.mode == FLY_BY_WIRE ? 100.0f : 15.0f) / AXIS_Q15_FULL;
+    applyStickInputs(state, axes.q15[0] * scale, axes.q15[1] * scale, axes.q15[2] * scale);
+}
+
+// Fallback: one conversion per axis per tick, integer map() and deadzone
+void readControlInputsPolled() {
     // Physical joystick input with ±13° deflection
     // ±13° deflection → ±15°/s rotation rate
 
@@ -0,0 +1,44 @@
+/**
+ * Arduino Core Stand-in - Host Build
+ * Just enough of the Arduino API for state.h and render.h to compile and
+ * run on Linux. Time comes from the host steady clock.
+ */
+
+#ifndef ARDUINO_H
+#define ARDUINO_H
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <thread>
+
+#ifndef PI
+#define PI 3.1415926535897932384626433832795
+#endif
+
+#define HIGH 0x1
+#define LOW  0x0
+
+using std::abs;
+using std::min;
+using std::max;
+
+inline unsigned long micros() {
+    static const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    return static_cast<unsigned long>(std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now() - start).count());
+}
+
+inline unsigned long millis() {
+    return micros() / 1000;
+}
+
+inline void delay(unsigned long ms) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(ms));
+}
+
+#endif // ARDUINO_H
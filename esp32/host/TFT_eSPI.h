@@ -0,0 +1,382 @@
+/**
+ * TFT_eSPI Emulator - Host Build
+ * Software framebuffer with the subset of the TFT_eSPI / TFT_eSprite API
+ * used by render.h. Primitives follow the library's integer algorithms so
+ * pixel footprints match the panel; text uses placeholder glyphs with the
+ * GLCD font metrics (6x8 cell per character at size 1).
+ *
+ * Accounting:
+ * - Every canvas adds plotted pixels to tftHostCounters(), per destination
+ * - The panel models its SPI link: each address window costs the CASET/
+ *   RASET/RAMWR command bytes plus a fixed transaction overhead, and pixels
+ *   stream at 16 bits each at SPI_FREQUENCY
+ * Raw buffer copies through getPointer() are invisible to the counters.
+ *
+ * DMA: pushImageDMA() lands the pixels at once but keeps the transaction
+ * "in flight" until the next pushImageDMA()/dmaWait()/dmaBusy(). The source
+ * buffer is hashed when queued and re-hashed on completion; a mismatch means
+ * the caller reused a buffer the DMA engine was still reading and is counted
+ * as a violation.
+ */
+
+#ifndef TFT_ESPI_H
+#define TFT_ESPI_H
+
+#include <Arduino.h>
+#include <vector>
+
+// RGB565 colors
+#define TFT_BLACK   0x0000
+#define TFT_WHITE   0xFFFF
+#define TFT_RED     0xF800
+#define TFT_GREEN   0x07E0
+#define TFT_BLUE    0x001F
+
+// Text datums
+#define TL_DATUM 0
+#define TC_DATUM 1
+#define TR_DATUM 2
+#define ML_DATUM 3
+#define MC_DATUM 4
+#define MR_DATUM 5
+#define BL_DATUM 6
+#define BC_DATUM 7
+#define BR_DATUM 8
+
+#ifndef TFT_WIDTH
+#define TFT_WIDTH  480
+#endif
+#ifndef TFT_HEIGHT
+#define TFT_HEIGHT 320
+#endif
+#ifndef SPI_FREQUENCY
+#define SPI_FREQUENCY 40000000   // Matches TFT_eSPI/User_Setup.h
+#endif
+
+// Pixels plotted since the last reset, split by destination
+struct TftHostCounters {
+    uint64_t spritePixels;     // Drawn into RAM sprites
+    uint64_t panelPixels;      // Written to the panel (direct draws and pushes)
+};
+
+inline TftHostCounters& tftHostCounters() {
+    static TftHostCounters counters = {0, 0};
+    return counters;
+}
+
+// SPI link between the ESP32 and the panel controller
+struct SpiModel {
+    uint32_t clockHz;          // SCLK
+    uint32_t windowBytes;      // Address window: 0x2A+4, 0x2B+4, 0x2C
+    uint32_t transactionNs;    // CS/DC toggling and driver setup per window
+};
+
+inline SpiModel defaultSpiModel() {
+    SpiModel model = {SPI_FREQUENCY, 11, 1500};
+    return model;
+}
+
+// Traffic the panel has received since the last reset
+struct SpiTransferStats {
+    uint64_t windows;
+    uint64_t commandBytes;
+    uint64_t pixelBytes;
+    double nanos;              // Modeled time on the wire
+};
+
+class TFT_eSPI {
+public:
+    TFT_eSPI(int16_t w = TFT_WIDTH, int16_t h = TFT_HEIGHT)
+        : _width(w), _height(h), rotation(0), panel(true),
+          textColor(TFT_WHITE), textBgColor(TFT_BLACK), textBgFill(false),
+          textSize(1), textDatum(TL_DATUM), cursorX(0), cursorY(0),
+          swapBytes(false), dmaReady(false), dmaSource(0), dmaPixels(0), dmaHash(0),
+          dmaViolations(0), spi(defaultSpiModel()) {
+        resetTransferStats();
+    }
+    virtual ~TFT_eSPI() {}
+
+    void init() { buffer.assign(static_cast<size_t>(_width) * _height, TFT_BLACK); }
+
+    void setRotation(uint8_t r) {
+        if ((r & 1) != (rotation & 1)) std::swap(_width, _height);
+        rotation = r & 3;
+        buffer.assign(static_cast<size_t>(_width) * _height, TFT_BLACK);
+    }
+
+    int16_t width() const { return _width; }
+    int16_t height() const { return _height; }
+
+    // ------------------------------------------------------------------------
+    // Drawing primitives
+    // ------------------------------------------------------------------------
+
+    void drawPixel(int32_t x, int32_t y, uint32_t color) {
+        if (plot(x, y, color)) spiWindow(1);
+    }
+
+    uint16_t readPixel(int32_t x, int32_t y) const {
+        if (x < 0 || y < 0 || x >= _width || y >= _height || buffer.empty()) return 0;
+        return buffer[static_cast<size_t>(y) * _width + x];
+    }
+
+    void drawFastHLine(int32_t x, int32_t y, int32_t w, uint32_t color) {
+        fillRect(x, y, w, 1, color);
+    }
+
+    void drawFastVLine(int32_t x, int32_t y, int32_t h, uint32_t color) {
+        fillRect(x, y, 1, h, color);
+    }
+
+    // One address window on the panel, however many pixels it covers
+    void fillRect(int32_t x, int32_t y, int32_t w, int32_t h, uint32_t color) {
+        uint32_t plotted = 0;
+        for (int32_t row = 0; row < h; row++) {
+            for (int32_t col = 0; col < w; col++) {
+                plotted += plot(x + col, y + row, color);
+            }
+        }
+        if (plotted) spiWindow(plotted);
+    }
+
+    void fillScreen(uint32_t color) { fillRect(0, 0, _width, _height, color); }
+
+    void drawLine(int32_t x0, int32_t y0, int32_t x1, int32_t y1, uint32_t color) {
+        bool steep = std::abs(y1 - y0) > std::abs(x1 - x0);
+        if (steep) { std::swap(x0, y0); std::swap(x1, y1); }
+        if (x0 > x1) { std::swap(x0, x1); std::swap(y0, y1); }
+
+        int32_t dx = x1 - x0, dy = std::abs(y1 - y0);
+        int32_t err = dx >> 1, ystep = (y0 < y1) ? 1 : -1;
+        for (; x0 <= x1; x0++) {
+            if (steep) drawPixel(y0, x0, color); else drawPixel(x0, y0, color);
+            err -= dy;
+            if (err < 0) { y0 += ystep; err += dx; }
+        }
+    }
+
+    void drawCircle(int32_t x0, int32_t y0, int32_t r, uint32_t color) {
+        int32_t f = 1 - r, ddF_x = 1, ddF_y = -2 * r, x = 0, y = r;
+        drawPixel(x0, y0 + r, color);
+        drawPixel(x0, y0 - r, color);
+        drawPixel(x0 + r, y0, color);
+        drawPixel(x0 - r, y0, color);
+        while (x < y) {
+            if (f >= 0) { y--; ddF_y += 2; f += ddF_y; }
+            x++; ddF_x += 2; f += ddF_x;
+            drawPixel(x0 + x, y0 + y, color); drawPixel(x0 - x, y0 + y, color);
+            drawPixel(x0 + x, y0 - y, color); drawPixel(x0 - x, y0 - y, color);
+            drawPixel(x0 + y, y0 + x, color); drawPixel(x0 - y, y0 + x, color);
+            drawPixel(x0 + y, y0 - x, color); drawPixel(x0 - y, y0 - x, color);
+        }
+    }
+
+    void fillCircle(int32_t x0, int32_t y0, int32_t r, uint32_t color) {
+        drawFastHLine(x0 - r, y0, 2 * r + 1, color);
+        int32_t f = 1 - r, ddF_x = 1, ddF_y = -2 * r, x = 0, y = r;
+        while (x < y) {
+            if (f >= 0) {
+                drawFastHLine(x0 - x, y0 + y, 2 * x + 1, color);
+                drawFastHLine(x0 - x, y0 - y, 2 * x + 1, color);
+                y--; ddF_y += 2; f += ddF_y;
+            }
+            x++; ddF_x += 2; f += ddF_x;
+            drawFastHLine(x0 - y, y0 + x, 2 * y + 1, color);
+            drawFastHLine(x0 - y, y0 - x, 2 * y + 1, color);
+        }
+    }
+
+    // ------------------------------------------------------------------------
+    // Text
+    // ------------------------------------------------------------------------
+
+    void setTextColor(uint16_t color) { textColor = color; textBgFill = false; }
+    void setTextColor(uint16_t color, uint16_t bg) { textColor = color; textBgColor = bg; textBgFill = true; }
+    void setTextSize(uint8_t size) { textSize = size ? size : 1; }
+    void setTextDatum(uint8_t datum) { textDatum = datum; }
+    void setCursor(int16_t x, int16_t y) { cursorX = x; cursorY = y; }
+
+    int16_t textWidth(const char* text) const { return static_cast<int16_t>(std::strlen(text) * 6 * textSize); }
+    int16_t fontHeight() const { return static_cast<int16_t>(8 * textSize); }
+
+    int16_t drawString(const char* text, int32_t x, int32_t y) {
+        int32_t w = textWidth(text), h = fontHeight();
+        x -= (textDatum % 3) * w / 2;
+        y -= (textDatum / 3) * h / 2;
+        for (const char* c = text; *c; c++, x += 6 * textSize) {
+            drawChar(x, y, *c);
+        }
+        return static_cast<int16_t>(w);
+    }
+
+    void print(const char* text) {
+        for (const char* c = text; *c; c++) {
+            if (*c == '\n') { cursorX = 0; cursorY += fontHeight(); continue; }
+            drawChar(cursorX, cursorY, *c);
+            cursorX += 6 * textSize;
+        }
+    }
+
+    void println(const char* text) { print(text); print("\n"); }
+
+    // ------------------------------------------------------------------------
+    // Panel transfer accounting
+    // ------------------------------------------------------------------------
+
+    // Called by TFT_eSprite::pushSprite: one window streaming w*h pixels
+    void pushBlock(int32_t x, int32_t y, int32_t w, int32_t h, const uint16_t* src, int32_t srcStride) {
+        uint32_t plotted = 0;
+        for (int32_t row = 0; row < h; row++) {
+            for (int32_t col = 0; col < w; col++) {
+                plotted += plot(x + col, y + row, src[static_cast<size_t>(row) * srcStride + col]);
+            }
+        }
+        if (plotted) spiWindow(plotted);
+    }
+
+    // ------------------------------------------------------------------------
+    // DMA (one transaction in flight, as on the ESP32 SPI master)
+    // ------------------------------------------------------------------------
+
+    bool initDMA() { dmaReady = true; return true; }
+    void deInitDMA() { dmaWait(); dmaReady = false; }
+
+    void startWrite() {}
+    void endWrite() {}
+
+    void setSwapBytes(bool swap) { swapBytes = swap; }
+    bool getSwapBytes() const { return swapBytes; }
+
+    // Waits for the previous transaction, then queues this one
+    void pushImageDMA(int32_t x, int32_t y, int32_t w, int32_t h, uint16_t* data) {
+        dmaWait();
+        if (!dmaReady || w < 1 || h < 1) return;
+
+        // Byte swapping would rewrite the caller's buffer in place
+        if (swapBytes) dmaViolations++;
+        pushBlock(x, y, w, h, data, w);
+        dmaSource = data;
+        dmaPixels = static_cast<size_t>(w) * h;
+        dmaHash = hashPixels(data, dmaPixels);
+    }
+
+    bool dmaBusy() { dmaWait(); return false; }
+
+    void dmaWait() {
+        if (!dmaSource) return;
+        if (hashPixels(dmaSource, dmaPixels) != dmaHash) dmaViolations++;
+        dmaSource = 0;
+    }
+
+    uint64_t getDmaViolations() const { return dmaViolations; }
+
+    void setSpiModel(const SpiModel& model) { spi = model; }
+    const SpiModel& getSpiModel() const { return spi; }
+
+    const SpiTransferStats& getTransferStats() const { return transfer; }
+    void resetTransferStats() { transfer.windows = transfer.commandBytes = transfer.pixelBytes = 0; transfer.nanos = 0.0; }
+
+    const uint16_t* frameBuffer() const { return buffer.empty() ? 0 : &buffer[0]; }
+
+protected:
+    // Write one pixel; false when clipped
+    bool plot(int32_t x, int32_t y, uint32_t color) {
+        if (x < 0 || y < 0 || x >= _width || y >= _height || buffer.empty()) return false;
+        buffer[static_cast<size_t>(y) * _width + x] = static_cast<uint16_t>(color);
+        if (panel) tftHostCounters().panelPixels++; else tftHostCounters().spritePixels++;
+        return true;
+    }
+
+    // Account a panel address window followed by a pixel stream
+    void spiWindow(uint32_t pixels) {
+        if (!panel) return;
+        uint64_t bytes = spi.windowBytes + static_cast<uint64_t>(pixels) * 2;
+        transfer.windows++;
+        transfer.commandBytes += spi.windowBytes;
+        transfer.pixelBytes += static_cast<uint64_t>(pixels) * 2;
+        transfer.nanos += spi.transactionNs + bytes * 8 * 1e9 / spi.clockHz;
+    }
+
+    static uint64_t hashPixels(const uint16_t* data, size_t count) {
+        uint64_t hash = 1469598103934665603ull;
+        for (size_t i = 0; i < count; i++) hash = (hash ^ data[i]) * 1099511628211ull;
+        return hash;
+    }
+
+    void drawChar(int32_t x, int32_t y, char c) {
+        // Placeholder 5x7 glyph derived from the character code
+        uint32_t bits = (static_cast<uint8_t>(c) * 2654435761u) ^ 0x5A5A5A5Au;
+        if (c == ' ') bits = 0;
+        for (int32_t row = 0; row < 8; row++) {
+            for (int32_t col = 0; col < 6; col++) {
+                bool on = col < 5 && row < 7 && ((bits >> ((row * 5 + col) % 32)) & 1);
+                if (!on && !textBgFill) continue;
+                fillRect(x + col * textSize, y + row * textSize, textSize, textSize,
+                         on ? textColor : textBgColor);
+            }
+        }
+    }
+
+    std::vector<uint16_t> buffer;
+    int16_t _width;
+    int16_t _height;
+    uint8_t rotation;
+    bool panel;
+
+    uint16_t textColor;
+    uint16_t textBgColor;
+    bool textBgFill;
+    uint8_t textSize;
+    uint8_t textDatum;
+    int16_t cursorX;
+    int16_t cursorY;
+
+    bool swapBytes;
+    bool dmaReady;
+    const uint16_t* dmaSource;   // In-flight transaction, 0 when idle
+    size_t dmaPixels;
+    uint64_t dmaHash;
+    uint64_t dmaViolations;
+
+    SpiModel spi;
+    SpiTransferStats transfer;
+};
+
+class TFT_eSprite : public TFT_eSPI {
+public:
+    explicit TFT_eSprite(TFT_eSPI* display) : TFT_eSPI(0, 0), display(display) { panel = false; }
+
+    void* createSprite(int16_t w, int16_t h) {
+        _width = w;
+        _height = h;
+        buffer.assign(static_cast<size_t>(w) * h, TFT_BLACK);
+        return &buffer[0];
+    }
+
+    void deleteSprite() { buffer.clear(); _width = 0; _height = 0; }
+
+    void* getPointer() { return buffer.empty() ? 0 : &buffer[0]; }
+
+    void fillSprite(uint32_t color) { fillScreen(color); }
+
+    void pushSprite(int32_t x, int32_t y) {
+        display->pushBlock(x, y, _width, _height, &buffer[0], _width);
+    }
+
+    // Push the (sx, sy, sw, sh) window of the sprite to (tx, ty) on the panel
+    bool pushSprite(int32_t tx, int32_t ty, int32_t sx, int32_t sy, int32_t sw, int32_t sh) {
+        if (sx < 0) { sw += sx; tx -= sx; sx = 0; }
+        if (sy < 0) { sh += sy; ty -= sy; sy = 0; }
+        if (sx + sw > _width) sw = _width - sx;
+        if (sy + sh > _height) sh = _height - sy;
+        if (sw < 1 || sh < 1) return false;
+
+        display->pushBlock(tx, ty, sw, sh, &buffer[static_cast<size_t>(sy) * _width + sx], _width);
+        return true;
+    }
+
+private:
+    TFT_eSPI* display;
+};
+
+#endif // TFT_ESPI_H
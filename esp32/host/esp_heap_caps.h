@@ -0,0 +1,25 @@
+/**
+ * ESP-IDF Capability Allocator Stand-in - Host Build
+ * Every host allocation is "DMA capable"; caps are accepted and ignored.
+ */
+
+#ifndef ESP_HEAP_CAPS_H
+#define ESP_HEAP_CAPS_H
+
+#include <cstdint>
+#include <cstdlib>
+
+#define MALLOC_CAP_DMA      (1 << 3)
+#define MALLOC_CAP_INTERNAL (1 << 11)
+#define MALLOC_CAP_SPIRAM   (1 << 10)
+
+inline void* heap_caps_malloc(size_t size, uint32_t caps) {
+    (void)caps;
+    return malloc(size);
+}
+
+inline void heap_caps_free(void* ptr) {
+    free(ptr);
+}
+
+#endif // ESP_HEAP_CAPS_H
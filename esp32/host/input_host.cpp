@@ -0,0 +1,196 @@
+/*
+ * Host Bench for the Joystick Input Pipeline
+ *
+ * Feeds a synthetic pot signal (12-bit, Gaussian noise plus occasional
+ * single-sample spikes) through both input paths at the ESP32 rates:
+ *   - polled: one analogRead() per 100 Hz tick, map() to integer deg/s,
+ *     integer deadzone (the original readControlInputs())
+ *   - filtered: 2 kHz continuous samples through AxisFilter (adc_filter.h)
+ * and reports, in RATE_COMMAND units (deg/s, full scale 15):
+ *   - rest noise: RMS and peak output with the stick centered
+ *   - hold jitter: standard deviation while held at 40% deflection
+ *   - resolution: distinct output levels over a slow full sweep
+ *   - step: 10-90% rise time for a center -> 60% step
+ * plus host ns per filtered sample.
+ *
+ * Usage: ./input_host [--noise COUNTS] [--shift N] [--no-median]
+ */
+
+#include "adc_filter.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <random>
+#include <set>
+#include <vector>
+
+const int TICK_HZ = 100;
+const int SAMPLE_HZ = 2000;                    // Per axis
+const int SAMPLES_PER_TICK = SAMPLE_HZ / TICK_HZ;
+const float RATE_FULL_SCALE = 15.0f;
+
+struct Signal {
+    std::mt19937 rng;
+    std::normal_distribution<double> noise;
+    std::uniform_real_distribution<double> uniform;
+    double spikeProbability;
+
+    Signal(double sigma) : rng(12345), noise(0.0, sigma), uniform(0.0, 1.0),
+                           spikeProbability(0.002) {}
+
+    // Deflection in [-1, 1] to a noisy 12-bit reading
+    uint16_t sample(double deflection) {
+        double counts = ADC_RAW_MAX / 2.0 + deflection * ADC_RAW_MAX / 2.0 + noise(rng);
+        if (uniform(rng) < spikeProbability) counts += (uniform(rng) < 0.5 ? -1 : 1) * 400.0;
+        return static_cast<uint16_t>(std::max(0.0, std::min<double>(ADC_RAW_MAX, std::round(counts))));
+    }
+};
+
+// Original path: Arduino map(raw, 0, 4095, -15, 15) and |x| < 1 deadzone
+static float polledRate(uint16_t raw) {
+    long rate = (long)raw * 30 / ADC_RAW_MAX - 15;
+    if (std::abs(rate) < 1) rate = 0;
+    return static_cast<float>(rate);
+}
+
+static float filteredRate(const AxisFilter& filter, const AxisCalibration& cal) {
+    return filter.axisQ15(cal) * RATE_FULL_SCALE / AXIS_Q15_FULL;
+}
+
+struct PathResult {
+    double restRms = 0.0, restPeak = 0.0, holdJitter = 0.0;
+    size_t levels = 0;
+    double riseMs = 0.0;
+};
+
+// Deflection profile over ticks; returns per-tick output of both paths
+template <typename Profile>
+static void run(Profile profile, int ticks, const AxisFilterConfig& config, double sigma,
+                std::vector<float>& polled, std::vector<float>& filtered) {
+    Signal signal(sigma);
+    AxisFilter filter;
+    filter.configure(config);
+    AxisCalibration cal = defaultAxisCalibration();
+
+    for (int tick = 0; tick < ticks; tick++) {
+        uint16_t raw = 0;
+        for (int s = 0; s < SAMPLES_PER_TICK; s++) {
+            double t = (tick * SAMPLES_PER_TICK + s) / static_cast<double>(SAMPLE_HZ);
+            raw = signal.sample(profile(t));
+            filter.push(raw);
+        }
+        // The polled path sees whatever single conversion lands on the tick
+        polled.push_back(polledRate(raw));
+        filtered.push_back(filteredRate(filter, cal));
+    }
+}
+
+static void rms(const std::vector<float>& values, float target, double& rmsOut, double& peakOut) {
+    double sum = 0.0, peak = 0.0;
+    for (size_t i = 0; i < values.size(); i++) {
+        double e = values[i] - target;
+        sum += e * e;
+        peak = std::max(peak, std::fabs(e));
+    }
+    rmsOut = std::sqrt(sum / values.size());
+    peakOut = peak;
+}
+
+static double riseMs(const std::vector<float>& values, int stepTick, float from, float to) {
+    int t10 = -1, t90 = -1;
+    for (int i = stepTick; i < static_cast<int>(values.size()); i++) {
+        float progress = (values[i] - from) / (to - from);
+        if (t10 < 0 && progress >= 0.1f) t10 = i;
+        if (t90 < 0 && progress >= 0.9f) { t90 = i; break; }
+    }
+    if (t90 < 0) return -1.0;
+    // Tick granularity; the first tick after the step already counts
+    return (t90 - stepTick + 1) * 1000.0 / TICK_HZ;
+}
+
+int main(int argc, char* argv[]) {
+    double sigma = 6.0;
+    AxisFilterConfig config = defaultAxisFilterConfig();
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--noise") == 0 && i + 1 < argc) {
+            sigma = atof(argv[++i]);
+        } else if (strcmp(argv[i], "--shift") == 0 && i + 1 < argc) {
+            config.iirShift = static_cast<uint8_t>(std::max(0, std::min(12, atoi(argv[++i]))));
+        } else if (strcmp(argv[i], "--no-median") == 0) {
+            config.median = false;
+        } else {
+            std::cerr << "Usage: " << argv[0] << " [--noise COUNTS] [--shift N] [--no-median]"
+                      << std::endl;
+            return 1;
+        }
+    }
+
+    PathResult result[2];
+    std::vector<float> out[2];
+
+    // Rest: centered stick
+    run([](double) { return 0.0; }, 1000, config, sigma, out[0], out[1]);
+    for (int p = 0; p < 2; p++) rms(out[p], 0.0f, result[p].restRms, result[p].restPeak);
+
+    // Hold at 40%
+    out[0].clear(); out[1].clear();
+    run([](double) { return 0.4; }, 1000, config, sigma, out[0], out[1]);
+    for (int p = 0; p < 2; p++) {
+        std::vector<float> held(out[p].begin() + 10, out[p].end());
+        double mean = 0.0, peak;
+        for (size_t i = 0; i < held.size(); i++) mean += held[i];
+        rms(held, static_cast<float>(mean / held.size()), result[p].holdJitter, peak);
+    }
+
+    // Slow sweep -1 -> 1 over 20 s: how many output levels are reachable
+    out[0].clear(); out[1].clear();
+    run([](double t) { return -1.0 + t / 10.0; }, 2000, config, sigma, out[0], out[1]);
+    for (int p = 0; p < 2; p++) {
+        std::set<int> levels;
+        for (size_t i = 0; i < out[p].size(); i++) levels.insert(static_cast<int>(std::lround(out[p][i] * 100.0f)));
+        result[p].levels = levels.size();
+    }
+
+    // Step center -> 60% at tick 50
+    out[0].clear(); out[1].clear();
+    run([](double t) { return t >= 0.5 ? 0.6 : 0.0; }, 200, config, sigma, out[0], out[1]);
+    for (int p = 0; p < 2; p++) result[p].riseMs = riseMs(out[p], 50, 0.0f, 0.6f * RATE_FULL_SCALE);
+
+    // Cost per filtered sample
+    AxisFilter filter;
+    filter.configure(config);
+    Signal signal(sigma);
+    std::vector<uint16_t> raw(1 << 16);
+    for (size_t i = 0; i < raw.size(); i++) raw[i] = signal.sample(0.3);
+    const int rounds = 200;
+    auto start = std::chrono::steady_clock::now();
+    for (int r = 0; r < rounds; r++) {
+        for (size_t i = 0; i < raw.size(); i++) filter.push(raw[i]);
+    }
+    auto end = std::chrono::steady_clock::now();
+    volatile int32_t sink = filter.valueQ16();
+    (void)sink;
+    double nsPerSample = std::chrono::duration<double, std::nano>(end - start).count() /
+                         (static_cast<double>(rounds) * raw.size());
+
+    printf("\nJoystick input paths: noise %.1f counts rms, IIR shift %d (%.1f ms), median %s\n",
+           sigma, config.iirShift, (1 << config.iirShift) * 1000.0 / SAMPLE_HZ,
+           config.median ? "on" : "off");
+    printf("  %-10s %12s %12s %12s %10s %10s\n", "path", "rest rms", "rest peak",
+           "hold jitter", "levels", "rise ms");
+    printf("  %-10s %12s %12s %12s %10s\n", "", "(deg/s)", "(deg/s)", "(deg/s)", "(sweep)");
+    const char* names[2] = {"polled", "filtered"};
+    for (int p = 0; p < 2; p++) {
+        printf("  %-10s %12.4f %12.4f %12.4f %10zu %10.1f\n", names[p], result[p].restRms,
+               result[p].restPeak, result[p].holdJitter, result[p].levels, result[p].riseMs);
+    }
+    printf("  Filter cost: %.2f ns/sample on the host; %d samples/s/axis on the device\n",
+           nsPerSample, SAMPLE_HZ);
+    return 0;
+}
@@ -0,0 +1,519 @@
+/*
+ * Host Accuracy/Cost Harness for the Dynamics Scalar Variants
+ *
+ * Runs one scripted flight (manual rates, fly-by-wire burns, rate-command
+ * sweeps) through the shared dynamics core at 100 Hz with each scalar type
+ * and compares against the double-precision reference:
+ *   - attitude error: angle between reference and variant quaternions
+ *   - rate error: largest per-axis angular velocity difference
+ *   - display error: largest Euler angle difference after wrap
+ * Then times each variant in a tight loop. Host time says nothing exact
+ * about the ESP32-S3, but soft-double vs float vs integer ratios carry over;
+ * on-device cycles per tick are printed over serial by handler.ino.
+ *
+ * Golden trace: a second flight runs the full shared simulation loop
+ * (shared/spacecraft.h: scenarios, modes, accumulator, display values) with
+ * each target's state instantiation and compares sampled attitude/rates
+ * against golden_trace.csv. The desktop (double) build must reproduce it to
+ * rounding; the ESP32 variants must stay within their documented error.
+ *
+ * Thruster accounting: the golden flight's on-time, pulse count and
+ * impulse (BasicDynamics::thrusterUsage) from each ESP32 variant must match
+ * the double build's, so efficiency numbers compare across targets.
+ *
+ * Attitude hold: the ATTITUDE_HOLD autopilot's thruster pulses make traces
+ * diverge between scalar types after the first differently rounded pulse,
+ * so instead of a trace each target must arrest a tumble and settle on the
+ * captured attitude under every scenario within HOLD_SETTLE_LIMIT.
+ *
+ * Usage: ./physics_host [--seconds S] [--golden FILE | --write-golden FILE]
+ */
+
+#include "spacecraft.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <vector>
+
+const double TIMESTEP = 0.01;
+
+// 240 MHz S3 core, one 10 ms physics tick
+const double DEVICE_TICK_CYCLES = 240e6 * TIMESTEP;
+
+struct Sample {
+    double w, x, y, z;
+    double rates[3];
+    double euler[3];
+};
+
+struct Accuracy {
+    double maxAttitudeDeg = 0.0;
+    double rmsAttitudeDeg = 0.0;
+    double maxRateDegS = 0.0;
+    double maxEulerDeg = 0.0;
+};
+
+// ============================================================================
+// SCRIPTED FLIGHT
+// ============================================================================
+
+template <typename D>
+static void stepScript(D& dynamics, int step) {
+    typedef typename D::Scalar T;
+    double t = step * TIMESTEP;
+    int phase = static_cast<int>(t / 20.0) % 3;
+
+    if (phase == 0) {
+        // Manual: constant body rates, orientation integration only
+        dynamics.angularVelocity = typename D::Vec(T(12.0f), T(-7.5f), T(4.0f));
+        dynamics.orientation.integrate(dynamics.angularVelocity.x, dynamics.angularVelocity.y,
+                                       dynamics.angularVelocity.z, TIMESTEP);
+        return;
+    }
+
+    if (phase == 1) {
+        // Fly-by-wire: alternating high/low thrust pulses on two axes
+        float roll = (static_cast<int>(t) % 4 < 2) ? 100.0f : -50.0f;
+        float pitch = (static_cast<int>(t * 2.0) % 3 == 0) ? 80.0f : 0.0f;
+        dynamics.setThrusterCommands(roll, pitch, 0.0f, true);
+    } else {
+        // Rate command: sinusoidal sweeps on all axes
+        dynamics.setThrusterCommands(15.0f * static_cast<float>(std::sin(t * 0.7)),
+                                     10.0f * static_cast<float>(std::cos(t * 0.3)),
+                                     -8.0f, false);
+    }
+    dynamics.update(TIMESTEP);
+}
+
+template <typename D>
+static Sample sampleOf(const D& dynamics) {
+    Sample s;
+    s.w = static_cast<double>(dynamics.orientation.w);
+    s.x = static_cast<double>(dynamics.orientation.x);
+    s.y = static_cast<double>(dynamics.orientation.y);
+    s.z = static_cast<double>(dynamics.orientation.z);
+    s.rates[0] = static_cast<double>(dynamics.angularVelocity.x);
+    s.rates[1] = static_cast<double>(dynamics.angularVelocity.y);
+    s.rates[2] = static_cast<double>(dynamics.angularVelocity.z);
+    dynamics.getEulerAngles(s.euler[0], s.euler[1], s.euler[2]);
+    return s;
+}
+
+template <typename D>
+static std::vector<Sample> runTrace(int steps) {
+    D dynamics;
+    std::vector<Sample> trace;
+    trace.reserve(steps);
+    for (int i = 0; i < steps; i++) {
+        stepScript(dynamics, i);
+        trace.push_back(sampleOf(dynamics));
+    }
+    return trace;
+}
+
+static double wrappedDiff(double a, double b) {
+    double d = std::fabs(a - b);
+    return std::min(d, 360.0 - d);
+}
+
+static Accuracy compare(const std::vector<Sample>& reference, const std::vector<Sample>& trace) {
+    Accuracy acc;
+    double sumSquares = 0.0;
+
+    for (size_t i = 0; i < reference.size(); i++) {
+        const Sample& r = reference[i];
+        const Sample& v = trace[i];
+
+        double norm = std::sqrt(v.w*v.w + v.x*v.x + v.y*v.y + v.z*v.z);
+        double dot = std::fabs(r.w*v.w + r.x*v.x + r.y*v.y + r.z*v.z) / norm;
+        double angle = 2.0 * std::acos(std::min(1.0, dot)) * DYNAMICS_RAD_TO_DEG;
+
+        acc.maxAttitudeDeg = std::max(acc.maxAttitudeDeg, angle);
+        sumSquares += angle * angle;
+        for (int axis = 0; axis < 3; axis++) {
+            acc.maxRateDegS = std::max(acc.maxRateDegS, std::fabs(r.rates[axis] - v.rates[axis]));
+            acc.maxEulerDeg = std::max(acc.maxEulerDeg, wrappedDiff(r.euler[axis], v.euler[axis]));
+        }
+    }
+    acc.rmsAttitudeDeg = std::sqrt(sumSquares / reference.size());
+    return acc;
+}
+
+// ============================================================================
+// COST
+// ============================================================================
+
+template <typename D>
+static double nanosPerStep(int steps) {
+    D dynamics;
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < steps; i++) {
+        stepScript(dynamics, i);
+    }
+    auto end = std::chrono::steady_clock::now();
+
+    // Keep the result observable so the loop isn't optimized away
+    volatile double sink = static_cast<double>(dynamics.orientation.w);
+    (void)sink;
+    return std::chrono::duration<double, std::nano>(end - start).count() / steps;
+}
+
+template <typename D>
+static void report(const char* name, const std::vector<Sample>& reference, int steps,
+                   double referenceNanos) {
+    std::vector<Sample> trace = runTrace<D>(steps);
+    Accuracy acc = compare(reference, trace);
+    double nanos = nanosPerStep<D>(steps);
+
+    printf("  %-22s %10.5f %10.5f %10.5f %10.5f %9.1f %8.2fx\n", name,
+           acc.maxAttitudeDeg, acc.rmsAttitudeDeg, acc.maxRateDegS, acc.maxEulerDeg,
+           nanos, referenceNanos / nanos);
+}
+
+// ============================================================================
+// GOLDEN TRACE
+// ============================================================================
+
+const int GOLDEN_STEPS = 12000;         // 120 s at 100 Hz
+const int GOLDEN_SAMPLE_EVERY = 50;
+
+struct GoldenSample {
+    int step;
+    double w, x, y, z;
+    double euler[3];
+    double rates[3];
+};
+
+// Largest allowed deviation from the golden trace per target instantiation
+struct GoldenTolerance {
+    const char* name;
+    double attitudeDeg;
+    double rateDegS;
+};
+
+// Every mode under every scenario, commands varying within each 10 s slot
+template <typename State>
+static void goldenInputs(State& state, int step) {
+    double t = step * TIMESTEP;
+    int slot = static_cast<int>(t / 10.0);
+
+    state.mode = static_cast<ControlMode>(slot % 3);
+    Scenario scenario = static_cast<Scenario>((slot / 3) % 5);
+    if (scenario != state.scenario) {
+        state.scenario = scenario;
+        state.scenarioTime = 0.0f;
+    }
+
+    float phase = static_cast<float>(t);
+    if (state.mode == MANUAL) {
+        state.rollRate = 10.0f * std::sin(phase * 0.4f);
+        state.pitchRate = -6.0f;
+        state.yawRate = 4.0f * std::cos(phase * 0.25f);
+    } else if (state.mode == RATE_COMMAND) {
+        state.rollCommand = 15.0f * std::sin(phase * 0.7f);
+        state.pitchCommand = 10.0f * std::cos(phase * 0.3f);
+        state.yawCommand = -8.0f;
+    } else {
+        state.flyByWireRoll = (static_cast<int>(t) % 4 < 2) ? 100.0f : -50.0f;
+        state.flyByWirePitch = (static_cast<int>(t * 2.0) % 3 == 0) ? 80.0f : 0.0f;
+        state.flyByWireYaw = -30.0f;
+    }
+}
+
+// usage, if given, receives the thruster accounting at the end of the flight
+template <typename Dynamics>
+static std::vector<GoldenSample> runGolden(ThrusterUsage* usage = nullptr) {
+    BasicSpacecraftState<Dynamics> state;
+    std::vector<GoldenSample> trace;
+    const float frameTime = static_cast<float>(TIMESTEP);
+
+    for (int step = 0; step < GOLDEN_STEPS; step++) {
+        goldenInputs(state, step);
+        applyScenario(state, frameTime);
+        advanceSpacecraft(state, frameTime);
+
+        if ((step + 1) % GOLDEN_SAMPLE_EVERY != 0) continue;
+        GoldenSample s;
+        s.step = step + 1;
+        s.w = static_cast<double>(state.dynamics.orientation.w);
+        s.x = static_cast<double>(state.dynamics.orientation.x);
+        s.y = static_cast<double>(state.dynamics.orientation.y);
+        s.z = static_cast<double>(state.dynamics.orientation.z);
+        s.euler[0] = state.roll;
+        s.euler[1] = state.pitch;
+        s.euler[2] = state.yaw;
+        s.rates[0] = state.rollRate;
+        s.rates[1] = state.pitchRate;
+        s.rates[2] = state.yawRate;
+        trace.push_back(s);
+    }
+    if (usage) *usage = state.dynamics.thrusterUsage;
+    return trace;
+}
+
+static bool writeGolden(const char* path, const std::vector<GoldenSample>& trace) {
+    FILE* out = fopen(path, "w");
+    if (!out) {
+        std::cerr << "Cannot write golden trace " << path << std::endl;
+        return false;
+    }
+    fprintf(out, "step,w,x,y,z,roll,pitch,yaw,roll_rate,pitch_rate,yaw_rate\n");
+    for (size_t i = 0; i < trace.size(); i++) {
+        const GoldenSample& s = trace[i];
+        fprintf(out, "%d,%.12f,%.12f,%.12f,%.12f,%.9f,%.9f,%.9f,%.9f,%.9f,%.9f\n", s.step,
+                s.w, s.x, s.y, s.z, s.euler[0], s.euler[1], s.euler[2],
+                s.rates[0], s.rates[1], s.rates[2]);
+    }
+    fclose(out);
+    return true;
+}
+
+static bool readGolden(const char* path, std::vector<GoldenSample>& trace) {
+    FILE* in = fopen(path, "r");
+    if (!in) {
+        std::cerr << "Cannot read golden trace " << path << std::endl;
+        return false;
+    }
+    char header[256];
+    if (!fgets(header, sizeof(header), in)) {
+        fclose(in);
+        return false;
+    }
+    GoldenSample s;
+    while (fscanf(in, "%d,%lf,%lf,%lf,%lf,%lf,%lf,%lf,%lf,%lf,%lf", &s.step, &s.w, &s.x, &s.y,
+                  &s.z, &s.euler[0], &s.euler[1], &s.euler[2],
+                  &s.rates[0], &s.rates[1], &s.rates[2]) == 11) {
+        trace.push_back(s);
+    }
+    fclose(in);
+    return true;
+}
+
+// Returns 1 when the trace leaves the tolerance anywhere
+template <typename Dynamics>
+static int checkGolden(const std::vector<GoldenSample>& golden, const GoldenTolerance& tolerance) {
+    std::vector<GoldenSample> trace = runGolden<Dynamics>();
+    if (trace.size() != golden.size()) {
+        printf("  %-22s FAIL: %zu samples, golden has %zu\n", tolerance.name,
+               trace.size(), golden.size());
+        return 1;
+    }
+
+    double maxAttitude = 0.0, maxRate = 0.0;
+    int worstStep = 0;
+    for (size_t i = 0; i < golden.size(); i++) {
+        const GoldenSample& g = golden[i];
+        const GoldenSample& v = trace[i];
+        // |q1 - q2| = 2 sin(angle / 4) for unit quaternions; unlike acos of
+        // the dot product this stays accurate for tiny angles
+        double sign = (g.w*v.w + g.x*v.x + g.y*v.y + g.z*v.z) < 0.0 ? -1.0 : 1.0;
+        double dw = g.w - sign * v.w, dx = g.x - sign * v.x;
+        double dy = g.y - sign * v.y, dz = g.z - sign * v.z;
+        double chord = std::sqrt(dw*dw + dx*dx + dy*dy + dz*dz);
+        double angle = 4.0 * std::asin(std::min(1.0, chord / 2.0)) * DYNAMICS_RAD_TO_DEG;
+        if (angle > maxAttitude) {
+            maxAttitude = angle;
+            worstStep = g.step;
+        }
+        for (int axis = 0; axis < 3; axis++) {
+            maxRate = std::max(maxRate, std::fabs(g.rates[axis] - v.rates[axis]));
+        }
+    }
+
+    bool pass = maxAttitude <= tolerance.attitudeDeg && maxRate <= tolerance.rateDegS;
+    printf("  %-22s %12.6f %12.6f %10d   %s (limits %.6f deg, %.6f deg/s)\n", tolerance.name,
+           maxAttitude, maxRate, worstStep, pass ? "ok" : "FAIL",
+           tolerance.attitudeDeg, tolerance.rateDegS);
+    return pass ? 0 : 1;
+}
+
+// ============================================================================
+// THRUSTER ACCOUNTING
+// ============================================================================
+
+const double USAGE_IMPULSE_TOLERANCE = 0.001;   // Fraction of the reference impulse
+const uint32_t USAGE_PULSE_TOLERANCE = 2;       // Firings straddling the threshold
+
+// Returns 1 when a variant's golden-flight accounting strays from the
+// reference: impulse or firing time by more than the tolerance, or pulses
+template <typename Dynamics>
+static int checkUsage(const char* name, const ThrusterUsage& reference) {
+    ThrusterUsage usage;
+    runGolden<Dynamics>(&usage);
+
+    double impulseError = 0.0, dutyError = 0.0;
+    uint32_t pulseError = 0;
+    for (int axis = 0; axis < 3; axis++) {
+        double expected = reference.axisImpulse(axis);
+        if (expected > 0.0) {
+            impulseError = std::max(impulseError, std::fabs(usage.axisImpulse(axis) - expected) / expected);
+        }
+        dutyError = std::max(dutyError, std::fabs(usage.dutyCycle(axis) - reference.dutyCycle(axis)));
+        uint32_t a = usage.pulses[axis], b = reference.pulses[axis];
+        pulseError = std::max(pulseError, a > b ? a - b : b - a);
+    }
+
+    bool pass = impulseError <= USAGE_IMPULSE_TOLERANCE && dutyError <= USAGE_IMPULSE_TOLERANCE &&
+                pulseError <= USAGE_PULSE_TOLERANCE;
+    printf("  %-22s %12.3f %12u %10.5f   %s (%.4f of impulse, %u pulses off)\n", name,
+           usage.totalImpulse(), usage.totalPulses(), dutyError, pass ? "ok" : "FAIL",
+           impulseError, pulseError);
+    return pass ? 0 : 1;
+}
+
+// ============================================================================
+// ATTITUDE HOLD
+// ============================================================================
+
+const int HOLD_STEPS = 6000;                // 60 s at 100 Hz
+// THRUSTER_STUCK is the slowest (~8 s): 15 - 8 N*m left on the roll axis
+const double HOLD_SETTLE_LIMIT = 15.0;      // s
+const double HOLD_SETTLED_ERROR = 1.0;      // deg from the captured attitude
+const double HOLD_SETTLED_RATE = 0.5;       // deg/s
+
+struct HoldResult {
+    double settleSeconds;                   // < 0: never settled
+    double finalError;
+};
+
+// Engage at rest at the origin with a tumble of (6, -4, 3) deg/s; settled
+// from the last step that was outside the error or rate bound
+template <typename Dynamics>
+static HoldResult runHold(Scenario scenario) {
+    typedef typename Dynamics::Scalar T;
+    BasicSpacecraftState<Dynamics> state;
+    state.mode = ATTITUDE_HOLD;
+    state.scenario = scenario;
+    state.dynamics.angularVelocity = typename Dynamics::Vec(T(6.0f), T(-4.0f), T(3.0f));
+    const float frameTime = static_cast<float>(TIMESTEP);
+
+    int lastUnsettled = -1;
+    HoldResult result;
+    for (int step = 0; step < HOLD_STEPS; step++) {
+        applyScenario(state, frameTime);
+        advanceSpacecraft(state, frameTime);
+
+        double w = std::min(1.0, std::fabs(static_cast<double>(state.dynamics.orientation.w)));
+        double error = 2.0 * std::acos(w) * DYNAMICS_RAD_TO_DEG;
+        double rx = state.rollRate, ry = state.pitchRate, rz = state.yawRate;
+        double rate = std::sqrt(rx*rx + ry*ry + rz*rz);
+        if (error > HOLD_SETTLED_ERROR || rate > HOLD_SETTLED_RATE) lastUnsettled = step;
+        result.finalError = error;
+    }
+    result.settleSeconds = lastUnsettled == HOLD_STEPS - 1 ? -1.0 : (lastUnsettled + 1) * TIMESTEP;
+    return result;
+}
+
+// Returns 1 when any scenario fails to settle in time
+template <typename Dynamics>
+static int checkHold(const char* name) {
+    double worstSettle = 0.0, worstError = 0.0;
+    bool pass = true;
+    for (int scenario = NONE; scenario <= ORBITAL_DRIFT; scenario++) {
+        HoldResult r = runHold<Dynamics>(static_cast<Scenario>(scenario));
+        if (r.settleSeconds < 0.0 || r.settleSeconds > HOLD_SETTLE_LIMIT) pass = false;
+        worstSettle = std::max(worstSettle, r.settleSeconds < 0.0 ? HOLD_STEPS * TIMESTEP : r.settleSeconds);
+        worstError = std::max(worstError, r.finalError);
+    }
+
+    // Cost of a hold substep (controller frame included once per HOLD_PWM_FRAME)
+    BasicSpacecraftState<Dynamics> state;
+    state.mode = ATTITUDE_HOLD;
+    const int timedSteps = 200000;
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < timedSteps; i++) {
+        stepSpacecraft(state);
+    }
+    double nanos = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+    volatile double sink = static_cast<double>(state.dynamics.orientation.w);
+    (void)sink;
+
+    printf("  %-22s %12.2f %12.4f %10.1f   %s (limit %.0f s to %.1f deg, %.1f deg/s)\n", name,
+           worstSettle, worstError, nanos / timedSteps, pass ? "ok" : "FAIL",
+           HOLD_SETTLE_LIMIT, HOLD_SETTLED_ERROR, HOLD_SETTLED_RATE);
+    return pass ? 0 : 1;
+}
+
+// ============================================================================
+// MAIN
+// ============================================================================
+
+int main(int argc, char* argv[]) {
+    double seconds = 60.0;
+    const char* goldenPath = nullptr;
+    const char* writePath = nullptr;
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--seconds") == 0 && i + 1 < argc) {
+            seconds = std::max(1.0, atof(argv[++i]));
+        } else if (strcmp(argv[i], "--golden") == 0 && i + 1 < argc) {
+            goldenPath = argv[++i];
+        } else if (strcmp(argv[i], "--write-golden") == 0 && i + 1 < argc) {
+            writePath = argv[++i];
+        } else {
+            std::cerr << "Usage: " << argv[0]
+                      << " [--seconds S] [--golden FILE | --write-golden FILE]" << std::endl;
+            return 1;
+        }
+    }
+
+    // The desktop build defines the golden trace
+    if (writePath) {
+        if (!writeGolden(writePath, runGolden<BasicDynamics<double> >())) return 1;
+        printf("Golden trace written to %s\n", writePath);
+        return 0;
+    }
+
+    if (goldenPath) {
+        std::vector<GoldenSample> golden;
+        if (!readGolden(goldenPath, golden)) return 1;
+
+        static const GoldenTolerance DESKTOP = {"desktop (double)", 1e-6, 1e-6};
+        static const GoldenTolerance ESP32_FLOAT = {"esp32 (float)", 0.01, 0.001};
+        static const GoldenTolerance ESP32_FIXED = {"esp32 (Q16.16+Q2.30)", 0.1, 0.01};
+
+        printf("\nShared simulation vs golden trace %s: %zu samples over %d steps\n",
+               goldenPath, golden.size(), GOLDEN_STEPS);
+        printf("  %-22s %12s %12s %10s\n", "target", "att (deg)", "rate (deg/s)", "worst step");
+        int failures = checkGolden<BasicDynamics<double> >(golden, DESKTOP) +
+                       checkGolden<BasicDynamics<float> >(golden, ESP32_FLOAT) +
+                       checkGolden<BasicDynamics<Q16_16, Q2_30> >(golden, ESP32_FIXED);
+
+        ThrusterUsage reference;
+        runGolden<BasicDynamics<double> >(&reference);
+        printf("\nThruster accounting over the golden flight vs double\n");
+        printf("  %-22s %12s %12s %10s\n", "target", "impulse", "pulses", "duty diff");
+        failures += checkUsage<BasicDynamics<float> >(ESP32_FLOAT.name, reference) +
+                    checkUsage<BasicDynamics<Q16_16, Q2_30> >(ESP32_FIXED.name, reference);
+
+        printf("\nAttitude hold from a (6, -4, 3) deg/s tumble, every scenario, %d steps\n", HOLD_STEPS);
+        printf("  %-22s %12s %12s %10s\n", "target", "settle (s)", "final (deg)", "ns/step");
+        failures += checkHold<BasicDynamics<double> >(DESKTOP.name) +
+                    checkHold<BasicDynamics<float> >(ESP32_FLOAT.name) +
+                    checkHold<BasicDynamics<Q16_16, Q2_30> >(ESP32_FIXED.name);
+        return failures == 0 ? 0 : 1;
+    }
+
+    const int steps = static_cast<int>(seconds / TIMESTEP);
+    std::vector<Sample> reference = runTrace<BasicDynamics<double> >(steps);
+    double referenceNanos = nanosPerStep<BasicDynamics<double> >(steps);
+
+    printf("\nDynamics scalar variants vs double reference: %d steps (%.0f s at 100 Hz)\n",
+           steps, seconds);
+    printf("  %-22s %10s %10s %10s %10s %9s %9s\n", "variant", "att max", "att rms",
+           "rate max", "euler max", "ns/step", "speedup");
+    printf("  %-22s %10s %10s %10s %10s %9s\n", "", "(deg)", "(deg)", "(deg/s)", "(deg)", "(host)");
+
+    report<BasicDynamics<double> >("double (reference)", reference, steps, referenceNanos);
+    report<BasicDynamics<float> >("float", reference, steps, referenceNanos);
+    report<BasicDynamics<Q16_16, Q2_30> >("Q16.16 + Q2.30 quat", reference, steps, referenceNanos);
+    report<BasicDynamics<Q16_16> >("Q16.16 throughout", reference, steps, referenceNanos);
+
+    printf("\n  Tick budget on a 240 MHz S3: %.0f cycles per 10 ms step.\n", DEVICE_TICK_CYCLES);
+    printf("  Measure on device: handler.ino prints cycles/tick and %% of budget every second.\n");
+    return 0;
+}
@@ -0,0 +1,313 @@
+/*
+ * Host Benchmark for the ESP32 Renderer
+ *
+ * Builds render.h and state.h against the TFT_eSPI emulator in this
+ * directory and runs a scripted flight through updateSpacecraft() for each
+ * layout (compact 480x320, minimal 320x240) and each push path (full frame,
+ * dirty rects, dirty rects through the DMA queue). Reports per frame:
+ *   - pixels drawn into sprites and bytes/windows sent over SPI
+ *   - pixels restored from the static layer (informational only)
+ *   - modeled SPI time and modeled device frame time
+ *   - host compose time and host physics time (informational only)
+ * The full-frame path is the reference renderer (drawString readouts); the
+ * dirty-rect and DMA panels, which draw readouts from the glyph cache, must
+ * match it on every frame, and the DMA path must never touch a buffer still
+ * being transferred. Sprite pixels include raw glyph-cache stores.
+ *
+ * The deterministic counters can be saved as a baseline and checked later;
+ * any counter growing past the tolerance fails the run.
+ *
+ * Usage: ./render_host [--frames N] [--spi-mhz F] [--pixel-ns N] [--no-glyph-cache]
+ *                      [--no-footprints]
+ *                      [--write-baseline FILE] [--baseline FILE [--tolerance PCT]]
+ */
+
+#include <Arduino.h>
+#include <TFT_eSPI.h>
+#include "state.h"
+#include "render.h"
+
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+// ============================================================================
+// CONFIGURATION
+// ============================================================================
+
+struct LayoutConfig {
+    const char* name;
+    int width;
+    int height;
+};
+
+static const LayoutConfig LAYOUTS[] = {
+    {"compact", 480, 320},
+    {"minimal", 320, 240}
+};
+
+struct BenchConfig {
+    int frames = 600;
+    SpiModel spi = defaultSpiModel();
+    double pixelNs = 6.0;   // Device cost per sprite pixel drawn (PSRAM sprite, 240 MHz)
+    bool glyphCache = true;
+    bool footprints = true;
+};
+
+enum PushPath { PATH_FULL, PATH_DIRTY, PATH_DMA, PATH_COUNT };
+
+static const char* PATH_NAMES[PATH_COUNT] = {"full", "dirty", "dma"};
+
+// Per-frame averages for one layout/path run
+struct RunResult {
+    std::string layout;
+    std::string path;
+    double spritePixels = 0.0;
+    double restoredPixels = 0.0;
+    double spiBytes = 0.0;
+    double spiWindows = 0.0;
+    double spiMicros = 0.0;
+    double deviceMicros = 0.0;
+    double hostComposeMicros = 0.0;
+    double hostPhysicsMicros = 0.0;
+    uint64_t dmaViolations = 0;
+};
+
+// ============================================================================
+// SCRIPTED FLIGHT
+// ============================================================================
+
+// Same input sequence for every run: full-deflection manual rates, a
+// fly-by-wire burn, then rate-command manoeuvres
+static void scriptInputs(SpacecraftState& state, int frame) {
+    int phase = frame % 600;
+    if (phase < 200) {
+        state.mode = MANUAL;
+        state.rollRate = 15.0f;
+        state.pitchRate = -8.0f;
+        state.yawRate = 5.0f * sin(frame * 0.02f);
+    } else if (phase < 400) {
+        state.mode = FLY_BY_WIRE;
+        state.flyByWireRoll = (phase < 300) ? 100.0f : -100.0f;
+        state.flyByWirePitch = 50.0f;
+        state.flyByWireYaw = 0.0f;
+    } else {
+        state.mode = RATE_COMMAND;
+        state.rollCommand = 15.0f * sin(frame * 0.02f);
+        state.pitchCommand = -15.0f;
+        state.yawCommand = 10.0f;
+    }
+}
+
+static uint64_t hashFrame(const uint16_t* pixels, size_t count) {
+    uint64_t hash = 1469598103934665603ull;
+    for (size_t i = 0; i < count; i++) {
+        hash = (hash ^ pixels[i]) * 1099511628211ull;
+    }
+    return hash;
+}
+
+// ============================================================================
+// BENCHMARK
+// ============================================================================
+
+static RunResult runLayout(const LayoutConfig& layout, PushPath path, const BenchConfig& config,
+                           std::vector<uint64_t>& frameHashes, int& mismatches) {
+    TFT_eSPI panel(layout.width, layout.height);
+    panel.init();
+    panel.setSpiModel(config.spi);
+
+    SpacecraftRender renderer(&panel);
+    renderer.setPartialUpdates(path != PATH_FULL);
+    renderer.setGlyphCache(path != PATH_FULL && config.glyphCache);
+    renderer.setNeedleFootprints(config.footprints);
+    if (path == PATH_DMA && !renderer.enableDma()) {
+        std::cerr << layout.name << ": DMA queue failed to start" << std::endl;
+    }
+
+    SpacecraftState state;
+    const size_t pixels = static_cast<size_t>(layout.width) * layout.height;
+    unsigned long physicsMicros = 0;
+
+    panel.resetTransferStats();
+    tftHostCounters() = TftHostCounters();
+
+    for (int frame = 0; frame < config.frames; frame++) {
+        scriptInputs(state, frame);
+
+        unsigned long start = micros();
+        updateSpacecraft(state, 0.02f);
+        physicsMicros += micros() - start;
+
+        renderer.drawMainDisplay(state);
+
+        uint64_t hash = hashFrame(panel.frameBuffer(), pixels);
+        if (path == PATH_FULL) {
+            frameHashes.push_back(hash);
+        } else if (frame < static_cast<int>(frameHashes.size()) && frameHashes[frame] != hash) {
+            if (mismatches == 0) {
+                std::cerr << layout.name << " frame " << frame << ": " << PATH_NAMES[path]
+                          << " panel differs from full redraw" << std::endl;
+            }
+            mismatches++;
+        }
+    }
+    renderer.waitTransfers();
+
+    const SpiTransferStats& transfer = panel.getTransferStats();
+    const double frames = config.frames;
+
+    RunResult result;
+    result.layout = layout.name;
+    result.path = PATH_NAMES[path];
+    result.spritePixels = (tftHostCounters().spritePixels + renderer.getStats().totalGlyphPixels) / frames;
+    result.restoredPixels = static_cast<double>(renderer.getStats().totalRestoredPixels) / frames;
+    result.spiBytes = (transfer.commandBytes + transfer.pixelBytes) / frames;
+    result.spiWindows = transfer.windows / frames;
+    result.spiMicros = transfer.nanos / 1000.0 / frames;
+    double cpuMicros = result.spritePixels * config.pixelNs / 1000.0;
+    // DMA: the wire overlaps composing the next frame, so the bound is the slower of the two
+    result.deviceMicros = (path == PATH_DMA) ? std::max(result.spiMicros, cpuMicros)
+                                             : result.spiMicros + cpuMicros;
+    result.hostComposeMicros = static_cast<double>(renderer.getStats().totalMicros) / frames;
+    result.hostPhysicsMicros = physicsMicros / frames;
+    result.dmaViolations = panel.getDmaViolations();
+    return result;
+}
+
+// ============================================================================
+// BASELINE
+// ============================================================================
+
+// Deterministic counters only; host timings vary between machines
+static void writeBaseline(const char* path, const std::vector<RunResult>& results) {
+    std::ofstream out(path);
+    out << "layout,path,sprite_pixels,spi_bytes,spi_windows,spi_us\n";
+    for (size_t i = 0; i < results.size(); i++) {
+        const RunResult& r = results[i];
+        out << r.layout << "," << r.path << "," << r.spritePixels << "," << r.spiBytes
+            << "," << r.spiWindows << "," << r.spiMicros << "\n";
+    }
+}
+
+static int checkBaseline(const char* path, const std::vector<RunResult>& results, double tolerance) {
+    std::ifstream in(path);
+    if (!in) {
+        std::cerr << "Cannot read baseline " << path << std::endl;
+        return 1;
+    }
+
+    static const char* metricNames[] = {"sprite_pixels", "spi_bytes", "spi_windows", "spi_us"};
+    int regressions = 0;
+    std::string line;
+    std::getline(in, line);   // Header
+
+    while (std::getline(in, line)) {
+        std::stringstream fields(line);
+        std::string layout, path, value;
+        std::getline(fields, layout, ',');
+        std::getline(fields, path, ',');
+
+        double baseline[4];
+        for (int m = 0; m < 4; m++) {
+            std::getline(fields, value, ',');
+            baseline[m] = atof(value.c_str());
+        }
+
+        for (size_t i = 0; i < results.size(); i++) {
+            const RunResult& r = results[i];
+            if (r.layout != layout || r.path != path) continue;
+
+            const double current[4] = {r.spritePixels, r.spiBytes, r.spiWindows, r.spiMicros};
+            for (int m = 0; m < 4; m++) {
+                if (current[m] > baseline[m] * (1.0 + tolerance / 100.0) + 1e-9) {
+                    printf("REGRESSION %s/%s %s: %.1f -> %.1f\n", layout.c_str(), path.c_str(),
+                           metricNames[m], baseline[m], current[m]);
+                    regressions++;
+                }
+            }
+        }
+    }
+    return regressions;
+}
+
+// ============================================================================
+// MAIN
+// ============================================================================
+
+int main(int argc, char* argv[]) {
+    BenchConfig config;
+    const char* baselinePath = nullptr;
+    const char* writePath = nullptr;
+    double tolerance = 2.0;
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--frames") == 0 && i + 1 < argc) {
+            config.frames = std::max(1, atoi(argv[++i]));
+        } else if (strcmp(argv[i], "--spi-mhz") == 0 && i + 1 < argc) {
+            config.spi.clockHz = static_cast<uint32_t>(atof(argv[++i]) * 1e6);
+        } else if (strcmp(argv[i], "--pixel-ns") == 0 && i + 1 < argc) {
+            config.pixelNs = atof(argv[++i]);
+        } else if (strcmp(argv[i], "--no-glyph-cache") == 0) {
+            config.glyphCache = false;
+        } else if (strcmp(argv[i], "--no-footprints") == 0) {
+            config.footprints = false;
+        } else if (strcmp(argv[i], "--baseline") == 0 && i + 1 < argc) {
+            baselinePath = argv[++i];
+        } else if (strcmp(argv[i], "--write-baseline") == 0 && i + 1 < argc) {
+            writePath = argv[++i];
+        } else if (strcmp(argv[i], "--tolerance") == 0 && i + 1 < argc) {
+            tolerance = atof(argv[++i]);
+        } else {
+            std::cerr << "Usage: " << argv[0] << " [--frames N] [--spi-mhz F] [--pixel-ns N] [--no-glyph-cache]"
+                      << " [--no-footprints] [--write-baseline FILE] [--baseline FILE [--tolerance PCT]]" << std::endl;
+            return 1;
+        }
+    }
+    if (config.spi.clockHz == 0) {
+        std::cerr << "--spi-mhz must be positive" << std::endl;
+        return 1;
+    }
+
+    printf("\nESP32 render benchmark: %d frames per run, SPI %.0f MHz, %.1f ns/sprite pixel\n",
+           config.frames, config.spi.clockHz / 1e6, config.pixelNs);
+    printf("  %-8s %-6s %12s %11s %11s %8s %9s %10s %10s %10s\n", "layout", "path", "sprite px",
+           "restore px", "SPI bytes", "windows", "SPI us", "device us", "host us", "physics us");
+
+    std::vector<RunResult> results;
+    int mismatches = 0;
+    uint64_t dmaViolations = 0;
+
+    for (size_t i = 0; i < sizeof(LAYOUTS) / sizeof(LAYOUTS[0]); i++) {
+        std::vector<uint64_t> frameHashes;
+        for (int path = 0; path < PATH_COUNT; path++) {
+            RunResult r = runLayout(LAYOUTS[i], static_cast<PushPath>(path), config,
+                                    frameHashes, mismatches);
+            dmaViolations += r.dmaViolations;
+            printf("  %-8s %-6s %12.0f %11.0f %11.0f %8.2f %9.1f %10.1f %10.1f %10.2f\n",
+                   r.layout.c_str(), r.path.c_str(), r.spritePixels, r.restoredPixels, r.spiBytes, r.spiWindows,
+                   r.spiMicros, r.deviceMicros, r.hostComposeMicros, r.hostPhysicsMicros);
+            results.push_back(r);
+        }
+    }
+
+    printf("  Device us = SPI us + sprite px x pixel ns (dma: the larger of the two, ideal overlap);\n"
+           "  frame budget at 50 Hz is 20000 us\n");
+    printf("  %d mismatched frames between paths, %llu DMA buffer reuse violations\n",
+           mismatches, (unsigned long long)dmaViolations);
+
+    if (writePath) {
+        writeBaseline(writePath, results);
+        printf("Baseline written to %s\n", writePath);
+    }
+
+    int regressions = 0;
+    if (baselinePath) {
+        regressions = checkBaseline(baselinePath, results, tolerance);
+        printf("Baseline %s: %d regressions (tolerance %.1f%%)\n", baselinePath, regressions, tolerance);
+    }
+
+    return (mismatches == 0 && dmaViolations == 0 && regressions == 0) ? 0 : 1;
+}
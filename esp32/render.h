@@ -1,6 +1,19 @@
 /**
  * Spacecraft Render - TFT Display Version
  * Simplified - Three gauges only, no rate bars
+ *
+ * Static content (dials, captions, mode) is cached in a second sprite; each
+ * frame only what changed is restored from it, redrawn and pushed. A moving
+ * needle is erased row by row over the pixels it covered (its footprint),
+ * not its bounding box, and pushed as bands that keep a diagonal needle from
+ * dragging its whole box over SPI.
+ *
+ * With enableDma() the pushes go out through DmaPushQueue: drawMainDisplay()
+ * returns while the last band is still on the wire.
+ *
+ * Readouts are formatted with integer math and drawn from a glyph cache;
+ * when a readout keeps its length only the character cells that changed are
+ * restored and redrawn.
  */
 
 #ifndef RENDER_H
@@ -8,6 +21,9 @@
 
 #include <TFT_eSPI.h>
 #include "state.h"
+#include "gauge_lod.h"
+#include "dma_push.h"
+#include "glyph_cache.h"
 
 // Color definitions (RGB565)
 #define COLOR_BACKGROUND  0x2104  // Dark gray
@@ -18,16 +34,126 @@
 #define COLOR_BLACK       0x0000
 #define COLOR_GRAY        0x7BEF
 
+// Screen-space rectangle; empty when w or h is 0
+struct DirtyRect {
+    int16_t x, y, w, h;
+    
+    DirtyRect() : x(0), y(0), w(0), h(0) {}
+    DirtyRect(int x, int y, int w, int h) : x(x), y(y), w(w), h(h) {}
+    
+    bool empty() const { return w <= 0 || h <= 0; }
+    
+    bool intersects(const DirtyRect& other) const {
+        return !empty() && !other.empty() &&
+               x < other.x + other.w && other.x < x + w &&
+               y < other.y + other.h && other.y < y + h;
+    }
+    
+    DirtyRect unite(const DirtyRect& other) const {
+        if (empty()) return other;
+        if (other.empty()) return *this;
+        int left = min(x, other.x), top = min(y, other.y);
+        int right = max(x + w, other.x + other.w), bottom = max(y + h, other.y + other.h);
+        return DirtyRect(left, top, right - left, bottom - top);
+    }
+    
+    DirtyRect clip(int width, int height) const {
+        int left = max((int)x, 0), top = max((int)y, 0);
+        int right = min(x + w, width), bottom = min(y + h, height);
+        if (right <= left || bottom <= top) return DirtyRect();
+        return DirtyRect(left, top, right - left, bottom - top);
+    }
+};
+
+// Transfer statistics; "last" fields describe the most recent frame
+struct RenderStats {
+    uint32_t lastMicros = 0;     // Compose + push time
+    uint32_t lastBytes = 0;      // Pixel bytes sent to the panel
+    uint16_t lastRects = 0;      // Windows pushed (1 for a full frame)
+    bool lastFull = false;
+    uint32_t lastWaitMicros = 0;     // Blocked on the DMA engine (0 without DMA)
+    uint32_t lastTransferMicros = 0; // Last completed frame: endFrame to done
+    
+    uint32_t frames = 0;
+    uint64_t totalMicros = 0;
+    uint64_t totalBytes = 0;
+    uint64_t totalWaitMicros = 0;
+    uint64_t totalGlyphPixels = 0;   // Written by glyph cache blits (raw stores)
+    uint64_t totalRestoredPixels = 0; // Copied back from the static layer
+};
+
+// Moving elements per frame: three needles and up to three readouts
+const int RENDER_MAX_DIRTY = 6;
+
+// Longest needle footprint in rows; taller needles fall back to their box
+const int NEEDLE_MAX_ROWS = 160;
+
+// An SPI window costs 11 command bytes plus ~1.5 us of transaction setup,
+// about nine pixels at 40 MHz; banding trades pushed pixels against windows
+const int RENDER_WINDOW_COST_PIXELS = 9;
+
+// Row spans [left, right) covered by a needle, from row top down; a row
+// with left == right is empty. rows == 0: no footprint (use the box)
+struct NeedleFootprint {
+    int16_t top, rows;
+    int16_t left[NEEDLE_MAX_ROWS];
+    int16_t right[NEEDLE_MAX_ROWS];
+};
+
 class SpacecraftRender {
 private:
+    // Gauge placement for the active layout
+    struct GaugeSlot {
+        int cx, cy, radius;
+    };
+    
+    // What a readout covered when it was last drawn
+    struct DynamicItem {
+        DirtyRect drawn;
+        char text[24];
+    };
+    
+    // A needle's last two footprints: shape[current] as drawn now,
+    // shape[current ^ 1] as drawn before it moved this frame
+    struct NeedleItem {
+        DirtyRect drawn;      // Box of shape[current]
+        DirtyRect moved;      // Box of both shapes while moving, else empty
+        int16_t endX, endY;   // Tip
+        uint8_t current;
+        NeedleFootprint shape[2];
+    };
+    
     TFT_eSPI* tft;
-    TFT_eSprite* sprite;
+    TFT_eSprite* sprite;        // Frame being composed
+    TFT_eSprite* staticLayer;   // Background, dials and captions; null = full redraws
     
     int screenWidth;
     int screenHeight;
+    bool compact;
+    
+    GaugeSlot gauges[3];
+    NeedleItem needles[3];
+    DynamicItem readouts[3];    // Compact: one per gauge. Minimal: [0] only
+    int readoutCount;
+    
+    bool partialUpdates;
+    bool staticValid;
+    ControlMode staticMode;
+    
+    DirtyRect dirty[RENDER_MAX_DIRTY];
+    int dirtyCount;
+    
+    RenderStats stats;
+    
+    GlyphCache glyphs;
+    bool glyphCacheEnabled;
+    bool footprintsEnabled;
+    
+    DmaPushQueue dma;
+    uint32_t frameId;
     
 public:
-    SpacecraftRender(TFT_eSPI* display) : tft(display) {
+    SpacecraftRender(TFT_eSPI* display) : tft(display), dma(display), frameId(0) {
         screenWidth = tft->width();
         screenHeight = tft->height();
         
@@ -35,122 +161,597 @@ public:
         sprite = new TFT_eSprite(tft);
         sprite->createSprite(screenWidth, screenHeight);
         sprite->setTextDatum(MC_DATUM);  // Middle center
+        
+        // Second full-screen sprite holding everything that doesn't move.
+        // Lands in PSRAM when available; without it we fall back to full pushes.
+        staticLayer = new TFT_eSprite(tft);
+        if (staticLayer->createSprite(screenWidth, screenHeight) == nullptr) {
+            delete staticLayer;
+            staticLayer = nullptr;
+        } else {
+            staticLayer->setTextDatum(MC_DATUM);
+        }
+        
+        compact = screenWidth >= 480;
+        setupLayout();
+        
+        glyphCacheEnabled = true;
+        static const uint16_t readoutColors[3] = {COLOR_ROLL, COLOR_PITCH, COLOR_YAW};
+        static const uint16_t white = COLOR_WHITE;
+        glyphs.build(tft, compact ? 2 : 1, compact ? readoutColors : &white, compact ? 3 : 1);
+        
+        partialUpdates = true;
+        footprintsEnabled = true;
+        staticValid = false;
+        staticMode = MANUAL;
+        dirtyCount = 0;
+        
+        dma.setCallback(onFrameTransferred, this);
     }
     
     ~SpacecraftRender() {
+        dma.end();
+        delete staticLayer;
         delete sprite;
     }
     
-    void drawMainDisplay(SpacecraftState& state) {
-        sprite->fillSprite(COLOR_BACKGROUND);
+    void drawMainDisplay(const SpacecraftState& state) {
+        uint32_t start = micros();
+        stats.lastBytes = 0;
+        stats.lastRects = 0;
+        if (dma.isReady()) dma.beginFrame(++frameId);
         
-        // For 480x320 landscape display
-        if (screenWidth >= 480) {
-            drawCompactLayout(state);
+        if (!partialUpdates || staticLayer == nullptr) {
+            // Compose everything into the frame sprite and push it whole
+            drawStaticLayer(sprite, state);
+            dirtyCount = 0;
+            updateDynamicItems(state, true);
+            pushFullFrame();
+            staticValid = false;
+        } else if (!staticValid || state.mode != staticMode) {
+            // (Re)build the cache, then start the frame from it
+            drawStaticLayer(staticLayer, state);
+            memcpy(sprite->getPointer(), staticLayer->getPointer(),
+                   (size_t)screenWidth * screenHeight * sizeof(uint16_t));
+            dirtyCount = 0;
+            updateDynamicItems(state, true);
+            pushFullFrame();
+            staticValid = true;
+            staticMode = state.mode;
         } else {
-            drawMinimalLayout(state);
+            // Restore, redraw and push only what moved
+            dirtyCount = 0;
+            updateDynamicItems(state, false);
+            
+            for (int i = 0; i < dirtyCount; i++) {
+                restoreRect(dirty[i]);
+            }
+            for (int i = 0; i < 3; i++) {
+                if (!needles[i].moved.empty()) {
+                    restoreFootprint(needles[i].shape[needles[i].current ^ 1]);
+                }
+            }
+            redrawDynamicItems();
+            for (int i = 0; i < dirtyCount; i++) {
+                pushRect(dirty[i]);
+                stats.lastBytes += (uint32_t)dirty[i].w * dirty[i].h * sizeof(uint16_t);
+            }
+            stats.lastRects = dirtyCount;
+            for (int i = 0; i < 3; i++) {
+                if (!needles[i].moved.empty()) {
+                    pushNeedleBands(needles[i]);
+                }
+            }
+            stats.lastFull = false;
         }
         
-        sprite->pushSprite(0, 0);
+        if (dma.isReady()) {
+            dma.endFrame();
+            stats.lastWaitMicros = dma.takeWaitMicros();
+            stats.totalWaitMicros += stats.lastWaitMicros;
+        }
+        
+        stats.lastMicros = micros() - start;
+        stats.frames++;
+        stats.totalMicros += stats.lastMicros;
+        stats.totalBytes += stats.lastBytes;
     }
     
+    // Partial updates are on by default; off = original full-frame push
+    void setPartialUpdates(bool enabled) { partialUpdates = enabled; }
+    bool getPartialUpdates() const { return partialUpdates && staticLayer != nullptr; }
+    
+    // Glyph cache is on by default; off = drawString() for every readout
+    void setGlyphCache(bool enabled) { glyphCacheEnabled = enabled; }
+    
+    // Needle footprints are on by default; off = restore and push the box
+    void setNeedleFootprints(bool enabled) { footprintsEnabled = enabled; }
+    
+    // Switch pushes to DMA; false (no DMA memory/channel) keeps blocking pushes
+    bool enableDma() { return dma.begin(); }
+    bool getDmaEnabled() const { return dma.isReady(); }
+    
+    // Block until the panel holds the last composed frame
+    void waitTransfers() { if (dma.isReady()) dma.waitIdle(); }
+    
+    const RenderStats& getStats() const { return stats; }
+    void resetStats() { stats = RenderStats(); }
+    
 private:
-    void drawCompactLayout(SpacecraftState& state) {
+    void setupLayout() {
+        if (compact) {
+            // For 480x320 landscape display: three gauges centered vertically
+            gauges[0].cx = 80;
+            gauges[1].cx = 240;
+            gauges[2].cx = 400;
+            for (int i = 0; i < 3; i++) {
+                gauges[i].cy = 160;
+                gauges[i].radius = 60;
+            }
+            readoutCount = 3;
+        } else {
+            // For smaller displays - three gauges sized to fit, detail per gauge_lod.h
+            int column = screenWidth / 3;
+            int radius = min(column / 2 - 4, (screenHeight - 60) / 2);
+            for (int i = 0; i < 3; i++) {
+                gauges[i].cx = i * column + column / 2;
+                gauges[i].cy = screenHeight / 2;
+                gauges[i].radius = radius;
+            }
+            readoutCount = 1;
+        }
+        
+        for (int i = 0; i < 3; i++) {
+            needles[i].drawn = needles[i].moved = DirtyRect();
+            needles[i].endX = needles[i].endY = -1;
+            needles[i].current = 0;
+            needles[i].shape[0].rows = needles[i].shape[1].rows = 0;
+            readouts[i].drawn = DirtyRect();
+            readouts[i].text[0] = '\0';
+        }
+    }
+    
+    // ========================================================================
+    // STATIC LAYER
+    // ========================================================================
+    
+    void drawStaticLayer(TFT_eSprite* target, const SpacecraftState& state) {
+        target->fillSprite(COLOR_BACKGROUND);
+        
         // Title
-        sprite->setTextColor(COLOR_WHITE);
-        sprite->setTextSize(2);
-        sprite->drawString("PROJECT MERCURY", screenWidth / 2, 15);
+        target->setTextColor(COLOR_WHITE);
+        if (compact) {
+            target->setTextSize(2);
+            target->drawString("PROJECT MERCURY", screenWidth / 2, 15);
+        } else {
+            target->setTextSize(1);
+            target->drawString("MERCURY", screenWidth / 2, 10);
+        }
         
-        // Three circular gauges centered vertically
-        int gaugeRadius = 60;
-        int gaugeY = 160;
+        static const char* labels[3] = {"ROLL", "PITCH", "YAW"};
+        for (int i = 0; i < 3; i++) {
+            drawGaugeDial(target, gauges[i], labels[i]);
+        }
         
-        drawCircularGauge(80, gaugeY, gaugeRadius, state.roll, COLOR_ROLL, "ROLL");
-        drawCircularGauge(240, gaugeY, gaugeRadius, state.pitch, COLOR_PITCH, "PITCH");
-        drawCircularGauge(400, gaugeY, gaugeRadius, state.yaw, COLOR_YAW, "YAW");
+        // Mode display at bottom
+        if (compact) {
+            target->setTextSize(1);
+            target->setTextColor(COLOR_WHITE);
+            target->drawString(getModeString(state.mode), screenWidth / 2, 300);
+        }
+    }
+    
+    void drawGaugeDial(TFT_eSprite* target, const GaugeSlot& gauge, const char* label) {
+        const GaugeLod lod = selectGaugeLod(gauge.radius);
+        int cx = gauge.cx, cy = gauge.cy, radius = gauge.radius;
         
-        // Numeric readouts below gauges
-        sprite->setTextSize(2);
-        char buf[32];
+        // Outer circle (double rim only at full detail)
+        target->drawCircle(cx, cy, radius, COLOR_WHITE);
+        if (lod.detail == GAUGE_DETAIL_FULL) {
+            target->drawCircle(cx, cy, radius - 1, COLOR_WHITE);
+        }
         
-        sprintf(buf, "%.0f", state.roll);
-        sprite->setTextColor(COLOR_ROLL);
-        sprite->drawString(buf, 80, gaugeY + gaugeRadius + 20);
+        // Cardinal marks (0, 90, 180, 270)
+        if (lod.majorTicks) {
+            for (int deg = 0; deg < 360; deg += 90) {
+                float rad = (deg - 90) * PI / 180.0f;
+                int x1 = cx + (radius - 10) * cos(rad);
+                int y1 = cy + (radius - 10) * sin(rad);
+                int x2 = cx + radius * cos(rad);
+                int y2 = cy + radius * sin(rad);
+                target->drawLine(x1, y1, x2, y2, COLOR_WHITE);
+            }
+        }
         
-        sprintf(buf, "%.0f", state.pitch);
-        sprite->setTextColor(COLOR_PITCH);
-        sprite->drawString(buf, 240, gaugeY + gaugeRadius + 20);
+        // Minor marks every 30 degrees
+        if (lod.minorTicks) {
+            for (int deg = 0; deg < 360; deg += 30) {
+                if (deg % 90 == 0) continue;  // Skip cardinals
+                float rad = (deg - 90) * PI / 180.0f;
+                int x1 = cx + (radius - 5) * cos(rad);
+                int y1 = cy + (radius - 5) * sin(rad);
+                int x2 = cx + radius * cos(rad);
+                int y2 = cy + radius * sin(rad);
+                target->drawLine(x1, y1, x2, y2, COLOR_GRAY);
+            }
+        }
         
-        sprintf(buf, "%.0f", state.yaw);
-        sprite->setTextColor(COLOR_YAW);
-        sprite->drawString(buf, 400, gaugeY + gaugeRadius + 20);
+        // Label
+        if (lod.caption) {
+            target->setTextColor(COLOR_WHITE);
+            target->setTextSize(1);
+            target->drawString(label, cx, cy + radius + 12);
+        }
+    }
+    
+    // ========================================================================
+    // DIRTY-RECTANGLE TRACKING
+    // ========================================================================
+    
+    void markDirty(const DirtyRect& rect) {
+        DirtyRect area = rect.clip(screenWidth, screenHeight);
+        if (area.empty()) return;
         
-        // Mode display at bottom
-        sprite->setTextSize(1);
-        sprite->setTextColor(COLOR_WHITE);
-        sprite->drawString(getModeString(state.mode), screenWidth / 2, 300);
+        // Absorb every rect the area overlaps, checking again each time it
+        // grows, so the list stays disjoint and no pixel is pushed twice.
+        // A full list folds its last rect in the same way.
+        bool merged = true;
+        while (merged) {
+            merged = false;
+            for (int i = 0; i < dirtyCount; i++) {
+                if (dirty[i].intersects(area)) {
+                    area = area.unite(dirty[i]);
+                    dirty[i] = dirty[--dirtyCount];
+                    merged = true;
+                    break;
+                }
+            }
+            if (!merged && dirtyCount == RENDER_MAX_DIRTY) {
+                area = area.unite(dirty[--dirtyCount]);
+                merged = true;
+            }
+        }
+        dirty[dirtyCount++] = area;
     }
     
-    void drawMinimalLayout(SpacecraftState& state) {
-        // For smaller displays - simplified single gauge view
-        sprite->setTextSize(1);
-        sprite->setTextColor(COLOR_WHITE);
-        sprite->drawString("MERCURY", screenWidth / 2, 10);
+    // Copy the cached static pixels back over a rect of the frame sprite
+    void restoreRect(const DirtyRect& rect) {
+        uint16_t* dst = (uint16_t*)sprite->getPointer();
+        const uint16_t* src = (const uint16_t*)staticLayer->getPointer();
+        for (int row = rect.y; row < rect.y + rect.h; row++) {
+            size_t offset = (size_t)row * screenWidth + rect.x;
+            memcpy(dst + offset, src + offset, rect.w * sizeof(uint16_t));
+        }
+        stats.totalRestoredPixels += (uint32_t)rect.w * rect.h;
+    }
+    
+    // Erase a needle: restore just the spans it covered
+    void restoreFootprint(const NeedleFootprint& shape) {
+        for (int r = 0; r < shape.rows; r++) {
+            DirtyRect span = DirtyRect(shape.left[r], shape.top + r,
+                                       shape.right[r] - shape.left[r], 1).clip(screenWidth, screenHeight);
+            if (!span.empty()) restoreRect(span);
+        }
+    }
+    
+    // Push a moving needle's old and new footprints as horizontal bands. A
+    // row joins the band above while the extra pixels that costs are fewer
+    // than a window's worth; a near-vertical or short needle ends up as one
+    // box, a long diagonal one as a staircase of thin bands.
+    void pushNeedleBands(const NeedleItem& needle) {
+        const NeedleFootprint& a = needle.shape[needle.current];
+        const NeedleFootprint& b = needle.shape[needle.current ^ 1];
+        DirtyRect band;
         
-        int centerX = screenWidth / 2;
-        int centerY = screenHeight / 2;
+        for (int y = needle.moved.y; y < needle.moved.y + needle.moved.h; y++) {
+            int left = INT16_MAX, right = INT16_MIN;
+            footprintRow(a, y, left, right);
+            footprintRow(b, y, left, right);
+            DirtyRect span = DirtyRect(left, y, right - left, 1).clip(screenWidth, screenHeight);
+            
+            if (!band.empty() && !span.empty()) {
+                DirtyRect merged = band.unite(span);
+                int mergedCost = merged.w * merged.h;
+                int splitCost = band.w * band.h + span.w + RENDER_WINDOW_COST_PIXELS;
+                if (mergedCost <= splitCost) {
+                    band = merged;
+                    continue;
+                }
+            }
+            pushBand(band);
+            band = span;
+        }
+        pushBand(band);
+    }
+    
+    static void footprintRow(const NeedleFootprint& shape, int y, int& left, int& right) {
+        int r = y - shape.top;
+        if (r < 0 || r >= shape.rows || shape.left[r] >= shape.right[r]) return;
+        left = min(left, (int)shape.left[r]);
+        right = max(right, (int)shape.right[r]);
+    }
+    
+    void pushBand(const DirtyRect& band) {
+        if (band.empty()) return;
+        pushRect(band);
+        stats.lastBytes += (uint32_t)band.w * band.h * sizeof(uint16_t);
+        stats.lastRects++;
+    }
+    
+    static void onFrameTransferred(uint32_t, uint32_t transferMicros, void* context) {
+        static_cast<SpacecraftRender*>(context)->stats.lastTransferMicros = transferMicros;
+    }
+    
+    void pushRect(const DirtyRect& rect) {
+        if (dma.isReady()) {
+            dma.pushRect((const uint16_t*)sprite->getPointer(), screenWidth,
+                         rect.x, rect.y, rect.w, rect.h);
+        } else {
+            sprite->pushSprite(rect.x, rect.y, rect.x, rect.y, rect.w, rect.h);
+        }
+    }
+    
+    void pushFullFrame() {
+        pushRect(DirtyRect(0, 0, screenWidth, screenHeight));
+        stats.lastBytes = (uint32_t)screenWidth * screenHeight * sizeof(uint16_t);
+        stats.lastRects = 1;
+        stats.lastFull = true;
+    }
+    
+    // Recompute needle/readout geometry. Changed readouts mark their old and
+    // new bounds dirty, moving needles keep both footprints for the restore
+    // and push; when force is set everything is drawn straight away.
+    void updateDynamicItems(const SpacecraftState& state, bool force) {
+        const float angles[3] = {state.roll, state.pitch, state.yaw};
+        const uint16_t colors[3] = {COLOR_ROLL, COLOR_PITCH, COLOR_YAW};
         
-        drawCircularGauge(centerX, centerY, 80, state.roll, COLOR_ROLL, "ROLL");
+        for (int i = 0; i < 3; i++) {
+            NeedleItem& needle = needles[i];
+            needle.moved = DirtyRect();
+            
+            int endX, endY;
+            needleEnd(gauges[i], angles[i], endX, endY);
+            if (!force && endX == needle.endX && endY == needle.endY) continue;
+            
+            DirtyRect area = needleBounds(gauges[i], endX, endY);
+            bool hadFootprint = needle.shape[needle.current].rows > 0;
+            needle.current ^= 1;
+            bool hasFootprint = needleFootprint(gauges[i], endX, endY, needle.shape[needle.current]);
+            
+            if (force) {
+                drawNeedle(gauges[i], endX, endY, colors[i]);
+            } else if (footprintsEnabled && hadFootprint && hasFootprint) {
+                needle.moved = needle.drawn.unite(area).clip(screenWidth, screenHeight);
+            } else {
+                markDirty(needle.drawn.unite(area));
+            }
+            needle.drawn = area;
+            needle.endX = endX;
+            needle.endY = endY;
+        }
         
-        // Numeric display
-        char buf[64];
-        sprite->setTextSize(1);
-        sprite->setTextColor(COLOR_WHITE);
+        for (int i = 0; i < readoutCount; i++) {
+            char buf[24];
+            formatReadout(state, i, buf);
+            if (!force && strcmp(buf, readouts[i].text) == 0) continue;
+            
+            DirtyRect area = readoutBounds(i, buf);
+            if (force) {
+                drawReadout(i, buf, false);
+            } else if (strlen(buf) == strlen(readouts[i].text) && useGlyphs(buf)) {
+                markChangedCells(i, readouts[i].text, buf);
+            } else {
+                markDirty(readouts[i].drawn.unite(area));
+            }
+            readouts[i].drawn = area;
+            strcpy(readouts[i].text, buf);
+        }
+    }
+    
+    // After restoring, redraw every item touching a dirty rect or a moving
+    // needle (including unchanged neighbours whose pixels were restored over)
+    void redrawDynamicItems() {
+        const uint16_t colors[3] = {COLOR_ROLL, COLOR_PITCH, COLOR_YAW};
         
-        sprintf(buf, "P:%.0f Y:%.0f", state.pitch, state.yaw);
-        sprite->drawString(buf, centerX, screenHeight - 20);
+        for (int i = 0; i < 3; i++) {
+            if (!needles[i].moved.empty() || touchesDirty(needles[i].drawn)) {
+                drawNeedle(gauges[i], needles[i].endX, needles[i].endY, colors[i]);
+            }
+        }
+        for (int i = 0; i < readoutCount; i++) {
+            if (touchesDirty(readouts[i].drawn)) {
+                drawReadout(i, readouts[i].text, true);
+            }
+        }
+    }
+    
+    bool touchesDirty(const DirtyRect& rect) const {
+        for (int i = 0; i < dirtyCount; i++) {
+            if (dirty[i].intersects(rect)) return true;
+        }
+        for (int i = 0; i < 3; i++) {
+            if (needles[i].moved.intersects(rect)) return true;
+        }
+        return false;
+    }
+    
+    // ========================================================================
+    // DYNAMIC ELEMENTS
+    // ========================================================================
+    
+    void needleEnd(const GaugeSlot& gauge, float angle, int& endX, int& endY) {
+        const GaugeLod lod = selectGaugeLod(gauge.radius);
+        float pointerRad = (angle - 90) * PI / 180.0f;
+        int pointerLength = lod.needleTip ? gauge.radius - 15 : gauge.radius - (lod.majorTicks ? 6 : 2);
+        endX = gauge.cx + pointerLength * cos(pointerRad);
+        endY = gauge.cy + pointerLength * sin(pointerRad);
+    }
+    
+    DirtyRect needleBounds(const GaugeSlot& gauge, int endX, int endY) {
+        // Tip disc radius 4 plus the doubled shaft at full detail
+        int pad = selectGaugeLod(gauge.radius).needleTip ? 5 : 1;
+        int left = min(gauge.cx, endX) - pad, top = min(gauge.cy, endY) - pad;
+        int right = max(gauge.cx, endX) + pad + 1, bottom = max(gauge.cy, endY) + pad + 1;
+        return DirtyRect(left, top, right - left, bottom - top);
     }
     
-    void drawCircularGauge(int cx, int cy, int radius, float angle, uint16_t color, const char* label) {
-        // Outer circle
-        sprite->drawCircle(cx, cy, radius, COLOR_WHITE);
-        sprite->drawCircle(cx, cy, radius - 1, COLOR_WHITE);
+    // Conservative per-row extent of drawNeedle(). Bresenham keeps each
+    // shaft pixel within half a pixel of the ideal line, so a row holds the
+    // line's x range across that row plus a pixel of slack either side (and
+    // one more on the right for the doubled shaft); the tip disc adds its box.
+    bool needleFootprint(const GaugeSlot& gauge, int endX, int endY, NeedleFootprint& shape) {
+        bool tip = selectGaugeLod(gauge.radius).needleTip;
+        DirtyRect box = needleBounds(gauge, endX, endY);
+        if (box.h > NEEDLE_MAX_ROWS) {
+            shape.rows = 0;
+            return false;
+        }
         
-        // Cardinal marks (0, 90, 180, 270)
-        for (int deg = 0; deg < 360; deg += 90) {
-            float rad = (deg - 90) * PI / 180.0f;
-            int x1 = cx + (radius - 10) * cos(rad);
-            int y1 = cy + (radius - 10) * sin(rad);
-            int x2 = cx + radius * cos(rad);
-            int y2 = cy + radius * sin(rad);
-            sprite->drawLine(x1, y1, x2, y2, COLOR_WHITE);
+        int dx = endX - gauge.cx, dy = endY - gauge.cy;
+        int shaftLeft = min(gauge.cx, endX), shaftRight = max(gauge.cx, endX);
+        int shaftTop = min(gauge.cy, endY), shaftBottom = max(gauge.cy, endY);
+        shape.top = box.y;
+        shape.rows = box.h;
+        
+        for (int r = 0; r < shape.rows; r++) {
+            int y = shape.top + r;
+            int left = INT16_MAX, right = INT16_MIN;   // Inclusive while building
+            
+            if (y >= shaftTop && y <= shaftBottom) {
+                int lo = shaftLeft, hi = shaftRight;
+                if (dy != 0) {
+                    float xa = gauge.cx + dx * (y - gauge.cy - 0.5f) / dy;
+                    float xb = gauge.cx + dx * (y - gauge.cy + 0.5f) / dy;
+                    lo = max(lo, (int)floorf(min(xa, xb)));
+                    hi = min(hi, (int)ceilf(max(xa, xb)));
+                }
+                left = lo - 1;
+                right = hi + 1 + (tip ? 1 : 0);
+            }
+            if (tip && abs(y - endY) <= 4) {
+                left = min(left, endX - 4);
+                right = max(right, endX + 4);
+            }
+            
+            if (left > right) left = right = 0;
+            else right++;
+            shape.left[r] = left;
+            shape.right[r] = right;
+        }
+        return true;
+    }
+    
+    void drawNeedle(const GaugeSlot& gauge, int endX, int endY, uint16_t color) {
+        // Pointer: double line and tip at full detail, one line otherwise
+        sprite->drawLine(gauge.cx, gauge.cy, endX, endY, color);
+        if (selectGaugeLod(gauge.radius).needleTip) {
+            sprite->drawLine(gauge.cx + 1, gauge.cy, endX + 1, endY, color);
+            sprite->fillCircle(endX, endY, 4, color);
         }
+    }
+    
+    // Integer formatting: no float printf in the frame loop
+    static char* formatDegrees(char* out, float value) {
+        int rounded = (int)(value >= 0.0f ? value + 0.5f : value - 0.5f);
+        unsigned magnitude = rounded < 0 ? -rounded : rounded;
+        if (rounded < 0) *out++ = '-';
         
-        // Minor marks every 30 degrees
-        for (int deg = 0; deg < 360; deg += 30) {
-            if (deg % 90 == 0) continue;  // Skip cardinals
-            float rad = (deg - 90) * PI / 180.0f;
-            int x1 = cx + (radius - 5) * cos(rad);
-            int y1 = cy + (radius - 5) * sin(rad);
-            int x2 = cx + radius * cos(rad);
-            int y2 = cy + radius * sin(rad);
-            sprite->drawLine(x1, y1, x2, y2, COLOR_GRAY);
+        char digits[10];
+        int count = 0;
+        do {
+            digits[count++] = '0' + magnitude % 10;
+            magnitude /= 10;
+        } while (magnitude);
+        while (count) *out++ = digits[--count];
+        *out = '\0';
+        return out;
+    }
+    
+    // Buffers are readouts[].text sized
+    void formatReadout(const SpacecraftState& state, int index, char* buf) {
+        if (compact) {
+            const float values[3] = {state.roll, state.pitch, state.yaw};
+            formatDegrees(buf, values[index]);
+        } else {
+            char* p = buf;
+            *p++ = 'R'; *p++ = ':';
+            p = formatDegrees(p, state.roll);
+            *p++ = ' '; *p++ = 'P'; *p++ = ':';
+            p = formatDegrees(p, state.pitch);
+            *p++ = ' '; *p++ = 'Y'; *p++ = ':';
+            formatDegrees(p, state.yaw);
+        }
+    }
+    
+    // Numeric readouts below gauges (compact) or along the bottom (minimal)
+    void readoutAnchor(int index, int& x, int& y, int& size) {
+        if (compact) {
+            x = gauges[index].cx;
+            y = gauges[index].cy + gauges[index].radius + 20;
+            size = 2;
+        } else {
+            x = screenWidth / 2;
+            y = screenHeight - 20;
+            size = 1;
         }
+    }
+    
+    // Top-left of the first character cell (middle-centre datum)
+    void readoutOrigin(int index, const char* text, int& left, int& top, int& size) {
+        int x, y;
+        readoutAnchor(index, x, y, size);
+        left = x - (int)strlen(text) * 6 * size / 2;
+        top = y - 8 * size / 2;
+    }
+    
+    DirtyRect readoutBounds(int index, const char* text) {
+        int left, top, size;
+        readoutOrigin(index, text, left, top, size);
+        return DirtyRect(left - 2, top - 2, (int)strlen(text) * 6 * size + 4, 8 * size + 4);
+    }
+    
+    bool useGlyphs(const char* text) const {
+        return glyphCacheEnabled && glyphs.isBuilt() && glyphs.covers(text);
+    }
+    
+    // Same-length update: one dirty rect per run of changed characters
+    void markChangedCells(int index, const char* before, const char* after) {
+        int left, top, size;
+        readoutOrigin(index, after, left, top, size);
+        int cell = 6 * size;
         
-        // Pointer
-        float pointerRad = (angle - 90) * PI / 180.0f;
-        int pointerLength = radius - 15;
-        int endX = cx + pointerLength * cos(pointerRad);
-        int endY = cy + pointerLength * sin(pointerRad);
+        for (int i = 0; after[i]; ) {
+            if (after[i] == before[i]) { i++; continue; }
+            int start = i;
+            while (after[i] && after[i] != before[i]) i++;
+            markDirty(DirtyRect(left + start * cell, top, (i - start) * cell, 8 * size));
+        }
+    }
+    
+    // onlyDirty: blit just the cells touching this frame's dirty rects
+    void drawReadout(int index, const char* text, bool onlyDirty) {
+        static const uint16_t colors[3] = {COLOR_ROLL, COLOR_PITCH, COLOR_YAW};
+        int left, top, size;
+        readoutOrigin(index, text, left, top, size);
         
-        sprite->drawLine(cx, cy, endX, endY, color);
-        sprite->drawLine(cx + 1, cy, endX + 1, endY, color);
-        sprite->fillCircle(endX, endY, 4, color);
+        if (!useGlyphs(text)) {
+            int x, y;
+            readoutAnchor(index, x, y, size);
+            sprite->setTextSize(size);
+            sprite->setTextColor(compact ? colors[index] : COLOR_WHITE);
+            sprite->drawString(text, x, y);
+            return;
+        }
         
-        // Label
-        sprite->setTextColor(COLOR_WHITE);
-        sprite->setTextSize(1);
-        sprite->drawString(label, cx, cy + radius + 12);
+        uint16_t* pixels = (uint16_t*)sprite->getPointer();
+        int cell = glyphs.cellWidth();
+        for (int i = 0; text[i]; i++) {
+            int x = left + i * cell;
+            if (text[i] == ' ') continue;
+            if (onlyDirty && !touchesDirty(DirtyRect(x, top, cell, glyphs.cellHeight()))) continue;
+            stats.totalGlyphPixels += glyphs.blit(pixels, screenWidth, screenHeight, x, top,
+                                                  text[i], compact ? index : 0);
+        }
     }
     
     const char* getModeString(ControlMode mode) {
@@ -158,6 +759,7 @@ private:
             case MANUAL: return "MANUAL";
             case RATE_COMMAND: return "RATE CMD";
             case FLY_BY_WIRE: return "FLY-BY-WIRE";
+            case ATTITUDE_HOLD: return "ATT HOLD";
             default: return "UNKNOWN";
         }
     }
@@ -0,0 +1,53 @@
+/**
+ * Lock-free Snapshot Exchange
+ * Triple buffer between one producer and one consumer, typically on
+ * different cores. The producer always has a private slot to write into and
+ * the consumer always holds the newest complete slot, so neither side ever
+ * waits: a double buffer plus one spare so a publish can't land on the slot
+ * being read.
+ */
+
+#ifndef SNAPSHOT_H
+#define SNAPSHOT_H
+
+#include <atomic>
+#include <stdint.h>
+
+template <typename T>
+class TripleBuffer {
+public:
+    TripleBuffer() : writeIndex(0), middle(1), readIndex(2) {}
+
+    // Producer: fill the private slot, then publish it
+    T& writeSlot() { return slots[writeIndex]; }
+
+    void publish() {
+        writeIndex = middle.exchange(writeIndex | FRESH, std::memory_order_acq_rel) & INDEX_MASK;
+    }
+
+    void write(const T& value) {
+        slots[writeIndex] = value;
+        publish();
+    }
+
+    // Consumer: take the newest published slot; false if nothing new
+    bool update() {
+        if (!(middle.load(std::memory_order_relaxed) & FRESH)) return false;
+        readIndex = middle.exchange(readIndex, std::memory_order_acq_rel) & INDEX_MASK;
+        return true;
+    }
+
+    // Slot taken by the last update()
+    const T& read() const { return slots[readIndex]; }
+
+private:
+    static const uint32_t INDEX_MASK = 0x3;
+    static const uint32_t FRESH = 0x4;
+
+    T slots[3] = {};                // Value-initialized
+    uint32_t writeIndex;            // Producer only
+    std::atomic<uint32_t> middle;   // Exchanged slot index | FRESH
+    uint32_t readIndex;             // Consumer only
+};
+
+#endif // SNAPSHOT_H
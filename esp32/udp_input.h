@@ -0,0 +1,160 @@
+/**
+ * UDP Joystick Input - lwIP raw API
+ * Receives the desktop JoystickInputPacket stream (shared/udp_protocol.h) on
+ * the ESP32. The receive callback runs in lwIP's tcpip thread (core 0 with
+ * the rest of the WiFi stack) and validates the packet in place in the pbuf
+ * payload: no socket layer, no netconn mailbox and no intermediate buffer.
+ * Accepted packets are published through a TripleBuffer, so the physics task
+ * on core 1 picks up the newest one without locks and never blocks lwIP.
+ *
+ * Each sample carries its arrival time; the consumer measures the latency
+ * this path adds (arrival in lwIP to use in a physics tick).
+ */
+
+#ifndef UDP_INPUT_H
+#define UDP_INPUT_H
+
+#include <Arduino.h>
+#include <esp_timer.h>
+#include <lwip/pbuf.h>
+#include <lwip/udp.h>
+#include <lwip/priv/tcpip_priv.h>
+#include <atomic>
+#include "udp_protocol.h"
+#include "snapshot.h"
+
+// One accepted packet as handed to the consumer
+struct JoystickSample {
+    JoystickInputPacket packet;
+    int64_t arrivalUs;      // esp_timer time in the receive callback
+    uint32_t sequence;      // Accepted packet count, gaps = superseded packets
+};
+
+class UdpJoystickInput {
+public:
+    UdpJoystickInput() : pcb(nullptr), port(0), lastSequence(0) {}
+
+    ~UdpJoystickInput() {
+        end();
+    }
+
+    // Bind to the port on the tcpip thread; false if lwIP refused
+    bool begin(uint16_t listenPort = UDP_DEFAULT_PORT) {
+        if (pcb != nullptr) return true;
+
+        PcbCall call;
+        call.input = this;
+        call.port = listenPort;
+        tcpip_api_call(openPcb, &call.base);
+        if (call.err != ERR_OK) return false;
+
+        port = listenPort;
+        return true;
+    }
+
+    void end() {
+        if (pcb == nullptr) return;
+
+        PcbCall call;
+        call.input = this;
+        tcpip_api_call(closePcb, &call.base);
+    }
+
+    bool isRunning() const { return pcb != nullptr; }
+    uint16_t getPort() const { return port; }
+
+    // Consumer (one task): newest sample if one arrived since the last call.
+    // superseded = accepted packets overwritten before this task saw them.
+    bool poll(JoystickSample& sample, uint32_t& superseded) {
+        if (!samples.update()) return false;
+        sample = samples.read();
+        superseded = sample.sequence - lastSequence - 1;
+        lastSequence = sample.sequence;
+        return true;
+    }
+
+    // Counters (written by the tcpip thread, read anywhere)
+    uint32_t getReceived() const { return received.load(std::memory_order_relaxed); }
+    uint32_t getAccepted() const { return accepted.load(std::memory_order_relaxed); }
+    uint32_t getRejected() const { return rejected.load(std::memory_order_relaxed); }
+    uint32_t getChained() const { return chained.load(std::memory_order_relaxed); }
+
+private:
+    // tcpip_api_call() argument; base must come first
+    struct PcbCall {
+        struct tcpip_api_call_data base;
+        UdpJoystickInput* input;
+        uint16_t port;
+        err_t err;
+    };
+
+    static err_t openPcb(struct tcpip_api_call_data* data) {
+        PcbCall* call = reinterpret_cast<PcbCall*>(data);
+        udp_pcb* newPcb = udp_new();
+        if (newPcb == nullptr) {
+            call->err = ERR_MEM;
+            return call->err;
+        }
+
+        call->err = udp_bind(newPcb, IP_ANY_TYPE, call->port);
+        if (call->err != ERR_OK) {
+            udp_remove(newPcb);
+            return call->err;
+        }
+
+        udp_recv(newPcb, onReceive, call->input);
+        call->input->pcb = newPcb;
+        return ERR_OK;
+    }
+
+    static err_t closePcb(struct tcpip_api_call_data* data) {
+        PcbCall* call = reinterpret_cast<PcbCall*>(data);
+        udp_remove(call->input->pcb);
+        call->input->pcb = nullptr;
+        call->err = ERR_OK;
+        return ERR_OK;
+    }
+
+    // tcpip thread: validate straight from the pbuf, publish, free
+    static void onReceive(void* arg, udp_pcb* pcb, pbuf* p, const ip_addr_t* addr, u16_t port) {
+        UdpJoystickInput* input = static_cast<UdpJoystickInput*>(arg);
+        int64_t arrivalUs = esp_timer_get_time();
+        input->received.fetch_add(1, std::memory_order_relaxed);
+
+        // A 16-byte datagram is always one pbuf in practice; the packed
+        // struct makes the in-place read safe at any alignment
+        JoystickInputPacket assembled;
+        const JoystickInputPacket* packet = &assembled;
+        if (p->len == p->tot_len) {
+            packet = static_cast<const JoystickInputPacket*>(p->payload);
+        } else if (p->tot_len == sizeof(JoystickInputPacket)) {
+            pbuf_copy_partial(p, &assembled, sizeof(assembled), 0);
+            input->chained.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        if (validateJoystickPacket(*packet, p->tot_len) == PACKET_OK) {
+            JoystickSample& slot = input->samples.writeSlot();
+            slot.packet = *packet;
+            slot.arrivalUs = arrivalUs;
+            slot.sequence = input->accepted.fetch_add(1, std::memory_order_relaxed) + 1;
+            input->samples.publish();
+        } else {
+            input->rejected.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        pbuf_free(p);
+    }
+
+    udp_pcb* pcb;
+    uint16_t port;
+
+    TripleBuffer<JoystickSample> samples;   // tcpip thread -> consumer
+    uint32_t lastSequence;                  // Consumer only
+
+    std::atomic<uint32_t> received{0};
+    std::atomic<uint32_t> accepted{0};
+    std::atomic<uint32_t> rejected{0};
+    std::atomic<uint32_t> chained{0};       // Needed reassembly (multi-pbuf)
+};
+
+#endif // UDP_INPUT_H
@@ -0,0 +1,364 @@
+/*
+ * Spacecraft Dynamics Core
+ *
+ * Rigid-body rotation (quaternion attitude, Euler's equations) templated on
+ * the scalar type so every target runs the same code:
+ *   - double: desktop gui_app (src/main/physics.h)
+ *   - float: ESP32-S3, whose FPU is single precision only
+ *   - Fixed<16> rates with Fixed<30> quaternion: integer-only variant
+ * Rates, torques and inertia use T; the unit quaternion uses Q so fixed-point
+ * builds can keep it in Q2.30. Euler extraction is display-side and runs in
+ * whatever floating type the caller asks for.
+ *
+ * Header-only and free of platform dependencies.
+ */
+
+#ifndef DYNAMICS_H
+#define DYNAMICS_H
+
+#include "fixed_point.h"
+#include <cmath>
+#include <cstdint>
+
+const double DYNAMICS_PI = 3.14159265358979323846;
+const double DYNAMICS_DEG_TO_RAD = DYNAMICS_PI / 180.0;
+const double DYNAMICS_RAD_TO_DEG = 180.0 / DYNAMICS_PI;
+const double STANDARD_GRAVITY = 9.80665;     // m/s^2, converts Isp to exhaust velocity
+
+// ============================================================================
+// SCALAR HELPERS
+// ============================================================================
+
+// a * b in b's type (fixed-point overload in fixed_point.h keeps precision)
+template <typename R, typename Q>
+inline Q mulTo(R a, Q b) {
+    return static_cast<Q>(a) * b;
+}
+
+// Floating point: exact renormalization
+template <typename Q>
+inline void normalizeQuaternion(Q& w, Q& x, Q& y, Q& z) {
+    Q norm = std::sqrt(w*w + x*x + y*y + z*z);
+    if (norm > Q(1e-10)) {
+        w /= norm; x /= norm; y /= norm; z /= norm;
+    }
+}
+
+// Fixed point: one Newton step toward unit length (no sqrt or divide). The
+// quaternion drifts by O(dt^2) per step, well inside the step's convergence.
+template <int FracBits>
+inline void normalizeQuaternion(Fixed<FracBits>& w, Fixed<FracBits>& x,
+                                Fixed<FracBits>& y, Fixed<FracBits>& z) {
+    const Fixed<FracBits> one(1);
+    Fixed<FracBits> norm2 = w*w + x*x + y*y + z*z;
+    Fixed<FracBits> k = one + (one - norm2) * Fixed<FracBits>(0.5);
+    w *= k; x *= k; y *= k; z *= k;
+}
+
+// ============================================================================
+// QUATERNION / VECTOR
+// ============================================================================
+
+template <typename Q>
+struct BasicQuaternion {
+    Q w, x, y, z;
+
+    BasicQuaternion() : w(1), x(0), y(0), z(0) {}
+    BasicQuaternion(Q w, Q x, Q y, Q z) : w(w), x(x), y(y), z(z) {}
+
+    // Normalize quaternion
+    void normalize() {
+        normalizeQuaternion(w, x, y, z);
+    }
+
+    // Convert quaternion to rotation matrix. Doubling is t + t rather than
+    // 2 * t, and the diagonal is 1 - t - t, so no constant or intermediate
+    // leaves Q2.30's [-2, 2) range.
+    void toRotationMatrix(Q R[3][3]) const {
+        const Q one(1);
+        Q t;
+        t = y*y + z*z; R[0][0] = one - t - t;
+        t = x*y - w*z; R[0][1] = t + t;
+        t = x*z + w*y; R[0][2] = t + t;
+
+        t = x*y + w*z; R[1][0] = t + t;
+        t = x*x + z*z; R[1][1] = one - t - t;
+        t = y*z - w*x; R[1][2] = t + t;
+
+        t = x*z - w*y; R[2][0] = t + t;
+        t = y*z + w*x; R[2][1] = t + t;
+        t = x*x + y*y; R[2][2] = one - t - t;
+    }
+
+    // Extract display angles without gimbal lock, in degrees [0, 360)
+    // Projects body axes onto reference frame to get independent angles
+    template <typename Out>
+    void toEuler(Out& roll, Out& pitch, Out& yaw) const {
+        BasicQuaternion<Out> q(static_cast<Out>(w), static_cast<Out>(x),
+                               static_cast<Out>(y), static_cast<Out>(z));
+        Out R[3][3];
+        q.toRotationMatrix(R);
+
+        const Out radToDeg(DYNAMICS_RAD_TO_DEG);
+
+        // Roll: rotation of body Y-axis around body X-axis
+        roll = std::atan2(R[1][2], R[1][1]) * radToDeg;
+
+        // Pitch: angle of body X-axis from horizon (asin, limited to [-90,90])
+        Out sinPitch = -R[0][2];
+        if (sinPitch >= Out(1))
+            pitch = Out(90);
+        else if (sinPitch <= Out(-1))
+            pitch = Out(-90);
+        else
+            pitch = std::asin(sinPitch) * radToDeg;
+
+        // Yaw: rotation of body X-axis projection in ground plane
+        yaw = std::atan2(R[0][1], R[0][0]) * radToDeg;
+
+        // Wrap to [0, 360)
+        roll = std::fmod(roll + Out(360), Out(360));
+        pitch = std::fmod(pitch + Out(360), Out(360));
+        yaw = std::fmod(yaw + Out(360), Out(360));
+    }
+
+    // Integrate angular velocity (deg/s, any rate scalar R) over dt seconds
+    template <typename R>
+    void integrate(R wx, R wy, R wz, double dt) {
+        // Half-angle increments in rad, computed at quaternion precision
+        const Q step(0.5 * DYNAMICS_DEG_TO_RAD * dt);
+        Q hx = mulTo(wx, step);
+        Q hy = mulTo(wy, step);
+        Q hz = mulTo(wz, step);
+
+        // Quaternion derivative times dt
+        Q dw = -x * hx - y * hy - z * hz;
+        Q dx =  w * hx + y * hz - z * hy;
+        Q dy =  w * hy + z * hx - x * hz;
+        Q dz =  w * hz + x * hy - y * hx;
+
+        w += dw;
+        x += dx;
+        y += dy;
+        z += dz;
+
+        normalize();
+    }
+};
+
+template <typename T>
+struct BasicVec3 {
+    T x, y, z;
+
+    BasicVec3() : x(0), y(0), z(0) {}
+    BasicVec3(T x, T y, T z) : x(x), y(y), z(z) {}
+
+    BasicVec3 operator+(const BasicVec3& v) const { return BasicVec3(x + v.x, y + v.y, z + v.z); }
+    BasicVec3 operator-(const BasicVec3& v) const { return BasicVec3(x - v.x, y - v.y, z - v.z); }
+    BasicVec3 operator*(T s) const { return BasicVec3(x * s, y * s, z * s); }
+
+    T dot(const BasicVec3& v) const { return x * v.x + y * v.y + z * v.z; }
+    BasicVec3 cross(const BasicVec3& v) const {
+        return BasicVec3(y * v.z - z * v.y, z * v.x - x * v.z, x * v.y - y * v.x);
+    }
+};
+
+// ============================================================================
+// THRUSTER ACCOUNTING
+// ============================================================================
+
+/**
+ * ThrusterUsage - running totals of what the control torque cost, per axis
+ * An axis is firing when its control torque clears the same threshold that
+ * switches off passive damping. Counters are integers (microseconds and
+ * mN*m*us) whatever the scalar type: a step costs a compare and a few adds,
+ * the fixed-point build needs no float accumulator, and hours of running
+ * lose no precision.
+ */
+struct ThrusterUsage {
+    uint64_t elapsedMicros = 0;                 // Time integrated by update()
+    uint64_t onMicros[3] = {0, 0, 0};           // Time each axis was firing
+    uint64_t impulse[3] = {0, 0, 0};            // |torque| * time, mN*m*us
+    uint32_t pulses[3] = {0, 0, 0};             // Firings: from off, or reversing
+    int8_t direction[3] = {0, 0, 0};            // Sign of the last step's torque
+
+    // One update() step of dtMicros with torqueMilli (|torque| in mN*m) on axis
+    void record(int axis, int sign, uint32_t torqueMilli, uint32_t dtMicros) {
+        if (sign != 0) {
+            if (sign != direction[axis]) pulses[axis]++;
+            onMicros[axis] += dtMicros;
+            impulse[axis] += static_cast<uint64_t>(torqueMilli) * dtMicros;
+        }
+        direction[axis] = static_cast<int8_t>(sign);
+    }
+
+    // Fraction of integrated time the axis was firing, 0..1
+    double dutyCycle(int axis) const {
+        return elapsedMicros > 0 ? static_cast<double>(onMicros[axis]) / elapsedMicros : 0.0;
+    }
+
+    // Angular impulse, N*m*s
+    double axisImpulse(int axis) const { return impulse[axis] * 1e-9; }
+    double totalImpulse() const { return axisImpulse(0) + axisImpulse(1) + axisImpulse(2); }
+
+    uint32_t totalPulses() const { return pulses[0] + pulses[1] + pulses[2]; }
+
+    void reset() { *this = ThrusterUsage(); }
+};
+
+// ============================================================================
+// DYNAMICS
+// ============================================================================
+
+/**
+ * BasicDynamics - Rigid body rotation physics
+ * T: rates, torques, inertia. Q: orientation quaternion (defaults to T).
+ */
+template <typename T, typename Q = T>
+struct BasicDynamics {
+    typedef T Scalar;
+    typedef BasicVec3<T> Vec;
+    typedef BasicQuaternion<Q> Quaternion;
+
+    // Moment of inertia (kg·m²)
+    T Ixx = T(1000.0);
+    T Iyy = T(1200.0);
+    T Izz = T(800.0);
+
+    // State variables
+    Quaternion orientation;
+    Vec angularVelocity;  // deg/s
+
+    // Control and disturbance torques (N·m)
+    Vec controlTorque;
+    Vec disturbanceTorque;
+
+    // Thruster parameters (N·m)
+    T thrusterLowTorque = T(5.0);
+    T thrusterHighTorque = T(15.0);
+    T thrusterDamping = T(0.98);
+
+    // Propellant model: each axis torque comes from a thruster at
+    // thrusterMomentArm (m) burning hydrogen peroxide at thrusterIsp (s)
+    float thrusterMomentArm = 0.9f;
+    float thrusterIsp = 160.0f;
+
+    // Thruster on-time, pulses and impulse since the last reset()
+    ThrusterUsage thrusterUsage;
+
+    /**
+     * Update physics using Euler's equations of motion
+     * dt stays double so step constants are derived exactly (0.01 has no
+     * fixed-point representation); with a constant dt they fold at compile time.
+     */
+    void update(double dt) {
+        using std::abs;
+        const T degToRad(DYNAMICS_DEG_TO_RAD);
+        const T velocityStep(DYNAMICS_RAD_TO_DEG * dt);
+
+        // Convert angular velocity to rad/s
+        Vec omega = angularVelocity * degToRad;
+
+        // Calculate gyroscopic torque: ω × (I * ω)
+        Vec Iomega(Ixx * omega.x, Iyy * omega.y, Izz * omega.z);
+        Vec gyroscopicTorque = omega.cross(Iomega);
+
+        // Total torque
+        Vec totalTorque = controlTorque + disturbanceTorque - gyroscopicTorque;
+
+        // Integrate angular velocity: α = I^(-1) * T, in deg/s² times dt
+        // (scale before dividing so fixed point rounds once, at the end)
+        Vec deltaVelocity(
+            totalTorque.x * velocityStep / Ixx,
+            totalTorque.y * velocityStep / Iyy,
+            totalTorque.z * velocityStep / Izz
+        );
+        angularVelocity = angularVelocity + deltaVelocity;
+
+        // Apply damping when no control torque
+        const T threshold(0.1);
+        if (abs(controlTorque.x) < threshold) angularVelocity.x *= thrusterDamping;
+        if (abs(controlTorque.y) < threshold) angularVelocity.y *= thrusterDamping;
+        if (abs(controlTorque.z) < threshold) angularVelocity.z *= thrusterDamping;
+
+        // Account for the thrusters that fired this step
+        const uint32_t dtMicros = static_cast<uint32_t>(dt * 1e6 + 0.5);
+        thrusterUsage.elapsedMicros += dtMicros;
+        recordThruster(0, controlTorque.x, threshold, dtMicros);
+        recordThruster(1, controlTorque.y, threshold, dtMicros);
+        recordThruster(2, controlTorque.z, threshold, dtMicros);
+
+        // Integrate orientation
+        orientation.integrate(angularVelocity.x, angularVelocity.y, angularVelocity.z, dt);
+    }
+
+    /**
+     * Set control torques based on thruster commands
+     */
+    void setThrusterCommands(float rollCmd, float pitchCmd, float yawCmd, bool flyByWire) {
+        if (flyByWire) {
+            controlTorque.x = getThrustTorque(rollCmd);
+            controlTorque.y = getThrustTorque(pitchCmd);
+            controlTorque.z = getThrustTorque(yawCmd);
+        } else {
+            const T gain(0.3);
+            controlTorque.x = T(rollCmd) * gain;
+            controlTorque.y = T(pitchCmd) * gain;
+            controlTorque.z = T(yawCmd) * gain;
+        }
+    }
+
+    /**
+     * Get torque from thruster command
+     */
+    T getThrustTorque(float command) const {
+        float absCmd = std::fabs(command);
+        if (absCmd < 25.0f) return T(0);
+
+        T torque = (absCmd < 75.0f) ? thrusterLowTorque : thrusterHighTorque;
+        return (command > 0) ? torque : -torque;
+    }
+
+    /**
+     * Propellant burned since the last reset (kg): angular impulse over the
+     * moment arm is the thrusters' linear impulse, and that over the
+     * exhaust velocity Isp * g0 is the mass
+     */
+    double getPropellantUsed() const {
+        double exhaustVelocity = static_cast<double>(thrusterIsp) * STANDARD_GRAVITY;
+        return thrusterUsage.totalImpulse() / (static_cast<double>(thrusterMomentArm) * exhaustVelocity);
+    }
+
+    /**
+     * Get current Euler angles (degrees) in the caller's floating type
+     */
+    template <typename Out>
+    void getEulerAngles(Out& roll, Out& pitch, Out& yaw) const {
+        orientation.toEuler(roll, pitch, yaw);
+    }
+
+    /**
+     * Reset to initial state
+     */
+    void reset() {
+        orientation = Quaternion();
+        angularVelocity = Vec();
+        controlTorque = Vec();
+        disturbanceTorque = Vec();
+        thrusterUsage.reset();
+    }
+
+    // update()'s accounting for one axis
+    void recordThruster(int axis, T torque, T threshold, uint32_t dtMicros) {
+        using std::abs;
+        T magnitude = abs(torque);
+        if (magnitude < threshold) {
+            thrusterUsage.record(axis, 0, 0, dtMicros);
+            return;
+        }
+        uint32_t torqueMilli = static_cast<uint32_t>(static_cast<float>(magnitude) * 1000.0f + 0.5f);
+        thrusterUsage.record(axis, torque > T(0) ? 1 : -1, torqueMilli, dtMicros);
+    }
+};
+
+#endif // DYNAMICS_H
@@ -0,0 +1,81 @@
+/*
+ * Fixed-Point Scalar
+ *
+ * Signed 32-bit value with FracBits fractional bits (Q16.16 = Fixed<16>,
+ * Q2.30 = Fixed<30>). Products and quotients go through 64-bit
+ * intermediates and round to nearest. Drop-in scalar for the templated
+ * dynamics in dynamics.h; header-only and free of platform dependencies.
+ */
+
+#ifndef FIXED_POINT_H
+#define FIXED_POINT_H
+
+#include <cstdint>
+
+template <int FracBits>
+class Fixed {
+public:
+    static const int32_t ONE = static_cast<int32_t>(1) << FracBits;
+
+    Fixed() : raw(0) {}
+    explicit Fixed(int v) : raw(static_cast<int32_t>(v) << FracBits) {}
+    explicit Fixed(float v) : raw(static_cast<int32_t>(v * ONE + (v >= 0.0f ? 0.5f : -0.5f))) {}
+    explicit Fixed(double v) : raw(static_cast<int32_t>(v * ONE + (v >= 0.0 ? 0.5 : -0.5))) {}
+
+    static Fixed fromRaw(int32_t value) {
+        Fixed f;
+        f.raw = value;
+        return f;
+    }
+
+    explicit operator float() const { return static_cast<float>(raw) / ONE; }
+    explicit operator double() const { return static_cast<double>(raw) / ONE; }
+
+    Fixed operator-() const { return fromRaw(-raw); }
+    Fixed operator+(Fixed o) const { return fromRaw(raw + o.raw); }
+    Fixed operator-(Fixed o) const { return fromRaw(raw - o.raw); }
+
+    Fixed operator*(Fixed o) const {
+        int64_t product = static_cast<int64_t>(raw) * o.raw;
+        return fromRaw(static_cast<int32_t>((product + (static_cast<int64_t>(1) << (FracBits - 1))) >> FracBits));
+    }
+
+    Fixed operator/(Fixed o) const {
+        int64_t numerator = static_cast<int64_t>(raw) << FracBits;
+        int64_t half = (o.raw >= 0 ? o.raw : -o.raw) / 2;
+        numerator += ((numerator >= 0) == (o.raw >= 0)) ? half : -half;
+        return fromRaw(static_cast<int32_t>(numerator / o.raw));
+    }
+
+    Fixed& operator+=(Fixed o) { raw += o.raw; return *this; }
+    Fixed& operator-=(Fixed o) { raw -= o.raw; return *this; }
+    Fixed& operator*=(Fixed o) { return *this = *this * o; }
+    Fixed& operator/=(Fixed o) { return *this = *this / o; }
+
+    bool operator<(Fixed o) const { return raw < o.raw; }
+    bool operator>(Fixed o) const { return raw > o.raw; }
+    bool operator<=(Fixed o) const { return raw <= o.raw; }
+    bool operator>=(Fixed o) const { return raw >= o.raw; }
+    bool operator==(Fixed o) const { return raw == o.raw; }
+    bool operator!=(Fixed o) const { return raw != o.raw; }
+
+    int32_t raw;
+};
+
+typedef Fixed<16> Q16_16;
+typedef Fixed<30> Q2_30;
+
+template <int FracBits>
+inline Fixed<FracBits> abs(Fixed<FracBits> v) {
+    return v.raw < 0 ? -v : v;
+}
+
+// Product of two formats, kept in the second one's precision. Lets a Q16.16
+// rate scale a Q2.30 quaternion increment without squeezing it into Q2.30.
+template <int FracA, int FracB>
+inline Fixed<FracB> mulTo(Fixed<FracA> a, Fixed<FracB> b) {
+    int64_t product = static_cast<int64_t>(a.raw) * b.raw;
+    return Fixed<FracB>::fromRaw(static_cast<int32_t>((product + (static_cast<int64_t>(1) << (FracA - 1))) >> FracA));
+}
+
+#endif // FIXED_POINT_H
@@ -0,0 +1,62 @@
+/*
+ * Gauge Level-of-Detail Policy
+ *
+ * Shared by the desktop ImGui renderer (src/main/rendering.cpp) and the
+ * ESP32 TFT renderer (esp32/render.h) so both drop the same detail at the
+ * same on-screen size. Header-only and free of platform dependencies.
+ */
+
+#ifndef GAUGE_LOD_H
+#define GAUGE_LOD_H
+
+// Radius thresholds in pixels
+#define GAUGE_LOD_FULL_RADIUS     55.0f   // At or above: every detail
+#define GAUGE_LOD_REDUCED_RADIUS  28.0f   // At or above: cardinal ticks only
+
+enum GaugeDetail {
+    GAUGE_DETAIL_FULL,      // Face, 12 ticks, labels, caption, needle with tip disc
+    GAUGE_DETAIL_REDUCED,   // Face, 4 cardinal ticks, caption, single-primitive needle
+    GAUGE_DETAIL_MINIMAL    // Face outline and single-primitive needle
+};
+
+struct GaugeLod {
+    GaugeDetail detail;
+    int faceSegments;   // Dial tessellation where circles are meshed (ImGui)
+    bool majorTicks;    // 0/90/180/270
+    bool minorTicks;    // Every 30 degrees in between
+    bool labels;        // Cardinal labels around the dial
+    bool caption;       // Gauge name under the dial
+    bool needleTip;     // false = needle is one primitive
+};
+
+inline GaugeLod selectGaugeLod(float radius) {
+    GaugeLod lod;
+    if (radius >= GAUGE_LOD_FULL_RADIUS) {
+        lod.detail = GAUGE_DETAIL_FULL;
+        lod.faceSegments = 48;
+        lod.majorTicks = true;
+        lod.minorTicks = true;
+        lod.labels = true;
+        lod.caption = true;
+        lod.needleTip = true;
+    } else if (radius >= GAUGE_LOD_REDUCED_RADIUS) {
+        lod.detail = GAUGE_DETAIL_REDUCED;
+        lod.faceSegments = 24;
+        lod.majorTicks = true;
+        lod.minorTicks = false;
+        lod.labels = false;
+        lod.caption = true;
+        lod.needleTip = false;
+    } else {
+        lod.detail = GAUGE_DETAIL_MINIMAL;
+        lod.faceSegments = 16;
+        lod.majorTicks = false;
+        lod.minorTicks = false;
+        lod.labels = false;
+        lod.caption = false;
+        lod.needleTip = false;
+    }
+    return lod;
+}
+
+#endif // GAUGE_LOD_H
@@ -0,0 +1,262 @@
+/*
+ * Shared-Memory Input Transport for Spacecraft Attitude Control
+ *
+ * Same JoystickInputPackets as the UDP protocol, for a controller running on
+ * the same machine as the GUI (Simulink, a local joystick bridge): the
+ * producer writes into a POSIX shared-memory ring and the GUI reads it with
+ * plain loads, so neither side makes a system call per packet and a packet
+ * is visible to the reader as soon as the writer's stores are.
+ *
+ * Layout: a header and SHM_INPUT_SLOTS slots, each guarded by its own
+ * seqlock. The single writer fills slot (n % SHM_INPUT_SLOTS) for packet n
+ * and bumps `published`; a reader takes the newest slot and retries only if
+ * the writer lapped the whole ring while it was copying, so writer and
+ * reader normally touch different cache lines. Packet words are copied as
+ * relaxed atomics, so a torn read is detected rather than undefined.
+ *
+ * Waiting: readers that want to block (instead of polling once a frame) wait
+ * on `wakeWord` with a process-shared futex; the writer only makes the wake
+ * system call when `waiters` is non-zero. A futex rather than an eventfd
+ * because it lives in the segment itself and needs no descriptor passing
+ * between unrelated processes.
+ *
+ * Either side may create the segment (/dev/shm/<name>); it is left in place
+ * so both can restart independently. Linux only.
+ */
+
+#ifndef SHM_INPUT_H
+#define SHM_INPUT_H
+
+#include "udp_protocol.h"
+#include <atomic>
+#include <cerrno>
+#include <climits>
+#include <cstring>
+#include <ctime>
+#include <string>
+#include <fcntl.h>
+#include <linux/futex.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#define SHM_INPUT_DEFAULT_NAME "/mercury_input"
+
+const uint32_t SHM_INPUT_MAGIC = 0x4D53484D;     // "MHSM"
+const uint32_t SHM_INPUT_VERSION = 1;
+const uint32_t SHM_INPUT_SLOTS = 16;             // Power of two
+
+// How often a reader retries after being lapped before giving up this poll
+const int SHM_INPUT_READ_RETRIES = 4;
+
+// Words of a JoystickInputPacket, copied one atomic at a time
+const int SHM_INPUT_PACKET_WORDS = sizeof(JoystickInputPacket) / sizeof(uint32_t);
+
+// The segment is shared between processes: the atomics must not hide a lock
+static_assert(ATOMIC_LLONG_LOCK_FREE == 2 && ATOMIC_INT_LOCK_FREE == 2,
+              "shared-memory input needs lock-free 32- and 64-bit atomics");
+
+struct ShmInputSlot {
+    std::atomic<uint64_t> sequence;      // 2n+1 while packet n is written, 2n+2 once complete
+    std::atomic<uint32_t> words[SHM_INPUT_PACKET_WORDS];
+};
+
+// Writer-owned and reader-owned fields on separate cache lines
+struct ShmInputRing {
+    std::atomic<uint32_t> magic;         // Stored last by the creator
+    uint32_t version;
+    uint32_t slotCount;
+    uint32_t packetSize;
+
+    alignas(64) std::atomic<uint64_t> published;   // Packets completed so far
+    std::atomic<uint32_t> wakeWord;                // Futex word, bumped per packet
+
+    alignas(64) std::atomic<uint32_t> waiters;     // Readers blocked on wakeWord
+
+    alignas(64) ShmInputSlot slots[SHM_INPUT_SLOTS];
+};
+
+inline int shmInputFutex(std::atomic<uint32_t>* word, int op, uint32_t value,
+                         const struct timespec* timeout) {
+    return static_cast<int>(syscall(SYS_futex, reinterpret_cast<uint32_t*>(word), op, value,
+                                    timeout, nullptr, 0));
+}
+
+/*
+ * Map the ring, creating and initializing it if nobody has yet.
+ * Returns nullptr with error set on failure (including a segment written
+ * by an incompatible version).
+ */
+inline ShmInputRing* shmInputMap(const char* name, std::string& error) {
+    bool created = true;
+    int fd = shm_open(name, O_RDWR | O_CREAT | O_EXCL, 0660);
+    if (fd < 0 && errno == EEXIST) {
+        created = false;
+        fd = shm_open(name, O_RDWR, 0);
+    }
+    if (fd < 0) {
+        error = std::string("shm_open ") + name + ": " + strerror(errno);
+        return nullptr;
+    }
+
+    if (created && ftruncate(fd, sizeof(ShmInputRing)) < 0) {
+        error = std::string("ftruncate: ") + strerror(errno);
+        close(fd);
+        shm_unlink(name);
+        return nullptr;
+    }
+
+    // The creator may not have sized it yet
+    struct stat info;
+    for (int attempt = 0; !created; attempt++) {
+        if (fstat(fd, &info) < 0 || attempt == 100) {
+            error = std::string("shared memory ") + name + " was never initialized";
+            close(fd);
+            return nullptr;
+        }
+        if (static_cast<size_t>(info.st_size) >= sizeof(ShmInputRing)) break;
+        usleep(1000);
+    }
+
+    void* memory = mmap(nullptr, sizeof(ShmInputRing), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd);
+    if (memory == MAP_FAILED) {
+        error = std::string("mmap: ") + strerror(errno);
+        return nullptr;
+    }
+
+    // ftruncate zero-fills, which is every atomic's initial value
+    ShmInputRing* ring = static_cast<ShmInputRing*>(memory);
+    if (created) {
+        ring->version = SHM_INPUT_VERSION;
+        ring->slotCount = SHM_INPUT_SLOTS;
+        ring->packetSize = sizeof(JoystickInputPacket);
+        ring->magic.store(SHM_INPUT_MAGIC, std::memory_order_release);
+    } else {
+        for (int attempt = 0; ring->magic.load(std::memory_order_acquire) != SHM_INPUT_MAGIC; attempt++) {
+            if (attempt == 100) break;
+            usleep(1000);
+        }
+    }
+
+    if (ring->magic.load(std::memory_order_acquire) != SHM_INPUT_MAGIC ||
+        ring->version != SHM_INPUT_VERSION || ring->slotCount != SHM_INPUT_SLOTS ||
+        ring->packetSize != sizeof(JoystickInputPacket)) {
+        error = std::string("shared memory ") + name + " has an incompatible layout";
+        munmap(memory, sizeof(ShmInputRing));
+        return nullptr;
+    }
+    return ring;
+}
+
+inline void shmInputUnmap(ShmInputRing* ring) {
+    if (ring) munmap(ring, sizeof(ShmInputRing));
+}
+
+/*
+ * Copy out the newest complete packet and its index. False when nothing has
+ * been published, or the writer kept lapping the reader (try again next poll).
+ */
+inline bool shmInputReadLatest(const ShmInputRing* ring, JoystickInputPacket& packet, uint64_t& index) {
+    for (int attempt = 0; attempt < SHM_INPUT_READ_RETRIES; attempt++) {
+        uint64_t published = ring->published.load(std::memory_order_acquire);
+        if (published == 0) return false;
+
+        uint64_t n = published - 1;
+        const ShmInputSlot& slot = ring->slots[n & (SHM_INPUT_SLOTS - 1)];
+        uint64_t before = slot.sequence.load(std::memory_order_acquire);
+        if (before != 2 * n + 2) continue;
+
+        uint32_t words[SHM_INPUT_PACKET_WORDS];
+        for (int w = 0; w < SHM_INPUT_PACKET_WORDS; w++) {
+            words[w] = slot.words[w].load(std::memory_order_relaxed);
+        }
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (slot.sequence.load(std::memory_order_relaxed) != before) continue;
+
+        memcpy(&packet, words, sizeof(packet));
+        index = n;
+        return true;
+    }
+    return false;
+}
+
+/*
+ * Block until more than `seen` packets have been published or timeoutMs
+ * passes. Returns the published count (unchanged on timeout).
+ */
+inline uint64_t shmInputWait(ShmInputRing* ring, uint64_t seen, int timeoutMs) {
+    ring->waiters.fetch_add(1);
+    uint32_t word = ring->wakeWord.load();
+    uint64_t published = ring->published.load();
+    if (published <= seen) {
+        struct timespec timeout;
+        timeout.tv_sec = timeoutMs / 1000;
+        timeout.tv_nsec = (timeoutMs % 1000) * 1000000L;
+        shmInputFutex(&ring->wakeWord, FUTEX_WAIT, word, &timeout);
+        published = ring->published.load();
+    }
+    ring->waiters.fetch_sub(1);
+    return published;
+}
+
+/*
+ * ShmInputWriter - the producer side, one per segment. Include this header
+ * in the controller (an S-function, a joystick bridge) the way
+ * udp_protocol.h is included in UDP senders.
+ */
+class ShmInputWriter {
+public:
+    ShmInputWriter() : ring(nullptr) {}
+    ~ShmInputWriter() { close(); }
+
+    bool open(const char* name = SHM_INPUT_DEFAULT_NAME) {
+        close();
+        ring = shmInputMap(name, error);
+        return ring != nullptr;
+    }
+
+    void close() {
+        shmInputUnmap(ring);
+        ring = nullptr;
+    }
+
+    bool isOpen() const { return ring != nullptr; }
+    const std::string& getError() const { return error; }
+
+    // A few stores and, only when a reader is blocked, one futex wake
+    void publish(const JoystickInputPacket& packet) {
+        uint64_t n = ring->published.load(std::memory_order_relaxed);
+        ShmInputSlot& slot = ring->slots[n & (SHM_INPUT_SLOTS - 1)];
+
+        uint32_t words[SHM_INPUT_PACKET_WORDS];
+        memcpy(words, &packet, sizeof(words));
+
+        slot.sequence.store(2 * n + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        for (int w = 0; w < SHM_INPUT_PACKET_WORDS; w++) {
+            slot.words[w].store(words[w], std::memory_order_relaxed);
+        }
+        slot.sequence.store(2 * n + 2, std::memory_order_release);
+        ring->published.store(n + 1, std::memory_order_release);
+
+        // Pairs with shmInputWait(): either the reader sees the new word or
+        // this sees the reader's waiter count
+        ring->wakeWord.fetch_add(1);
+        if (ring->waiters.load() != 0) {
+            shmInputFutex(&ring->wakeWord, FUTEX_WAKE, INT_MAX, nullptr);
+        }
+    }
+
+    uint64_t getPublished() const { return ring ? ring->published.load(std::memory_order_relaxed) : 0; }
+
+private:
+    ShmInputWriter(const ShmInputWriter&);
+    ShmInputWriter& operator=(const ShmInputWriter&);
+
+    ShmInputRing* ring;
+    std::string error;
+};
+
+#endif // SHM_INPUT_H
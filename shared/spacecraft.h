@@ -0,0 +1,381 @@
+/*
+ * Spacecraft Simulation Core
+ *
+ * Control modes, scenarios, input routing and the fixed-step update loop
+ * shared by the desktop gui_app and the ESP32 build. Each target derives its
+ * own SpacecraftState from BasicSpacecraftState<its dynamics instantiation>,
+ * so the same code runs in double on the desktop and float or fixed point on
+ * the board:
+ *   - applyStickInputs(): joystick axes to the current mode's inputs
+ *   - applyScenario(): scenario disturbance torques
+ *   - stepSpacecraft(): one PHYSICS_TIMESTEP substep in the current mode
+ *   - stepAttitudeHold(): the ATTITUDE_HOLD autopilot's part of a substep
+ *   - publishDisplayValues(): Euler angles and rates for the gauges
+ *   - advanceSpacecraft(): accumulator loop around the two above
+ * esp32/host/physics_host checks every instantiation against the golden
+ * trace in esp32/host/golden_trace.csv.
+ *
+ * Header-only, allocation-free and free of platform dependencies.
+ */
+
+#ifndef SPACECRAFT_H
+#define SPACECRAFT_H
+
+#include "dynamics.h"
+#include <cmath>
+#include <cstdint>
+
+constexpr double PHYSICS_TIMESTEP = 0.01;  // 100 Hz physics update rate
+
+// Accumulators are float on every target; compare against the float step
+// so a 10 ms frame is exactly one substep
+constexpr float PHYSICS_TIMESTEP_F = static_cast<float>(PHYSICS_TIMESTEP);
+
+// Control modes
+enum ControlMode {
+    MANUAL,
+    RATE_COMMAND,
+    FLY_BY_WIRE,
+    ATTITUDE_HOLD       // Closed loop: holds the attitude captured on entry
+};
+
+const int CONTROL_MODE_COUNT = 4;
+
+// ATTITUDE_HOLD tuning. The outer loop turns attitude error into a rate
+// demand, the inner loop turns rate error into an angular acceleration, and
+// the thrusters realise the matching torque as one pulse per PWM frame at
+// thrusterLowTorque or thrusterHighTorque.
+constexpr float HOLD_ATTITUDE_GAIN = 0.5f;     // Rate demand (deg/s) per deg of error
+constexpr float HOLD_MAX_RATE = 5.0f;          // Rate demand limit, deg/s
+constexpr float HOLD_RATE_GAIN = 2.0f;         // deg/s^2 per deg/s of rate error
+constexpr int HOLD_PWM_FRAME = 10;             // Substeps per thruster frame (100 ms)
+
+// Mission scenarios
+enum Scenario {
+    NONE,
+    RETROFIRE,
+    TUMBLE,
+    THRUSTER_STUCK,
+    ORBITAL_DRIFT
+};
+
+template <typename D>
+struct BasicSpacecraftState {
+    typedef D Dynamics;
+
+    // Physics engine
+    Dynamics dynamics;
+
+    // Display variables (derived from dynamics)
+    float roll              = 0.0f;
+    float pitch             = 0.0f;
+    float yaw               = 0.0f;
+    float rollRate          = 0.0f;
+    float pitchRate         = 0.0f;
+    float yawRate           = 0.0f;
+
+    // Control inputs
+    ControlMode mode        = MANUAL;
+    Scenario scenario       = NONE;
+    float rollCommand       = 0.0f;
+    float pitchCommand      = 0.0f;
+    float yawCommand        = 0.0f;
+    float flyByWireRoll     = 0.0f;
+    float flyByWirePitch    = 0.0f;
+    float flyByWireYaw      = 0.0f;
+
+    // Disturbance torques
+    float disturbanceRoll   = 0.0f;
+    float disturbancePitch  = 0.0f;
+    float disturbanceYaw    = 0.0f;
+
+    // ATTITUDE_HOLD: target captured on entry, this frame's thruster pulses
+    // (level -2..2: sign times low/high) and the error they answer, in deg
+    typename Dynamics::Quaternion holdTarget;
+    bool holdEngaged        = false;
+    int holdFrameTick       = 0;
+    int holdPulseTicks[3]   = {0, 0, 0};
+    int holdPulseLevel[3]   = {0, 0, 0};
+    float holdErrorRoll     = 0.0f;
+    float holdErrorPitch    = 0.0f;
+    float holdErrorYaw      = 0.0f;
+
+    float lastUpdateTime    = 0.0f;
+    float scenarioTime      = 0.0f;
+    float physicsAccumulator = 0.0f;
+
+    // Per-vehicle disturbance RNG (rand() serializes batched updates)
+    uint32_t rngState       = 1;
+
+    // Back to rest at the origin; mode and scenario are kept
+    void reset() {
+        dynamics.reset();
+        roll = pitch = yaw = 0.0f;
+        rollRate = pitchRate = yawRate = 0.0f;
+        disturbanceRoll = disturbancePitch = disturbanceYaw = 0.0f;
+        holdEngaged = false;
+        holdErrorRoll = holdErrorPitch = holdErrorYaw = 0.0f;
+        scenarioTime = 0.0f;
+        physicsAccumulator = 0.0f;
+    }
+};
+
+// Euler extraction runs in double for double dynamics, float otherwise
+// (fixed-point quaternions convert to float)
+template <typename T> struct EulerScalar { typedef float Type; };
+template <> struct EulerScalar<double> { typedef double Type; };
+
+inline float wrapAngle(float angle) {
+    while (angle < 0.0f)    angle += 360.0f;
+    while (angle >= 360.0f) angle -= 360.0f;
+    return angle;
+}
+
+// Route stick axes to the inputs the current mode reads (rates in MANUAL,
+// rate commands in RATE_COMMAND, thruster demands in FLY_BY_WIRE; the
+// ATTITUDE_HOLD autopilot takes no stick input)
+template <typename State>
+inline void applyStickInputs(State& state, float roll, float pitch, float yaw) {
+    if (state.mode == MANUAL) {
+        state.rollRate = roll;
+        state.pitchRate = pitch;
+        state.yawRate = yaw;
+    } else if (state.mode == RATE_COMMAND) {
+        state.rollCommand = roll;
+        state.pitchCommand = pitch;
+        state.yawCommand = yaw;
+    } else if (state.mode == FLY_BY_WIRE) {
+        state.flyByWireRoll = roll;
+        state.flyByWirePitch = pitch;
+        state.flyByWireYaw = yaw;
+    }
+}
+
+// Uniform in [-1, 1), same distribution as the old (rand() % 100 - 50) / 50
+template <typename State>
+inline float randomDisturbance(State& state) {
+    uint32_t x = state.rngState;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    state.rngState = x;
+    return (static_cast<int>(x % 100) - 50) / 50.0f;
+}
+
+template <typename State>
+void applyScenario(State& state, float deltaTime) {
+    typedef typename State::Dynamics::Scalar T;
+    state.scenarioTime += deltaTime;
+
+    if (state.scenario == RETROFIRE) {
+        state.disturbanceRoll = std::sin(state.scenarioTime * 0.5f) * 4.0f +
+                               randomDisturbance(state) * 1.5f;
+        state.disturbancePitch = std::cos(state.scenarioTime * 0.7f) * 3.0f +
+                                randomDisturbance(state) * 1.0f;
+        state.disturbanceYaw = std::sin(state.scenarioTime * 0.3f) * 2.5f +
+                              randomDisturbance(state) * 1.0f;
+    } else if (state.scenario == TUMBLE) {
+        state.disturbanceRoll = randomDisturbance(state) * 15.0f;
+        state.disturbancePitch = randomDisturbance(state) * 15.0f;
+        state.disturbanceYaw = randomDisturbance(state) * 15.0f;
+    } else if (state.scenario == THRUSTER_STUCK) {
+        state.disturbanceRoll = 8.0f;
+        state.disturbancePitch = 0.0f;
+        state.disturbanceYaw = 0.0f;
+    } else if (state.scenario == ORBITAL_DRIFT) {
+        state.disturbanceRoll = randomDisturbance(state) * 2.0f;
+        state.disturbancePitch = randomDisturbance(state) * 2.0f;
+        state.disturbanceYaw = randomDisturbance(state) * 2.0f;
+    } else {
+        state.disturbanceRoll = 0.0f;
+        state.disturbancePitch = 0.0f;
+        state.disturbanceYaw = 0.0f;
+    }
+
+    state.dynamics.disturbanceTorque.x = T(state.disturbanceRoll);
+    state.dynamics.disturbanceTorque.y = T(state.disturbancePitch);
+    state.dynamics.disturbanceTorque.z = T(state.disturbanceYaw);
+}
+
+// Signed thruster torque for a pulse level (-2..2)
+template <typename D>
+inline typename D::Scalar holdThrusterTorque(const D& dynamics, int level) {
+    typedef typename D::Scalar T;
+    if (level == 0) return T(0);
+    T torque = (level == 1 || level == -1) ? dynamics.thrusterLowTorque : dynamics.thrusterHighTorque;
+    return level > 0 ? torque : -torque;
+}
+
+// Pulse for one axis: demanded torque (N*m) to a level and a width in ticks.
+// Small demands use the low thruster for a finer impulse bit; a pulse
+// shorter than half a tick rounds to none.
+template <typename D, typename E>
+inline void scheduleHoldPulse(const D& dynamics, E torque, int& ticks, int& level) {
+    E magnitude = torque < E(0) ? -torque : torque;
+    E low = static_cast<E>(dynamics.thrusterLowTorque);
+    E high = static_cast<E>(dynamics.thrusterHighTorque);
+    bool useLow = magnitude <= low;
+
+    ticks = static_cast<int>(magnitude / (useLow ? low : high) * E(HOLD_PWM_FRAME) + E(0.5));
+    if (ticks > HOLD_PWM_FRAME) ticks = HOLD_PWM_FRAME;
+    level = ticks == 0 ? 0 : (useLow ? 1 : 2) * (torque < E(0) ? -1 : 1);
+}
+
+/*
+ * ATTITUDE_HOLD: capture the current attitude on entry, then once per PWM
+ * frame turn the body-frame error quaternion (conj(target) * q, shortest
+ * way round) into per-axis torque demands and pulse widths. Every substep
+ * fires the scheduled pulses and integrates. The controller math runs in
+ * the display scalar (double on the desktop, float otherwise) so the
+ * fixed-point build shares it; all state lives in the vehicle state.
+ */
+template <typename State>
+void stepAttitudeHold(State& state) {
+    typedef typename State::Dynamics Dynamics;
+    typedef typename EulerScalar<typename Dynamics::Scalar>::Type E;
+    Dynamics& dynamics = state.dynamics;
+
+    if (!state.holdEngaged) {
+        state.holdTarget = dynamics.orientation;
+        state.holdEngaged = true;
+        state.holdFrameTick = 0;
+    }
+
+    if (state.holdFrameTick == 0) {
+        const typename Dynamics::Quaternion& t = state.holdTarget;
+        const typename Dynamics::Quaternion& q = dynamics.orientation;
+        E tw = static_cast<E>(t.w), tx = static_cast<E>(t.x);
+        E ty = static_cast<E>(t.y), tz = static_cast<E>(t.z);
+        E qw = static_cast<E>(q.w), qx = static_cast<E>(q.x);
+        E qy = static_cast<E>(q.y), qz = static_cast<E>(q.z);
+
+        E ew = tw * qw + tx * qx + ty * qy + tz * qz;
+        E scale = E(2.0 * DYNAMICS_RAD_TO_DEG) * (ew < E(0) ? E(-1) : E(1));
+        E error[3] = {
+            (tw * qx - tx * qw - ty * qz + tz * qy) * scale,
+            (tw * qy + tx * qz - ty * qw - tz * qx) * scale,
+            (tw * qz - tx * qy + ty * qx - tz * qw) * scale
+        };
+        E rate[3] = {
+            static_cast<E>(dynamics.angularVelocity.x),
+            static_cast<E>(dynamics.angularVelocity.y),
+            static_cast<E>(dynamics.angularVelocity.z)
+        };
+        E inertia[3] = {
+            static_cast<E>(dynamics.Ixx),
+            static_cast<E>(dynamics.Iyy),
+            static_cast<E>(dynamics.Izz)
+        };
+        // An unfired axis decays by thrusterDamping every substep, deg/s^2 per deg/s
+        E coastGain = (E(1) - static_cast<E>(dynamics.thrusterDamping)) / E(PHYSICS_TIMESTEP);
+
+        for (int axis = 0; axis < 3; axis++) {
+            E rateDemand = -E(HOLD_ATTITUDE_GAIN) * error[axis];
+            if (rateDemand > E(HOLD_MAX_RATE)) rateDemand = E(HOLD_MAX_RATE);
+            if (rateDemand < -E(HOLD_MAX_RATE)) rateDemand = -E(HOLD_MAX_RATE);
+
+            E acceleration = E(HOLD_RATE_GAIN) * (rateDemand - rate[axis]);
+
+            // Firing switches the passive damping off: coast when it comes
+            // closer to the demand than the thrusters could
+            E firing = acceleration;
+            E authority = static_cast<E>(dynamics.thrusterHighTorque) / inertia[axis] * E(DYNAMICS_RAD_TO_DEG);
+            if (firing > authority) firing = authority;
+            if (firing < -authority) firing = -authority;
+            E coastMiss = -coastGain * rate[axis] - acceleration;
+            E fireMiss = firing - acceleration;
+            bool coast = coastMiss * coastMiss <= fireMiss * fireMiss;
+
+            E torque = coast ? E(0) : inertia[axis] * acceleration * E(DYNAMICS_DEG_TO_RAD);
+            scheduleHoldPulse(dynamics, torque, state.holdPulseTicks[axis], state.holdPulseLevel[axis]);
+        }
+
+        state.holdErrorRoll = static_cast<float>(error[0]);
+        state.holdErrorPitch = static_cast<float>(error[1]);
+        state.holdErrorYaw = static_cast<float>(error[2]);
+    }
+
+    int tick = state.holdFrameTick;
+    dynamics.controlTorque.x = holdThrusterTorque(dynamics, tick < state.holdPulseTicks[0] ? state.holdPulseLevel[0] : 0);
+    dynamics.controlTorque.y = holdThrusterTorque(dynamics, tick < state.holdPulseTicks[1] ? state.holdPulseLevel[1] : 0);
+    dynamics.controlTorque.z = holdThrusterTorque(dynamics, tick < state.holdPulseTicks[2] ? state.holdPulseLevel[2] : 0);
+    dynamics.update(PHYSICS_TIMESTEP);
+
+    state.holdFrameTick = (tick + 1) % HOLD_PWM_FRAME;
+}
+
+// One PHYSICS_TIMESTEP substep in the current control mode
+template <typename State>
+void stepSpacecraft(State& state) {
+    typedef typename State::Dynamics::Scalar T;
+
+    // Leaving ATTITUDE_HOLD drops the target; coming back captures a new one
+    if (state.mode != ATTITUDE_HOLD) {
+        state.holdEngaged = false;
+    }
+
+    if (state.mode == MANUAL) {
+        state.dynamics.angularVelocity.x = T(state.rollRate);
+        state.dynamics.angularVelocity.y = T(state.pitchRate);
+        state.dynamics.angularVelocity.z = T(state.yawRate);
+
+        state.dynamics.orientation.integrate(
+            state.dynamics.angularVelocity.x,
+            state.dynamics.angularVelocity.y,
+            state.dynamics.angularVelocity.z,
+            PHYSICS_TIMESTEP
+        );
+    } else if (state.mode == RATE_COMMAND) {
+        state.dynamics.setThrusterCommands(
+            state.rollCommand,
+            state.pitchCommand,
+            state.yawCommand,
+            false
+        );
+        state.dynamics.update(PHYSICS_TIMESTEP);
+    } else if (state.mode == FLY_BY_WIRE) {
+        state.dynamics.setThrusterCommands(
+            state.flyByWireRoll,
+            state.flyByWirePitch,
+            state.flyByWireYaw,
+            true
+        );
+        state.dynamics.update(PHYSICS_TIMESTEP);
+    } else if (state.mode == ATTITUDE_HOLD) {
+        stepAttitudeHold(state);
+    }
+}
+
+// Refresh the display variables from the dynamics
+template <typename State>
+void publishDisplayValues(State& state) {
+    typedef typename EulerScalar<typename State::Dynamics::Scalar>::Type E;
+
+    E roll, pitch, yaw;
+    state.dynamics.getEulerAngles(roll, pitch, yaw);
+
+    state.roll = static_cast<float>(roll);
+    state.pitch = static_cast<float>(pitch);
+    state.yaw = static_cast<float>(yaw);
+    state.rollRate = static_cast<float>(state.dynamics.angularVelocity.x);
+    state.pitchRate = static_cast<float>(state.dynamics.angularVelocity.y);
+    state.yawRate = static_cast<float>(state.dynamics.angularVelocity.z);
+}
+
+// Run as many fixed substeps as deltaTime covers; returns the count
+template <typename State>
+int advanceSpacecraft(State& state, float deltaTime) {
+    int substeps = 0;
+    state.physicsAccumulator += deltaTime;
+
+    while (state.physicsAccumulator >= PHYSICS_TIMESTEP_F) {
+        stepSpacecraft(state);
+        state.physicsAccumulator -= PHYSICS_TIMESTEP_F;
+        substeps++;
+    }
+
+    publishDisplayValues(state);
+    return substeps;
+}
+
+#endif // SPACECRAFT_H
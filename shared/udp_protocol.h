@@ -2,7 +2,8 @@
  * UDP Protocol Definition for Spacecraft Attitude Control
  *
  * This file defines the communication protocol between external controllers
- * (e.g., Simulink, joystick interfaces) and the GUI application.
+ * (e.g., Simulink, joystick interfaces) and the GUI application or the ESP32
+ * board.
  *
  * Include this file in both sender and receiver implementations to ensure
  * protocol compatibility.
@@ -11,6 +12,7 @@
 #ifndef UDP_PROTOCOL_H
 #define UDP_PROTOCOL_H
 
+#include <cmath>
 #include <cstdint>
 
 // Protocol version for compatibility checking
@@ -49,4 +51,36 @@ struct JoystickInputPacket {
 static_assert(sizeof(JoystickInputPacket) == 16,
               "JoystickInputPacket must be exactly 16 bytes");
 
+// Result of validating a received datagram
+enum JoystickPacketStatus {
+    PACKET_OK,
+    PACKET_BAD_SIZE,        // Datagram length != sizeof(JoystickInputPacket)
+    PACKET_NOT_FINITE,      // NaN or infinity in an axis
+    PACKET_OUT_OF_RANGE     // |axis| > JOYSTICK_INPUT_TOLERANCE
+};
+
+/*
+ * Shared receiver-side validation: every receiver accepts exactly the same
+ * packets. Size is checked by the caller (datagram length) and passed in.
+ */
+inline JoystickPacketStatus validateJoystickPacket(const JoystickInputPacket& packet,
+                                                   size_t length) {
+    if (length != sizeof(JoystickInputPacket)) {
+        return PACKET_BAD_SIZE;
+    }
+
+    if (!std::isfinite(packet.rollInput) || !std::isfinite(packet.pitchInput) ||
+        !std::isfinite(packet.yawInput)) {
+        return PACKET_NOT_FINITE;
+    }
+
+    if (std::fabs(packet.rollInput) > JOYSTICK_INPUT_TOLERANCE ||
+        std::fabs(packet.pitchInput) > JOYSTICK_INPUT_TOLERANCE ||
+        std::fabs(packet.yawInput) > JOYSTICK_INPUT_TOLERANCE) {
+        return PACKET_OUT_OF_RANGE;
+    }
+
+    return PACKET_OK;
+}
+
 #endif // UDP_PROTOCOL_H
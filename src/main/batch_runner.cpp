@@ -0,0 +1,313 @@
+/*
+ * Headless Batch Runner
+ *
+ * Runs the shared simulation core with no window and no GL: every selected
+ * scenario in every selected control mode, driven by any input source, for
+ * a fixed stretch of simulated time. The input is polled on each 100 Hz
+ * physics substep through advanceWithInput(), and the run loop is a
+ * template over the source type, so the poll is a direct call. Each run
+ * starts from rest with the same disturbance seed; the deterministic
+ * sources (none, synthetic, replay) are reset too, so results are
+ * reproducible. Live sources (udp, shm) always run in real time: one
+ * substep per call, paced to the wall clock, so every 100 Hz packet reaches
+ * a tick.
+ * (The GUI does not do that: its substeps run back to back once per frame
+ * and see one packet per frame.)
+ *
+ * Per run: final attitude, RMS and peak body rate, peak and final attitude
+ * error (rotation angle away from the starting orientation), settling time
+ * (from the last substep outside SETTLED_ERROR_DEG or SETTLED_RATE), the
+ * thruster accounting kept by the dynamics (impulse, mean duty cycle over
+ * the three axes, pulse count, propellant burned) and the wall time per
+ * substep. MANUAL flies rates directly, so it never fires a thruster.
+ *
+ * Attitude-hold benchmark (make batch-hold): --mode hold --initial-rate 6
+ * engages ATTITUDE_HOLD on a vehicle tumbling at (6, -4, 3) deg/s and
+ * reports how long each scenario takes to settle and what it burns.
+ *
+ * Usage: ./batch_runner [--input none|synthetic|replay|udp|shm]
+ *                       [--synthetic sine|step|hold] [--amplitude A] [--replay FILE]
+ *                       [--port P] [--shm-name NAME]
+ *                       [--scenario all|none|retrofire|tumble|stuck|drift]
+ *                       [--mode all|manual|rate|fbw|hold] [--initial-rate DEG_S]
+ *                       [--duration SEC] [--seed N] [--realtime] [--csv FILE]
+ */
+
+#include "state.h"
+#include "input_sources.h"
+#include "udp_receiver.h"
+#include "shm_input_receiver.h"
+
+#include <cerrno>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+static const char* SCENARIO_NAMES[] = {"none", "retrofire", "tumble", "stuck", "drift"};
+static const char* MODE_NAMES[] = {"manual", "rate", "fbw", "hold"};
+
+// Settled: within this of the starting attitude and below this body rate
+const double SETTLED_ERROR_DEG = 1.0;
+const double SETTLED_RATE = 0.5;
+
+struct BatchConfig {
+    float duration = 60.0f;      // Simulated seconds per run
+    uint32_t seed = 1;           // Disturbance RNG seed, same for every run
+    float initialRate = 0.0f;    // Tumble at start: (r, -2r/3, r/2) deg/s
+    bool realtime = false;       // Pace substeps to the wall clock
+    const char* csvPath = nullptr;
+};
+
+struct RunResult {
+    Scenario scenario;
+    ControlMode mode;
+    int substeps = 0;
+    float finalRoll = 0.0f;
+    float finalPitch = 0.0f;
+    float finalYaw = 0.0f;
+    double rmsRate = 0.0;        // deg/s, magnitude of the body rate vector
+    double peakRate = 0.0;
+    double peakError = 0.0;      // deg from the starting orientation
+    double finalError = 0.0;
+    double settleSeconds = 0.0;  // < 0: still unsettled at the end
+    double impulse = 0.0;        // N*m*s over the three axes
+    double dutyCycle = 0.0;      // Mean over the three axes, 0..1
+    uint32_t pulses = 0;
+    double propellant = 0.0;     // kg
+    double wallSeconds = 0.0;    // Excluding real-time pacing
+};
+
+static double rateMagnitude(const SpacecraftState& state) {
+    const SpacecraftDynamics::Vec& w = state.dynamics.angularVelocity;
+    return std::sqrt(w.x * w.x + w.y * w.y + w.z * w.z);
+}
+
+// Rotation angle of the orientation quaternion; the run starts at identity
+static double attitudeError(const SpacecraftState& state) {
+    double w = std::fabs(state.dynamics.orientation.w);
+    return 2.0 * std::acos(w < 1.0 ? w : 1.0) * 180.0 / M_PI;
+}
+
+template <typename Source>
+static RunResult runOne(InputSource<Source>& input, Scenario scenario, ControlMode mode,
+                        const BatchConfig& config) {
+    RunResult result;
+    result.scenario = scenario;
+    result.mode = mode;
+
+    SpacecraftState state;
+    state.scenario = scenario;
+    state.mode = mode;
+    state.rngState = config.seed;
+    state.dynamics.angularVelocity = SpacecraftDynamics::Vec(
+        config.initialRate, -config.initialRate * 2.0 / 3.0, config.initialRate * 0.5);
+    publishDisplayValues(state);    // MANUAL flies the display rates
+    input.disconnect();
+
+    int steps = static_cast<int>(config.duration / PHYSICS_TIMESTEP + 0.5);
+    double rateSquares = 0.0;
+    int lastUnsettled = -1;
+    std::chrono::steady_clock::duration idle(0);
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+    for (int step = 0; step < steps; step++) {
+        applyScenario(state, PHYSICS_TIMESTEP_F);
+        result.substeps += advanceWithInput(input, state, PHYSICS_TIMESTEP_F);
+
+        double rate = rateMagnitude(state);
+        rateSquares += rate * rate;
+        if (rate > result.peakRate) result.peakRate = rate;
+        double error = attitudeError(state);
+        if (error > result.peakError) result.peakError = error;
+        if (error > SETTLED_ERROR_DEG || rate > SETTLED_RATE) lastUnsettled = step;
+
+        if (config.realtime) {
+            std::chrono::steady_clock::time_point sleepStart = std::chrono::steady_clock::now();
+            std::this_thread::sleep_until(start + std::chrono::microseconds(
+                static_cast<int64_t>((step + 1) * PHYSICS_TIMESTEP * 1e6)));
+            idle += std::chrono::steady_clock::now() - sleepStart;
+        }
+    }
+
+    result.wallSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start - idle).count();
+    result.finalRoll = state.roll;
+    result.finalPitch = state.pitch;
+    result.finalYaw = state.yaw;
+    result.rmsRate = steps > 0 ? std::sqrt(rateSquares / steps) : 0.0;
+    result.finalError = attitudeError(state);
+    result.settleSeconds = lastUnsettled == steps - 1 ? -1.0 : (lastUnsettled + 1) * PHYSICS_TIMESTEP;
+
+    const ThrusterUsage& usage = state.dynamics.thrusterUsage;
+    result.impulse = usage.totalImpulse();
+    result.dutyCycle = (usage.dutyCycle(0) + usage.dutyCycle(1) + usage.dutyCycle(2)) / 3.0;
+    result.pulses = usage.totalPulses();
+    result.propellant = state.dynamics.getPropellantUsed();
+    return result;
+}
+
+template <typename Source>
+static std::vector<RunResult> runMatrix(InputSource<Source>& input, const std::vector<Scenario>& scenarios,
+                                        const std::vector<ControlMode>& modes, const BatchConfig& config) {
+    std::vector<RunResult> results;
+    for (Scenario scenario : scenarios) {
+        for (ControlMode mode : modes) {
+            results.push_back(runOne(input, scenario, mode, config));
+        }
+    }
+    return results;
+}
+
+static void printResults(const std::vector<RunResult>& results) {
+    printf("%-10s %-7s %8s %8s %8s %9s %9s %9s %9s %8s %9s %6s %7s %8s %8s\n", "scenario", "mode", "roll",
+           "pitch", "yaw", "rms deg/s", "peak", "peak err", "final err", "settle s", "impulse", "duty%",
+           "pulses", "prop kg", "us/step");
+    for (const RunResult& r : results) {
+        char settle[16];
+        if (r.settleSeconds < 0.0) snprintf(settle, sizeof(settle), "-");
+        else snprintf(settle, sizeof(settle), "%.2f", r.settleSeconds);
+        printf("%-10s %-7s %8.1f %8.1f %8.1f %9.2f %9.2f %9.1f %9.1f %8s %9.1f %6.1f %7u %8.4f %8.3f\n",
+               SCENARIO_NAMES[r.scenario], MODE_NAMES[r.mode], r.finalRoll, r.finalPitch, r.finalYaw,
+               r.rmsRate, r.peakRate, r.peakError, r.finalError, settle, r.impulse,
+               r.dutyCycle * 100.0, r.pulses, r.propellant,
+               r.substeps > 0 ? r.wallSeconds * 1e6 / r.substeps : 0.0);
+    }
+}
+
+static bool writeCsv(const char* path, const std::vector<RunResult>& results) {
+    FILE* file = fopen(path, "w");
+    if (!file) {
+        std::cerr << "Failed to write " << path << ": " << strerror(errno) << std::endl;
+        return false;
+    }
+    fprintf(file, "scenario,mode,substeps,roll,pitch,yaw,rms_rate,peak_rate,peak_error,final_error,"
+                  "settle_seconds,impulse,duty_cycle,pulses,propellant_kg,wall_seconds\n");
+    for (const RunResult& r : results) {
+        fprintf(file, "%s,%s,%d,%.4f,%.4f,%.4f,%.6f,%.6f,%.6f,%.6f,%.2f,%.6f,%.6f,%u,%.6f,%.6f\n",
+                SCENARIO_NAMES[r.scenario], MODE_NAMES[r.mode], r.substeps, r.finalRoll,
+                r.finalPitch, r.finalYaw, r.rmsRate, r.peakRate, r.peakError, r.finalError,
+                r.settleSeconds, r.impulse, r.dutyCycle, r.pulses, r.propellant, r.wallSeconds);
+    }
+    fclose(file);
+    return true;
+}
+
+// "all" or one name out of names[0..count)
+template <typename Enum>
+static bool parseSelection(const char* name, const char* const* names, int count, std::vector<Enum>& out) {
+    out.clear();
+    for (int i = 0; i < count; i++) {
+        if (strcmp(name, "all") == 0 || strcmp(name, names[i]) == 0) {
+            out.push_back(static_cast<Enum>(i));
+        }
+    }
+    return !out.empty();
+}
+
+template <typename Source>
+static int runAndReport(InputSource<Source>& input, const std::vector<Scenario>& scenarios,
+                        const std::vector<ControlMode>& modes, const BatchConfig& config) {
+    char description[128];
+    input.describe(description, sizeof(description));
+    printf("%zu runs of %.1f s simulated, input: %s, seed %u, initial rate %.1f deg/s%s\n\n",
+           scenarios.size() * modes.size(), config.duration, description, config.seed,
+           config.initialRate, config.realtime ? ", real time" : "");
+
+    std::vector<RunResult> results = runMatrix(input, scenarios, modes, config);
+    printResults(results);
+    if (config.csvPath && !writeCsv(config.csvPath, results)) {
+        return 1;
+    }
+    return 0;
+}
+
+int main(int argc, char* argv[]) {
+    const char* inputName = "synthetic";
+    SyntheticPattern pattern = SYNTHETIC_SINE;
+    float amplitude = 50.0f;
+    const char* replayPath = nullptr;
+    int port = UDP_DEFAULT_PORT;
+    const char* shmName = SHM_INPUT_DEFAULT_NAME;
+    std::vector<Scenario> scenarios;
+    std::vector<ControlMode> modes;
+    parseSelection("all", SCENARIO_NAMES, 5, scenarios);
+    parseSelection("all", MODE_NAMES, CONTROL_MODE_COUNT, modes);
+    BatchConfig config;
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--input") == 0 && i + 1 < argc) {
+            inputName = argv[++i];
+        } else if (strcmp(argv[i], "--synthetic") == 0 && i + 1 < argc &&
+                   parseSyntheticPattern(argv[i + 1], pattern)) {
+            i++;
+        } else if (strcmp(argv[i], "--amplitude") == 0 && i + 1 < argc) {
+            amplitude = static_cast<float>(atof(argv[++i]));
+        } else if (strcmp(argv[i], "--replay") == 0 && i + 1 < argc) {
+            replayPath = argv[++i];
+        } else if (strcmp(argv[i], "--port") == 0 && i + 1 < argc) {
+            port = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--shm-name") == 0 && i + 1 < argc) {
+            shmName = argv[++i];
+        } else if (strcmp(argv[i], "--scenario") == 0 && i + 1 < argc &&
+                   parseSelection(argv[i + 1], SCENARIO_NAMES, 5, scenarios)) {
+            i++;
+        } else if (strcmp(argv[i], "--mode") == 0 && i + 1 < argc &&
+                   parseSelection(argv[i + 1], MODE_NAMES, CONTROL_MODE_COUNT, modes)) {
+            i++;
+        } else if (strcmp(argv[i], "--initial-rate") == 0 && i + 1 < argc) {
+            config.initialRate = static_cast<float>(atof(argv[++i]));
+        } else if (strcmp(argv[i], "--duration") == 0 && i + 1 < argc) {
+            config.duration = static_cast<float>(atof(argv[++i]));
+        } else if (strcmp(argv[i], "--seed") == 0 && i + 1 < argc) {
+            config.seed = static_cast<uint32_t>(strtoul(argv[++i], nullptr, 10));
+        } else if (strcmp(argv[i], "--realtime") == 0) {
+            config.realtime = true;
+        } else if (strcmp(argv[i], "--csv") == 0 && i + 1 < argc) {
+            config.csvPath = argv[++i];
+        } else {
+            std::cerr << "Usage: " << argv[0] << " [--input none|synthetic|replay|udp|shm]"
+                      << " [--synthetic sine|step|hold] [--amplitude A] [--replay FILE]"
+                      << " [--port P] [--shm-name NAME]"
+                      << " [--scenario all|none|retrofire|tumble|stuck|drift]"
+                      << " [--mode all|manual|rate|fbw|hold] [--initial-rate DEG_S]"
+                      << " [--duration SEC] [--seed N]"
+                      << " [--realtime] [--csv FILE]" << std::endl;
+            return 1;
+        }
+    }
+    if (config.seed == 0) config.seed = 1;  // xorshift never leaves zero
+
+    if (strcmp(inputName, "none") == 0) {
+        NullInput input;
+        return runAndReport(input, scenarios, modes, config);
+    } else if (strcmp(inputName, "synthetic") == 0) {
+        SyntheticInput input(pattern, amplitude);
+        return runAndReport(input, scenarios, modes, config);
+    } else if (strcmp(inputName, "replay") == 0) {
+        ReplayInput input;
+        if (!replayPath || !input.load(replayPath)) {
+            std::cerr << (replayPath ? input.getError() : std::string("--input replay needs --replay FILE"))
+                      << std::endl;
+            return 1;
+        }
+        return runAndReport(input, scenarios, modes, config);
+    } else if (strcmp(inputName, "udp") == 0) {
+        // A live sender sets the pace
+        UDPReceiver input(port);
+        if (!input.start()) return 1;
+        config.realtime = true;
+        return runAndReport(input, scenarios, modes, config);
+    } else if (strcmp(inputName, "shm") == 0) {
+        ShmInputReceiver input(shmName);
+        if (!input.start()) return 1;
+        config.realtime = true;
+        return runAndReport(input, scenarios, modes, config);
+    }
+
+    std::cerr << "Unknown input: " << inputName << std::endl;
+    return 1;
+}
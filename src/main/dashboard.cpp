@@ -0,0 +1,128 @@
+#include "dashboard.h"
+#include "fleet.h"
+#include "rendering.h"
+#include "instrumentation.h"
+#include "gauge_lod.h"
+#include <cmath>
+#include <cstdio>
+
+const float TILE_PADDING = 6.0f;
+
+static const char* scenarioTag(Scenario scenario) {
+    switch (scenario) {
+        case RETROFIRE: return "RETRO";
+        case TUMBLE: return "TUMBLE";
+        case THRUSTER_STUCK: return "STUCK";
+        case ORBITAL_DRIFT: return "DRIFT";
+        default: return "NOMINAL";
+    }
+}
+
+static void drawVehicleTile(ImDrawList* drawList, ImVec2 origin, ImVec2 tileSize,
+                            float radius, int index, const SpacecraftState& vehicle) {
+    static const char* rollLabels[] = {"0", "90", "", "90"};
+    static const char* pitchLabels[] = {"0", "90", "180", "-90"};
+    static const char* yawLabels[] = {"0", "90", "180", "270"};
+    const ImU32 rollColor = IM_COL32(255, 165, 0, 255);
+    const ImU32 pitchColor = IM_COL32(74, 144, 226, 255);
+    const ImU32 yawColor = IM_COL32(76, 175, 80, 255);
+
+    drawList->AddRect(origin, ImVec2(origin.x + tileSize.x - 2, origin.y + tileSize.y - 2),
+                      IM_COL32(70, 70, 70, 255));
+
+    char title[32];
+    snprintf(title, sizeof(title), "#%d %s", index + 1, scenarioTag(vehicle.scenario));
+    drawList->AddText(ImVec2(origin.x + TILE_PADDING, origin.y + 2),
+                      IM_COL32(200, 200, 200, 255), title);
+
+    float span = 2.0f * radius + TILE_PADDING;
+    float centerY = origin.y + ImGui::GetTextLineHeight() + TILE_PADDING + radius;
+    ImVec2 roll(origin.x + TILE_PADDING + radius, centerY);
+    ImVec2 pitch(roll.x + span, centerY);
+    ImVec2 yaw(pitch.x + span, centerY);
+
+    // Detail drops with radius inside drawAttitudeGauge (gauge_lod.h)
+    drawAttitudeGauge(drawList, roll, radius, vehicle.roll, rollColor, "ROLL", rollLabels);
+    drawAttitudeGauge(drawList, pitch, radius, vehicle.pitch, pitchColor, "PITCH", pitchLabels);
+    drawAttitudeGauge(drawList, yaw, radius, vehicle.yaw, yawColor, "YAW", yawLabels);
+}
+
+DashboardStats drawFleetGrid(ImDrawList* drawList, const FleetSimulator& fleet,
+                             float gaugeRadius) {
+    DashboardStats stats;
+    stats.totalVehicles = fleet.size();
+    if (stats.totalVehicles == 0) return stats;
+
+    // Leave room for the caption when the LOD keeps it
+    float captionHeight = selectGaugeLod(gaugeRadius).caption ? 24.0f : 0.0f;
+    ImVec2 tileSize(3.0f * (2.0f * gaugeRadius + TILE_PADDING) + TILE_PADDING,
+                    ImGui::GetTextLineHeight() + 2.0f * gaugeRadius + 2.0f * TILE_PADDING + captionHeight);
+
+    int columns = static_cast<int>(ImGui::GetContentRegionAvail().x / tileSize.x);
+    if (columns < 1) columns = 1;
+    int rows = (stats.totalVehicles + columns - 1) / columns;
+
+    // Cull whole rows against the scrolled viewport of the child window
+    ImVec2 origin = ImGui::GetCursorScreenPos();
+    float scrollY = ImGui::GetScrollY();
+    int firstRow = static_cast<int>(scrollY / tileSize.y);
+    int lastRow = static_cast<int>(std::ceil((scrollY + ImGui::GetWindowHeight()) / tileSize.y));
+    if (lastRow > rows) lastRow = rows;
+
+    for (int row = firstRow; row < lastRow; row++) {
+        for (int col = 0; col < columns; col++) {
+            int index = row * columns + col;
+            if (index >= stats.totalVehicles) break;
+
+            ImVec2 tileOrigin(origin.x + col * tileSize.x, origin.y + row * tileSize.y);
+            drawVehicleTile(drawList, tileOrigin, tileSize, gaugeRadius, index, fleet.vehicle(index));
+            stats.visibleVehicles++;
+        }
+    }
+
+    // Reserve the full grid so the scrollbar covers culled rows too
+    ImGui::Dummy(ImVec2(columns * tileSize.x, rows * tileSize.y));
+    return stats;
+}
+
+void drawFleetDashboard(FleetSimulator& fleet, bool* open) {
+    static int fleetSize = 200;
+    static float gaugeRadius = 24.0f;
+    static int mode = RATE_COMMAND;
+
+    if (!*open) return;
+
+    ImGui::SetNextWindowPos(ImVec2(40, 60), ImGuiCond_FirstUseEver);
+    ImGui::SetNextWindowSize(ImVec2(960, 720), ImGuiCond_FirstUseEver);
+    if (ImGui::Begin("Fleet Dashboard", open)) {
+        ImGui::SetNextItemWidth(220);
+        ImGui::SliderInt("Vehicles", &fleetSize, 1, 500);
+        ImGui::SameLine();
+        ImGui::SetNextItemWidth(160);
+        ImGui::SliderFloat("Gauge radius", &gaugeRadius, 12.0f, 80.0f, "%.0f px");
+        ImGui::SameLine();
+        if (ImGui::RadioButton("Manual", mode == MANUAL)) mode = MANUAL;
+        ImGui::SameLine();
+        if (ImGui::RadioButton("Rate Cmd", mode == RATE_COMMAND)) mode = RATE_COMMAND;
+        ImGui::SameLine();
+        if (ImGui::RadioButton("FBW", mode == FLY_BY_WIRE)) mode = FLY_BY_WIRE;
+        ImGui::SameLine();
+        if (ImGui::RadioButton("Hold", mode == ATTITUDE_HOLD)) mode = ATTITUDE_HOLD;
+
+        if (fleet.size() != fleetSize) fleet.resize(fleetSize);
+        fleet.setMode(static_cast<ControlMode>(mode));
+
+        static DashboardStats lastStats;
+        ImGui::TextDisabled("Simulation %.0f us on %d workers | drawing %d of %d vehicles",
+                            fleet.getLastUpdateMicros(), fleet.getWorkerCount() + 1,
+                            lastStats.visibleVehicles, lastStats.totalVehicles);
+
+        ImGui::BeginChild("FleetGrid");
+        {
+            PROFILE_SCOPE(ZONE_FLEET_DRAW);
+            lastStats = drawFleetGrid(ImGui::GetWindowDrawList(), fleet, gaugeRadius);
+        }
+        ImGui::EndChild();
+    }
+    ImGui::End();
+}
@@ -0,0 +1,21 @@
+#ifndef DASHBOARD_H
+#define DASHBOARD_H
+
+#include <imgui.h>
+
+class FleetSimulator;
+
+// Dashboard tile geometry and per-frame culling results
+struct DashboardStats {
+    int visibleVehicles = 0;
+    int totalVehicles = 0;
+};
+
+// Draw the fleet as a scrollable grid; only rows on screen are tessellated
+DashboardStats drawFleetGrid(ImDrawList* drawList, const FleetSimulator& fleet,
+                             float gaugeRadius);
+
+// Window with fleet size/mode controls around drawFleetGrid()
+void drawFleetDashboard(FleetSimulator& fleet, bool* open);
+
+#endif // DASHBOARD_H
@@ -1,16 +1,43 @@
 #ifndef DISPLAY_H
 #define DISPLAY_H
 
+#include "input_source.h"
+#include "instrumentation.h"
+
 // Forward declaration - tells compiler SpacecraftState exists
 struct SpacecraftState;
 
-// Utility functions
-float wrapAngle(float angle);
+// Utility functions (wrapAngle() is in shared/spacecraft.h)
 float getThrustLevel(float stick);
 float clamp(float value, float min, float max);
 
 // Physics update functions
 void updateScenario(SpacecraftState& state, float deltaTime);
-void updateSpacecraft(SpacecraftState& state, float deltaTime);
+// zone: profiler zone for each substep, so fleet vehicles stay out of the
+// main vehicle's substep histogram
+void updateSpacecraft(SpacecraftState& state, float deltaTime,
+                      ProfileZone zone = ZONE_PHYSICS_SUBSTEP);
+
+// updateSpacecraft() with the input polled on every substep in simulation
+// time (advanceWithInput() plus profiling). Time-driven sources advance with
+// each substep. Live network sources are polled back to back within the
+// frame, so they are read at the frame rate; the local joystick is read
+// every 10 ms by the main loop and each substep takes the read for its tick.
+template <typename Source, typename State>
+void updateSpacecraft(State& state, float deltaTime, InputSource<Source>& input) {
+    state.physicsAccumulator += deltaTime;
+
+    while (state.physicsAccumulator >= PHYSICS_TIMESTEP_F) {
+        PROFILE_SCOPE(ZONE_PHYSICS_SUBSTEP);
+        profilerCount(COUNTER_PHYSICS_SUBSTEPS);
+
+        input.advance(PHYSICS_TIMESTEP_F);
+        applyInput(input, state);
+        stepSpacecraft(state);
+        state.physicsAccumulator -= PHYSICS_TIMESTEP_F;
+    }
+
+    publishDisplayValues(state);
+}
 
-#endif // DISPLAY_H
\ No newline at end of file
+#endif // DISPLAY_H
@@ -0,0 +1,121 @@
+#include "fleet.h"
+#include "display.h"
+#include "instrumentation.h"
+
+// Vehicles per work item; small enough to balance, large enough to amortize
+const int FLEET_CHUNK_SIZE = 16;
+
+FleetSimulator::FleetSimulator(int workerCount)
+    : generation(0), busyWorkers(0), shuttingDown(false),
+      stepDeltaTime(0.0f), nextChunk(0), lastUpdateMicros(0.0) {
+    if (workerCount <= 0) {
+        int hardwareThreads = static_cast<int>(std::thread::hardware_concurrency());
+        workerCount = (hardwareThreads > 1) ? hardwareThreads - 1 : 0;
+    }
+
+    for (int i = 0; i < workerCount; i++) {
+        workers.push_back(std::thread(&FleetSimulator::workerLoop, this));
+    }
+}
+
+FleetSimulator::~FleetSimulator() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        shuttingDown = true;
+    }
+    workReady.notify_all();
+
+    for (size_t i = 0; i < workers.size(); i++) {
+        workers[i].join();
+    }
+}
+
+void FleetSimulator::resize(int count) {
+    int previous = size();
+    ControlMode mode = vehicles.empty() ? RATE_COMMAND : vehicles[0].mode;
+    vehicles.resize(count);
+
+    static const Scenario scenarios[] = {
+        RETROFIRE, TUMBLE, THRUSTER_STUCK, ORBITAL_DRIFT, NONE
+    };
+
+    for (int i = previous; i < count; i++) {
+        SpacecraftState& vehicle = vehicles[i];
+        vehicle.mode = mode;
+        vehicle.scenario = scenarios[i % 5];
+        vehicle.rngState = 0x9E3779B9u * static_cast<uint32_t>(i + 1);
+        // Stagger scenario phase so the fleet doesn't move in lockstep
+        vehicle.scenarioTime = i * 0.37f;
+    }
+}
+
+void FleetSimulator::setMode(ControlMode mode) {
+    for (size_t i = 0; i < vehicles.size(); i++) {
+        vehicles[i].mode = mode;
+    }
+}
+
+void FleetSimulator::update(float deltaTime) {
+    uint64_t startTicks = profilerTicks();
+
+    stepDeltaTime = deltaTime;
+    nextChunk.store(0);
+
+    // Not worth waking the pool for a single chunk
+    bool parallel = !workers.empty() && size() > FLEET_CHUNK_SIZE;
+    if (parallel) {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            busyWorkers = static_cast<int>(workers.size());
+            generation++;
+        }
+        workReady.notify_all();
+    }
+
+    runChunks();
+
+    if (parallel) {
+        std::unique_lock<std::mutex> lock(mutex);
+        while (busyWorkers > 0) {
+            workDone.wait(lock);
+        }
+    }
+
+    lastUpdateMicros = profilerTicksToMicros(profilerTicks() - startTicks);
+}
+
+void FleetSimulator::runChunks() {
+    int count = size();
+    while (true) {
+        int begin = nextChunk.fetch_add(1) * FLEET_CHUNK_SIZE;
+        if (begin >= count) break;
+
+        int end = (begin + FLEET_CHUNK_SIZE < count) ? begin + FLEET_CHUNK_SIZE : count;
+        for (int i = begin; i < end; i++) {
+            updateScenario(vehicles[i], stepDeltaTime);
+            updateSpacecraft(vehicles[i], stepDeltaTime, ZONE_FLEET_SUBSTEP);
+        }
+    }
+}
+
+void FleetSimulator::workerLoop() {
+    unsigned long seenGeneration = 0;
+
+    while (true) {
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            while (!shuttingDown && generation == seenGeneration) {
+                workReady.wait(lock);
+            }
+            if (shuttingDown) return;
+            seenGeneration = generation;
+        }
+
+        runChunks();
+
+        std::lock_guard<std::mutex> lock(mutex);
+        if (--busyWorkers == 0) {
+            workDone.notify_one();
+        }
+    }
+}
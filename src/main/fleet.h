@@ -0,0 +1,56 @@
+#ifndef FLEET_H
+#define FLEET_H
+
+#include "state.h"
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+ * FleetSimulator - Many spacecraft stepped in parallel
+ * A persistent worker pool pulls fixed-size chunks of vehicles each frame;
+ * the calling thread takes chunks too, then waits for the rest to finish.
+ */
+class FleetSimulator {
+public:
+    // workerCount 0 = one worker per extra hardware thread
+    explicit FleetSimulator(int workerCount = 0);
+    ~FleetSimulator();
+
+    // Grow or shrink the fleet; new vehicles get staggered scenarios
+    void resize(int count);
+    int size() const { return static_cast<int>(vehicles.size()); }
+    const SpacecraftState& vehicle(int index) const { return vehicles[index]; }
+
+    // Control mode applied to every vehicle
+    void setMode(ControlMode mode);
+
+    // Advance every vehicle by deltaTime (blocks until all are done)
+    void update(float deltaTime);
+
+    // Wall time of the most recent update() in microseconds
+    double getLastUpdateMicros() const { return lastUpdateMicros; }
+    int getWorkerCount() const { return static_cast<int>(workers.size()); }
+
+private:
+    void workerLoop();
+    void runChunks();
+
+    std::vector<SpacecraftState> vehicles;
+
+    std::vector<std::thread> workers;
+    std::mutex mutex;
+    std::condition_variable workReady;
+    std::condition_variable workDone;
+    unsigned long generation;
+    int busyWorkers;
+    bool shuttingDown;
+
+    float stepDeltaTime;
+    std::atomic<int> nextChunk;
+    double lastUpdateMicros;
+};
+
+#endif // FLEET_H
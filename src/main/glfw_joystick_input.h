@@ -0,0 +1,219 @@
+#ifndef GLFW_JOYSTICK_INPUT_H
+#define GLFW_JOYSTICK_INPUT_H
+
+#include "input_source.h"
+#include <GLFW/glfw3.h>
+#include <cmath>
+#include <cstdio>
+
+/*
+ * Stick shaping for one axis. Deflection inside the deadzone reads zero and
+ * the rest is rescaled to start from zero at its edge, so there is no step.
+ * expo blends linear (0) into cubic (1) for finer control near centre;
+ * scale is the fraction of full command at full deflection.
+ */
+struct StickCurve {
+    float deadzone = 0.08f;
+    float expo = 0.0f;
+    float scale = 1.0f;
+    bool invert = false;
+};
+
+// Raw axis in [-1, 1] to a command in [-JOYSTICK_INPUT_MAX, JOYSTICK_INPUT_MAX]
+inline float shapeStickAxis(float value, const StickCurve& curve) {
+    float magnitude = std::fabs(value);
+    if (magnitude <= curve.deadzone || curve.deadzone >= 1.0f) {
+        return 0.0f;
+    }
+
+    float x = (magnitude - curve.deadzone) / (1.0f - curve.deadzone);
+    if (x > 1.0f) x = 1.0f;
+    x = (1.0f - curve.expo) * x + curve.expo * x * x * x;
+
+    float command = x * curve.scale * JOYSTICK_INPUT_MAX;
+    if (value < 0.0f) command = -command;
+    return curve.invert ? -command : command;
+}
+
+// Timed reads held for the substeps: 160 ms at 10 ms, several frames' worth
+const int JOYSTICK_SAMPLE_QUEUE = 16;
+
+// Curves for roll, pitch and yaw in one control mode
+struct StickProfile {
+    StickCurve axes[3];
+};
+
+/**
+ * GlfwJoystickInput - a controller plugged into this machine
+ * Standard-mapped gamepads (glfwJoystickIsGamepad) fly on the left stick
+ * for roll and pitch and the right stick for yaw; other joysticks use their
+ * first three axes. Each axis goes through the StickCurve of the current
+ * control mode: MANUAL and RATE_COMMAND want fine control near centre,
+ * FLY_BY_WIRE thresholds commands into low and high thrust (ATTITUDE_HOLD
+ * takes no stick input).
+ *
+ * GUI only, main thread only (GLFW's joystick rule). The main loop calls
+ * sample() at every PHYSICS_TIMESTEP boundary of the wall clock, including
+ * while it waits for the next frame, and each read is queued with its time.
+ * The substeps of a frame run back to back, but each one advances the
+ * source's clock and takes the newest read at or before its own end, so
+ * every 10 ms tick flies on the stick as it was at that tick.
+ */
+class GlfwJoystickInput : public InputSource<GlfwJoystickInput> {
+public:
+    explicit GlfwJoystickInput(int joystick = GLFW_JOYSTICK_1)
+        : joystick(joystick), mode(MANUAL), released(false), sequence(0),
+          clock(0.0), oldest(0), queued(0),
+          rateWindowStart(0.0), rateWindowSamples(0), sampleRate(0.0f) {
+        for (int i = 0; i < 3; i++) {
+            raw[i] = 0.0f;
+            profiles[MANUAL].axes[i].expo = 0.3f;
+            profiles[RATE_COMMAND].axes[i].expo = 0.3f;
+        }
+    }
+
+    // Curves follow the mode the GUI is in
+    void setControlMode(ControlMode controlMode) { mode = controlMode; }
+    ControlMode getControlMode() const { return mode; }
+
+    StickProfile& getProfile(ControlMode controlMode) { return profiles[controlMode]; }
+
+    // Same curve on every axis of every mode (command-line defaults)
+    void setCurve(const StickCurve& curve) {
+        for (int m = 0; m < CONTROL_MODE_COUNT; m++) {
+            for (int i = 0; i < 3; i++) profiles[m].axes[i] = curve;
+        }
+    }
+
+    // Read the device now (glfwGetTime() seconds) and queue the deflection;
+    // false with no controller. The oldest read drops off a full queue.
+    bool sample(double now) {
+        if (!readAxes()) {
+            return false;
+        }
+
+        if (queued == JOYSTICK_SAMPLE_QUEUE) {
+            oldest = (oldest + 1) % JOYSTICK_SAMPLE_QUEUE;
+            queued--;
+        }
+        StickSample& slot = samples[(oldest + queued) % JOYSTICK_SAMPLE_QUEUE];
+        slot.time = now;
+        for (int i = 0; i < 3; i++) slot.axes[i] = raw[i];
+        queued++;
+
+        rateWindowSamples++;
+        if (now - rateWindowStart >= 1.0) {
+            sampleRate = static_cast<float>(rateWindowSamples / (now - rateWindowStart));
+            rateWindowStart = now;
+            rateWindowSamples = 0;
+        }
+        return true;
+    }
+
+    // Wall time the physics has reached, before a frame's substeps;
+    // advanceSource() then moves it on by one substep at a time
+    void setClock(double physicsTime) { clock = physicsTime; }
+    void advanceSource(float deltaTime) { clock += deltaTime; }
+
+    // Newest read at or before the clock, shaped for the current mode
+    bool getLatestInput(JoystickInputPacket& packet) {
+        if (queued == 0 || !glfwJoystickPresent(joystick)) {
+            return false;
+        }
+
+        // Reads older than the one this substep takes are done with; the
+        // last one stays queued until a newer read replaces it
+        while (queued > 1 && samples[(oldest + 1) % JOYSTICK_SAMPLE_QUEUE].time <= clock) {
+            oldest = (oldest + 1) % JOYSTICK_SAMPLE_QUEUE;
+            queued--;
+        }
+        const float* axes = samples[oldest].axes;
+
+        if (released) {
+            // Take control back only from a centred stick, never mid-deflection
+            for (int i = 0; i < 3; i++) {
+                if (std::fabs(axes[i]) > profiles[mode].axes[i].deadzone) return false;
+            }
+            released = false;
+        }
+
+        const StickProfile& profile = profiles[mode];
+        packet.rollInput = shapeStickAxis(axes[0], profile.axes[0]);
+        packet.pitchInput = shapeStickAxis(axes[1], profile.axes[1]);
+        packet.yawInput = shapeStickAxis(axes[2], profile.axes[2]);
+        packet.timestamp = sequence++;
+        return true;
+    }
+
+    bool hasReceivedData() const { return !released && glfwJoystickPresent(joystick); }
+
+    // Stop steering until the stick comes back to centre
+    void reset() { released = true; }
+
+    void describeSource(char* text, size_t size) const {
+        const char* name = nullptr;
+        if (glfwJoystickPresent(joystick)) {
+            name = glfwJoystickIsGamepad(joystick) ? glfwGetGamepadName(joystick)
+                                                   : glfwGetJoystickName(joystick);
+        }
+        snprintf(text, size, "Joystick %d%s%s", joystick + 1, name ? " " : "", name ? name : "");
+    }
+
+    // Last unshaped roll, pitch, yaw deflection in [-1, 1]
+    float getRawAxis(int axis) const { return raw[axis]; }
+
+    // Device reads per second over the last second
+    float getSampleRate() const { return sampleRate; }
+
+private:
+    struct StickSample {
+        double time;
+        float axes[3];
+    };
+
+    bool readAxes() {
+        if (!glfwJoystickPresent(joystick)) {
+            return false;
+        }
+
+        if (glfwJoystickIsGamepad(joystick)) {
+            GLFWgamepadstate gamepad;
+            if (!glfwGetGamepadState(joystick, &gamepad)) {
+                return false;
+            }
+            raw[0] = gamepad.axes[GLFW_GAMEPAD_AXIS_LEFT_X];
+            raw[1] = gamepad.axes[GLFW_GAMEPAD_AXIS_LEFT_Y];
+            raw[2] = gamepad.axes[GLFW_GAMEPAD_AXIS_RIGHT_X];
+            return true;
+        }
+
+        int count = 0;
+        const float* axes = glfwGetJoystickAxes(joystick, &count);
+        if (!axes) {
+            return false;
+        }
+        for (int i = 0; i < 3; i++) {
+            raw[i] = i < count ? axes[i] : 0.0f;
+        }
+        return true;
+    }
+
+    int joystick;
+    ControlMode mode;
+    StickProfile profiles[CONTROL_MODE_COUNT];
+    float raw[3];
+    bool released;
+    uint32_t sequence;
+
+    // Timed reads not yet consumed, oldest first
+    double clock;
+    StickSample samples[JOYSTICK_SAMPLE_QUEUE];
+    int oldest;
+    int queued;
+
+    double rateWindowStart;
+    int rateWindowSamples;
+    float sampleRate;
+};
+
+#endif // GLFW_JOYSTICK_INPUT_H
@@ -0,0 +1,456 @@
+/*
+ * Headless Render Benchmark for the Mercury Attitude Indicator
+ *
+ * Renders the attitude-indicator frame into an offscreen framebuffer through
+ * an EGL surfaceless context, so it runs on CI nodes without a display or GPU
+ * (Mesa llvmpipe). Reports CPU/GPU frame time and draw-list sizes.
+ *
+ * Usage: ./headless_bench [--frames N] [--warmup N] [--size WxH]
+ *                         [--path legacy|compact|both] [--fleet N [--radius R]]
+ *                         [--png out.png] [--software]
+ */
+
+#define GL_GLEXT_PROTOTYPES 1
+#include <EGL/egl.h>
+#include <EGL/eglext.h>
+#include <GL/gl.h>
+#include <GL/glext.h>
+
+#include <imgui.h>
+#include <imgui_impl_opengl3.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <vector>
+
+#include "state.h"
+#include "display.h"
+#include "rendering.h"
+#include "fleet.h"
+#include "dashboard.h"
+
+struct FrameSample {
+    double gaugeMicros;    // drawInstrumentPanel() only
+    int gaugeVertices;
+    int gaugeIndices;
+    double buildMicros;    // NewFrame .. ImGui::Render
+    double submitMicros;   // RenderDrawData .. glFinish
+    double gpuMicros;      // GL_TIME_ELAPSED around RenderDrawData
+    int drawCalls;
+    int vertices;
+    int indices;
+};
+
+struct HeadlessContext {
+    EGLDisplay display = EGL_NO_DISPLAY;
+    EGLContext context = EGL_NO_CONTEXT;
+    GLuint framebuffer = 0;
+    GLuint colorBuffer = 0;
+};
+
+// ============================================================================
+// EGL SURFACELESS SETUP
+// ============================================================================
+
+static bool createHeadlessContext(HeadlessContext& ctx, int width, int height) {
+    PFNEGLGETPLATFORMDISPLAYEXTPROC getPlatformDisplay =
+        (PFNEGLGETPLATFORMDISPLAYEXTPROC)eglGetProcAddress("eglGetPlatformDisplayEXT");
+    if (!getPlatformDisplay) {
+        std::cerr << "EGL_EXT_platform_base not available" << std::endl;
+        return false;
+    }
+
+    ctx.display = getPlatformDisplay(EGL_PLATFORM_SURFACELESS_MESA, EGL_DEFAULT_DISPLAY, NULL);
+    EGLint major, minor;
+    if (ctx.display == EGL_NO_DISPLAY || !eglInitialize(ctx.display, &major, &minor)) {
+        std::cerr << "Failed to initialize surfaceless EGL display (0x"
+                  << std::hex << eglGetError() << std::dec << ")" << std::endl;
+        return false;
+    }
+
+    if (!eglBindAPI(EGL_OPENGL_API)) {
+        std::cerr << "Desktop OpenGL not available through EGL" << std::endl;
+        return false;
+    }
+
+    // No config and no surface: everything renders into our own FBO
+    ctx.context = eglCreateContext(ctx.display, EGL_NO_CONFIG_KHR, EGL_NO_CONTEXT, NULL);
+    if (ctx.context == EGL_NO_CONTEXT ||
+        !eglMakeCurrent(ctx.display, EGL_NO_SURFACE, EGL_NO_SURFACE, ctx.context)) {
+        std::cerr << "Failed to create surfaceless GL context (0x"
+                  << std::hex << eglGetError() << std::dec << ")" << std::endl;
+        return false;
+    }
+
+    glGenFramebuffers(1, &ctx.framebuffer);
+    glBindFramebuffer(GL_FRAMEBUFFER, ctx.framebuffer);
+    glGenRenderbuffers(1, &ctx.colorBuffer);
+    glBindRenderbuffer(GL_RENDERBUFFER, ctx.colorBuffer);
+    glRenderbufferStorage(GL_RENDERBUFFER, GL_RGBA8, width, height);
+    glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0,
+                              GL_RENDERBUFFER, ctx.colorBuffer);
+
+    if (glCheckFramebufferStatus(GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE) {
+        std::cerr << "Offscreen framebuffer incomplete" << std::endl;
+        return false;
+    }
+
+    std::cout << "Renderer: " << glGetString(GL_RENDERER)
+              << " (" << glGetString(GL_VERSION) << ")" << std::endl;
+    return true;
+}
+
+static void destroyHeadlessContext(HeadlessContext& ctx) {
+    if (ctx.framebuffer) glDeleteFramebuffers(1, &ctx.framebuffer);
+    if (ctx.colorBuffer) glDeleteRenderbuffers(1, &ctx.colorBuffer);
+    if (ctx.display != EGL_NO_DISPLAY) {
+        eglMakeCurrent(ctx.display, EGL_NO_SURFACE, EGL_NO_SURFACE, EGL_NO_CONTEXT);
+        if (ctx.context != EGL_NO_CONTEXT) eglDestroyContext(ctx.display, ctx.context);
+        eglTerminate(ctx.display);
+    }
+}
+
+// ============================================================================
+// PNG OUTPUT (uncompressed deflate, enough for golden-image diffs)
+// ============================================================================
+
+static uint32_t crc32Update(uint32_t crc, const unsigned char* data, size_t length) {
+    static uint32_t table[256];
+    static bool tableReady = false;
+    if (!tableReady) {
+        for (uint32_t n = 0; n < 256; n++) {
+            uint32_t c = n;
+            for (int k = 0; k < 8; k++) c = (c & 1) ? 0xEDB88320u ^ (c >> 1) : c >> 1;
+            table[n] = c;
+        }
+        tableReady = true;
+    }
+    crc = ~crc;
+    for (size_t i = 0; i < length; i++) crc = table[(crc ^ data[i]) & 0xFF] ^ (crc >> 8);
+    return ~crc;
+}
+
+static void putBigEndian(std::vector<unsigned char>& out, uint32_t value) {
+    out.push_back((value >> 24) & 0xFF);
+    out.push_back((value >> 16) & 0xFF);
+    out.push_back((value >> 8) & 0xFF);
+    out.push_back(value & 0xFF);
+}
+
+static void writePngChunk(FILE* file, const char* type, const std::vector<unsigned char>& data) {
+    std::vector<unsigned char> chunk;
+    putBigEndian(chunk, static_cast<uint32_t>(data.size()));
+    chunk.insert(chunk.end(), type, type + 4);
+    chunk.insert(chunk.end(), data.begin(), data.end());
+    uint32_t crc = crc32Update(0, &chunk[4], chunk.size() - 4);
+    putBigEndian(chunk, crc);
+    fwrite(&chunk[0], 1, chunk.size(), file);
+}
+
+static bool writePng(const char* path, int width, int height, const std::vector<unsigned char>& rgba) {
+    FILE* file = fopen(path, "wb");
+    if (!file) {
+        std::cerr << "Failed to open " << path << " for writing" << std::endl;
+        return false;
+    }
+
+    static const unsigned char signature[8] = {0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n'};
+    fwrite(signature, 1, sizeof(signature), file);
+
+    std::vector<unsigned char> header;
+    putBigEndian(header, width);
+    putBigEndian(header, height);
+    header.push_back(8);  // Bit depth
+    header.push_back(6);  // RGBA
+    header.push_back(0);  // Deflate
+    header.push_back(0);  // Adaptive filtering
+    header.push_back(0);  // No interlace
+    writePngChunk(file, "IHDR", header);
+
+    // Scanlines top-down with filter type 0 (GL rows are bottom-up)
+    size_t stride = static_cast<size_t>(width) * 4;
+    std::vector<unsigned char> raw;
+    raw.reserve((stride + 1) * height);
+    for (int y = height - 1; y >= 0; y--) {
+        raw.push_back(0);
+        raw.insert(raw.end(), rgba.begin() + y * stride, rgba.begin() + (y + 1) * stride);
+    }
+
+    // zlib stream made of stored blocks
+    std::vector<unsigned char> zlib;
+    zlib.push_back(0x78);
+    zlib.push_back(0x01);
+    uint32_t adlerA = 1, adlerB = 0;
+    for (size_t offset = 0; offset < raw.size(); ) {
+        size_t blockSize = std::min<size_t>(65535, raw.size() - offset);
+        bool last = (offset + blockSize == raw.size());
+        zlib.push_back(last ? 1 : 0);
+        zlib.push_back(blockSize & 0xFF);
+        zlib.push_back((blockSize >> 8) & 0xFF);
+        zlib.push_back(~blockSize & 0xFF);
+        zlib.push_back((~blockSize >> 8) & 0xFF);
+        for (size_t i = 0; i < blockSize; i++) {
+            unsigned char byte = raw[offset + i];
+            zlib.push_back(byte);
+            adlerA = (adlerA + byte) % 65521;
+            adlerB = (adlerB + adlerA) % 65521;
+        }
+        offset += blockSize;
+    }
+    putBigEndian(zlib, (adlerB << 16) | adlerA);
+    writePngChunk(file, "IDAT", zlib);
+    writePngChunk(file, "IEND", std::vector<unsigned char>());
+
+    fclose(file);
+    return true;
+}
+
+// ============================================================================
+// BENCHMARK
+// ============================================================================
+
+static double elapsedMicros(std::chrono::steady_clock::time_point start,
+                            std::chrono::steady_clock::time_point end) {
+    return std::chrono::duration<double, std::micro>(end - start).count();
+}
+
+// Benchmark settings shared by every run
+struct BenchConfig {
+    int frames = 600;
+    int warmup = 30;
+    int width = 1400;
+    int height = 900;
+    int fleetSize = 0;           // 0 = single-vehicle panel
+    float fleetRadius = 24.0f;
+};
+
+// Same window setup as main.cpp, minus the interactive controls
+static void buildFrame(SpacecraftState& state, FleetSimulator* fleet, float fleetRadius) {
+    ImGui_ImplOpenGL3_NewFrame();
+    ImGui::NewFrame();
+
+    ImGuiIO& io = ImGui::GetIO();
+    ImGui::SetNextWindowPos(ImVec2(0, 0));
+    ImGui::SetNextWindowSize(io.DisplaySize);
+    ImGui::Begin("Mercury Attitude Indicator", nullptr,
+                ImGuiWindowFlags_NoTitleBar | ImGuiWindowFlags_NoResize |
+                ImGuiWindowFlags_NoMove | ImGuiWindowFlags_NoCollapse);
+    ImGui::SetWindowFontScale(1.2f);
+    ImGui::Text("PROJECT MERCURY ATTITUDE INDICATOR");
+    ImGui::Separator();
+    if (fleet) {
+        ImGui::BeginChild("FleetGrid");
+        drawFleetGrid(ImGui::GetWindowDrawList(), *fleet, fleetRadius);
+        ImGui::EndChild();
+    } else {
+        drawInstrumentPanel(ImGui::GetWindowDrawList(), state);
+    }
+    ImGui::End();
+
+    ImGui::Render();
+}
+
+static void printStat(const char* name, std::vector<double> values) {
+    std::sort(values.begin(), values.end());
+    double sum = 0.0;
+    for (size_t i = 0; i < values.size(); i++) sum += values[i];
+    printf("  %-18s avg %9.1f  p50 %9.1f  p95 %9.1f  max %9.1f\n", name,
+           sum / values.size(), values[values.size() / 2],
+           values[(values.size() * 95) / 100], values.back());
+}
+
+static const char* pathName(GaugeDrawPath path) {
+    return path == GAUGE_PATH_LEGACY ? "legacy" : "compact";
+}
+
+// Render warmup + frames with the given gauge path and print a report
+static void runBenchmark(GaugeDrawPath path, const BenchConfig& config) {
+    ImGuiIO& io = ImGui::GetIO();
+    setGaugeDrawPath(path);
+    int frames = config.frames;
+    int warmup = config.warmup;
+    int width = config.width;
+    int height = config.height;
+
+    FleetSimulator fleet;
+    fleet.resize(config.fleetSize);
+    std::vector<double> fleetUpdate;
+
+    // Each state seeds its own disturbance RNG, so runs are repeatable
+    SpacecraftState state;
+    state.mode = FLY_BY_WIRE;
+    state.scenario = TUMBLE;
+
+    GLuint timerQuery;
+    glGenQueries(1, &timerQuery);
+
+    std::vector<FrameSample> samples;
+    samples.reserve(frames);
+
+    for (int frame = 0; frame < warmup + frames; frame++) {
+        float t = frame * io.DeltaTime;
+        state.flyByWireRoll = 80.0f * std::sin(t * 0.5f);
+        state.flyByWirePitch = 50.0f * std::sin(t * 1.0f);
+        state.flyByWireYaw = 30.0f * std::sin(t * 2.0f);
+        updateScenario(state, io.DeltaTime);
+        updateSpacecraft(state, io.DeltaTime);
+        if (config.fleetSize > 0) {
+            fleet.update(io.DeltaTime);
+            if (frame >= warmup) fleetUpdate.push_back(fleet.getLastUpdateMicros());
+        }
+
+        std::chrono::steady_clock::time_point buildStart = std::chrono::steady_clock::now();
+        buildFrame(state, config.fleetSize > 0 ? &fleet : NULL, config.fleetRadius);
+        std::chrono::steady_clock::time_point submitStart = std::chrono::steady_clock::now();
+
+        glViewport(0, 0, width, height);
+        glClearColor(0.2f, 0.2f, 0.2f, 1.0f);
+        glClear(GL_COLOR_BUFFER_BIT);
+        glBeginQuery(GL_TIME_ELAPSED, timerQuery);
+        ImGui_ImplOpenGL3_RenderDrawData(ImGui::GetDrawData());
+        glEndQuery(GL_TIME_ELAPSED);
+        glFinish();
+        std::chrono::steady_clock::time_point submitEnd = std::chrono::steady_clock::now();
+
+        GLuint64 gpuNanos = 0;
+        glGetQueryObjectui64v(timerQuery, GL_QUERY_RESULT, &gpuNanos);
+
+        if (frame < warmup) continue;
+
+        ImDrawData* drawData = ImGui::GetDrawData();
+        const GaugeDrawStats& gauges = getGaugeDrawStats();
+        FrameSample sample;
+        sample.gaugeMicros = gauges.micros;
+        sample.gaugeVertices = gauges.vertices;
+        sample.gaugeIndices = gauges.indices;
+        sample.buildMicros = elapsedMicros(buildStart, submitStart);
+        sample.submitMicros = elapsedMicros(submitStart, submitEnd);
+        sample.gpuMicros = gpuNanos / 1000.0;
+        sample.drawCalls = 0;
+        for (int i = 0; i < drawData->CmdListsCount; i++) {
+            sample.drawCalls += drawData->CmdLists[i]->CmdBuffer.Size;
+        }
+        sample.vertices = drawData->TotalVtxCount;
+        sample.indices = drawData->TotalIdxCount;
+        samples.push_back(sample);
+    }
+    glDeleteQueries(1, &timerQuery);
+
+    std::vector<double> gauge, build, submit, gpu;
+    double drawCalls = 0, vertices = 0, indices = 0, gaugeVertices = 0, gaugeIndices = 0;
+    for (size_t i = 0; i < samples.size(); i++) {
+        gauge.push_back(samples[i].gaugeMicros);
+        build.push_back(samples[i].buildMicros);
+        submit.push_back(samples[i].submitMicros);
+        gpu.push_back(samples[i].gpuMicros);
+        drawCalls += samples[i].drawCalls;
+        vertices += samples[i].vertices;
+        indices += samples[i].indices;
+        gaugeVertices += samples[i].gaugeVertices;
+        gaugeIndices += samples[i].gaugeIndices;
+    }
+
+    printf("\nHeadless render benchmark [%s gauges]: %d frames at %dx%d (%d warmup)\n",
+           pathName(path), frames, width, height, warmup);
+    if (config.fleetSize > 0) {
+        printf("Fleet: %d vehicles, radius %.0f px, %d sim threads\n",
+               config.fleetSize, config.fleetRadius, fleet.getWorkerCount() + 1);
+    }
+    printf("Times in microseconds:\n");
+    if (config.fleetSize > 0) {
+        printStat("Fleet update", fleetUpdate);
+    } else {
+        printStat("Gauge draw list", gauge);
+    }
+    printStat("CPU build", build);
+    printStat("CPU submit+finish", submit);
+    printStat("GPU (timer query)", gpu);
+    if (config.fleetSize == 0) {
+        printf("Gauges per frame: %.0f vertices, %.0f indices\n",
+               gaugeVertices / samples.size(), gaugeIndices / samples.size());
+    }
+    printf("Total per frame: %.1f draw calls, %.0f vertices, %.0f indices\n",
+           drawCalls / samples.size(), vertices / samples.size(), indices / samples.size());
+}
+
+int main(int argc, char* argv[]) {
+    BenchConfig config;
+    bool runLegacy = true;
+    bool runCompact = true;
+    const char* pngPath = NULL;
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--frames") == 0 && i + 1 < argc) {
+            config.frames = std::max(1, atoi(argv[++i]));
+        } else if (strcmp(argv[i], "--warmup") == 0 && i + 1 < argc) {
+            config.warmup = std::max(0, atoi(argv[++i]));
+        } else if (strcmp(argv[i], "--size") == 0 && i + 1 < argc) {
+            if (sscanf(argv[++i], "%dx%d", &config.width, &config.height) != 2) {
+                std::cerr << "Invalid --size, expected WxH" << std::endl;
+                return 1;
+            }
+        } else if (strcmp(argv[i], "--path") == 0 && i + 1 < argc) {
+            const char* path = argv[++i];
+            runLegacy = (strcmp(path, "legacy") == 0 || strcmp(path, "both") == 0);
+            runCompact = (strcmp(path, "compact") == 0 || strcmp(path, "both") == 0);
+        } else if (strcmp(argv[i], "--fleet") == 0 && i + 1 < argc) {
+            config.fleetSize = std::max(0, atoi(argv[++i]));
+        } else if (strcmp(argv[i], "--radius") == 0 && i + 1 < argc) {
+            config.fleetRadius = static_cast<float>(atof(argv[++i]));
+        } else if (strcmp(argv[i], "--png") == 0 && i + 1 < argc) {
+            pngPath = argv[++i];
+        } else if (strcmp(argv[i], "--software") == 0) {
+            setenv("LIBGL_ALWAYS_SOFTWARE", "1", 1);
+        } else {
+            std::cerr << "Usage: " << argv[0] << " [--frames N] [--warmup N] [--size WxH]"
+                      << " [--path legacy|compact|both] [--fleet N [--radius R]]"
+                      << " [--png out.png] [--software]" << std::endl;
+            return 1;
+        }
+    }
+
+    int width = config.width;
+    int height = config.height;
+
+    HeadlessContext ctx;
+    if (!createHeadlessContext(ctx, width, height)) {
+        destroyHeadlessContext(ctx);
+        return 1;
+    }
+
+    IMGUI_CHECKVERSION();
+    ImGui::CreateContext();
+    ImGuiIO& io = ImGui::GetIO();
+    io.IniFilename = NULL;
+    io.DisplaySize = ImVec2(static_cast<float>(width), static_cast<float>(height));
+    io.DeltaTime = 1.0f / 60.0f;
+    ImGui_ImplOpenGL3_Init("#version 130");
+    ImGui::StyleColorsDark();
+
+    // The PNG captures the final frame of the last path run
+    if (runLegacy) runBenchmark(GAUGE_PATH_LEGACY, config);
+    if (runCompact) runBenchmark(GAUGE_PATH_COMPACT, config);
+
+    int status = 0;
+    if (pngPath) {
+        std::vector<unsigned char> pixels(static_cast<size_t>(width) * height * 4);
+        glPixelStorei(GL_PACK_ALIGNMENT, 1);
+        glReadPixels(0, 0, width, height, GL_RGBA, GL_UNSIGNED_BYTE, &pixels[0]);
+        if (writePng(pngPath, width, height, pixels)) {
+            printf("Final frame written to %s\n", pngPath);
+        } else {
+            status = 1;
+        }
+    }
+
+    ImGui_ImplOpenGL3_Shutdown();
+    ImGui::DestroyContext();
+    destroyHeadlessContext(ctx);
+
+    return status;
+}
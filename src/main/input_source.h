@@ -0,0 +1,87 @@
+#ifndef INPUT_SOURCE_H
+#define INPUT_SOURCE_H
+
+#include "udp_protocol.h"
+#include "spacecraft.h"
+#include <cstddef>
+
+/**
+ * Input Source Interface
+ * Anything that hands the simulation JoystickInputPackets (UDPReceiver,
+ * ShmInputReceiver, the replay and synthetic sources in input_sources.h,
+ * GlfwJoystickInput) derives from InputSource<Self> and provides
+ *   bool getLatestInput(JoystickInputPacket& packet);  // newest valid packet
+ *   bool hasReceivedData() const;
+ *   void reset();                                       // forget the sender
+ *   void describeSource(char* text, size_t size) const; // status line
+ * and, if it keeps its own clock (replay, synthetic),
+ *   void advanceSource(float deltaTime);
+ * The calls are resolved at compile time: code that works with any source
+ * takes an InputSource<Source>& template parameter, so a per-substep poll
+ * costs an inlined call, not a virtual one.
+ */
+template <typename Source>
+class InputSource {
+public:
+    // Newest valid packet; false until the source has delivered one
+    bool poll(JoystickInputPacket& packet) { return source().getLatestInput(packet); }
+
+    bool connected() const { return source().hasReceivedData(); }
+    void disconnect() { source().reset(); }
+
+    // Move a time-driven source on by deltaTime of simulation time
+    void advance(float deltaTime) { source().advanceSource(deltaTime); }
+
+    // "UDP port 8888", "shared memory /mercury_input"
+    void describe(char* text, size_t size) const { source().describeSource(text, size); }
+
+    // Live sources run on the wall clock and ignore simulation time
+    void advanceSource(float) {}
+
+protected:
+    ~InputSource() {}
+
+private:
+    Source& source() { return static_cast<Source&>(*this); }
+    const Source& source() const { return static_cast<const Source&>(*this); }
+};
+
+// Route the newest packet, if any, to the current mode's inputs
+template <typename Source, typename State>
+inline void applyInput(InputSource<Source>& input, State& state) {
+    JoystickInputPacket packet;
+    if (input.poll(packet)) {
+        applyStickInputs(state, packet.rollInput, packet.pitchInput, packet.yawInput);
+    }
+}
+
+/*
+ * advanceSpacecraft() with the input polled on every fixed substep rather
+ * than once per call, so time-driven sources (replay, synthetic) share the
+ * physics clock. It does not make live input per tick: a live source (UDP,
+ * shm) is read only as often as the caller runs on the wall clock. The GUI
+ * runs a frame's substeps back to back, so they all see the same newest
+ * packet, one distinct packet per frame; only the batch runner's --realtime
+ * loop, one substep per call paced to 10 ms, sees every 100 Hz packet. The
+ * GUI's local joystick is the exception: its reads are queued every 10 ms
+ * with their times and it keeps a clock, so each substep gets its own.
+ * Returns the substep count.
+ */
+template <typename Source, typename State>
+int advanceWithInput(InputSource<Source>& input, State& state, float deltaTime) {
+    int substeps = 0;
+    state.physicsAccumulator += deltaTime;
+
+    while (state.physicsAccumulator >= PHYSICS_TIMESTEP_F) {
+        input.advance(PHYSICS_TIMESTEP_F);
+        applyInput(input, state);
+        stepSpacecraft(state);
+        state.physicsAccumulator -= PHYSICS_TIMESTEP_F;
+        substeps++;
+    }
+
+    publishDisplayValues(state);
+    return substeps;
+}
+
+#endif // INPUT_SOURCE_H
@@ -0,0 +1,164 @@
+#include "input_sources.h"
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+
+void NullInput::describeSource(char* text, size_t size) const {
+    snprintf(text, size, "no input");
+}
+
+// ============================================================================
+// SYNTHETIC
+// ============================================================================
+
+static const char* SYNTHETIC_PATTERN_NAMES[] = {"sine", "step", "hold"};
+
+const char* syntheticPatternName(SyntheticPattern pattern) {
+    return SYNTHETIC_PATTERN_NAMES[pattern];
+}
+
+bool parseSyntheticPattern(const char* name, SyntheticPattern& pattern) {
+    for (int i = 0; i <= SYNTHETIC_HOLD; i++) {
+        if (strcmp(name, SYNTHETIC_PATTERN_NAMES[i]) == 0) {
+            pattern = static_cast<SyntheticPattern>(i);
+            return true;
+        }
+    }
+    return false;
+}
+
+SyntheticInput::SyntheticInput(SyntheticPattern pattern, float amplitude, float period)
+    : pattern(pattern), amplitude(amplitude), period(period > 0.0f ? period : 1.0f),
+      time(0.0f), sequence(0) {}
+
+bool SyntheticInput::getLatestInput(JoystickInputPacket& packet) {
+    float roll = 0.0f, pitch = 0.0f, yaw = 0.0f;
+
+    switch (pattern) {
+        case SYNTHETIC_SINE:
+            roll = amplitude * std::sin(time * 0.5f);
+            pitch = amplitude * std::sin(time * 1.0f);
+            yaw = amplitude * std::sin(time * 2.0f);
+            break;
+
+        case SYNTHETIC_STEP: {
+            // roll +, roll -, pitch +, pitch -, yaw +, yaw -, then again
+            int slot = static_cast<int>(time / period) % 6;
+            float value = (slot % 2 == 0) ? amplitude : -amplitude;
+            if (slot / 2 == 0) roll = value;
+            else if (slot / 2 == 1) pitch = value;
+            else yaw = value;
+            break;
+        }
+
+        case SYNTHETIC_HOLD:
+            roll = pitch = yaw = amplitude;
+            break;
+    }
+
+    packet.rollInput = roll;
+    packet.pitchInput = pitch;
+    packet.yawInput = yaw;
+    packet.timestamp = sequence++;
+    return true;
+}
+
+void SyntheticInput::describeSource(char* text, size_t size) const {
+    snprintf(text, size, "synthetic %s %.0f", syntheticPatternName(pattern), amplitude);
+}
+
+// ============================================================================
+// REPLAY
+// ============================================================================
+
+ReplayInput::ReplayInput() : cursor(0), time(0.0f), loop(false) {}
+
+bool ReplayInput::load(const std::string& filePath) {
+    samples.clear();
+    reset();
+    path = filePath;
+    error.clear();
+
+    std::ifstream file(filePath.c_str());
+    if (!file) {
+        error = "cannot open " + filePath;
+        return false;
+    }
+
+    std::string line;
+    int lineNumber = 0;
+    while (std::getline(file, line)) {
+        lineNumber++;
+        if (line.empty() || line[0] == '#') continue;
+
+        Sample sample;
+        char extra;
+        if (sscanf(line.c_str(), "%f,%f,%f,%f %c", &sample.time, &sample.roll,
+                   &sample.pitch, &sample.yaw, &extra) != 4) {
+            // A header is the only non-numeric line allowed
+            if (lineNumber == 1) continue;
+            std::ostringstream message;
+            message << filePath << ":" << lineNumber << ": expected time,roll,pitch,yaw";
+            error = message.str();
+            samples.clear();
+            return false;
+        }
+
+        JoystickInputPacket packet;
+        packet.rollInput = sample.roll;
+        packet.pitchInput = sample.pitch;
+        packet.yawInput = sample.yaw;
+        packet.timestamp = 0;
+        bool ordered = samples.empty() || sample.time >= samples.back().time;
+        if (!std::isfinite(sample.time) || !ordered ||
+            validateJoystickPacket(packet, sizeof(packet)) != PACKET_OK) {
+            std::ostringstream message;
+            message << filePath << ":" << lineNumber
+                    << (ordered ? ": sample out of range" : ": time goes backwards");
+            error = message.str();
+            samples.clear();
+            return false;
+        }
+        samples.push_back(sample);
+    }
+
+    if (samples.empty()) {
+        error = filePath + ": no samples";
+        return false;
+    }
+    return true;
+}
+
+void ReplayInput::advanceSource(float deltaTime) {
+    if (samples.empty()) return;
+
+    time += deltaTime;
+    if (loop && time > getDuration()) {
+        // Wrap onto the next lap; a zero-length file just holds its sample
+        float duration = getDuration();
+        time = duration > 0.0f ? std::fmod(time, duration) : 0.0f;
+        cursor = 0;
+    }
+    while (cursor < samples.size() && samples[cursor].time <= time) {
+        cursor++;
+    }
+}
+
+bool ReplayInput::getLatestInput(JoystickInputPacket& packet) {
+    if (cursor == 0) {
+        return false;
+    }
+
+    const Sample& sample = samples[cursor - 1];
+    packet.rollInput = sample.roll;
+    packet.pitchInput = sample.pitch;
+    packet.yawInput = sample.yaw;
+    packet.timestamp = static_cast<uint32_t>(cursor - 1);
+    return true;
+}
+
+void ReplayInput::describeSource(char* text, size_t size) const {
+    snprintf(text, size, "replay %s (%.1f / %.1f s)", path.c_str(), time, getDuration());
+}
@@ -0,0 +1,93 @@
+#ifndef INPUT_SOURCES_H
+#define INPUT_SOURCES_H
+
+#include "input_source.h"
+#include <string>
+#include <vector>
+
+/**
+ * Input Sources Without a Sender
+ * Deterministic sources for the headless batch runner and for driving the
+ * GUI without a controller attached. Both run on simulation time
+ * (advanceSource), so a run is reproducible whatever the frame rate.
+ */
+
+// No input at all: the scenario alone drives the vehicle
+class NullInput : public InputSource<NullInput> {
+public:
+    bool getLatestInput(JoystickInputPacket&) { return false; }
+    bool hasReceivedData() const { return false; }
+    void reset() {}
+    void describeSource(char* text, size_t size) const;
+};
+
+// Generated stick patterns
+enum SyntheticPattern {
+    SYNTHETIC_SINE,     // Slow roll, medium pitch, fast yaw sinusoids (test_udp_sender's)
+    SYNTHETIC_STEP,     // +/- amplitude on one axis at a time, switching every period
+    SYNTHETIC_HOLD      // Constant amplitude on all three axes
+};
+
+const char* syntheticPatternName(SyntheticPattern pattern);
+bool parseSyntheticPattern(const char* name, SyntheticPattern& pattern);
+
+class SyntheticInput : public InputSource<SyntheticInput> {
+public:
+    explicit SyntheticInput(SyntheticPattern pattern = SYNTHETIC_SINE, float amplitude = 50.0f,
+                            float period = 5.0f);
+
+    bool getLatestInput(JoystickInputPacket& packet);
+    bool hasReceivedData() const { return true; }
+    void reset() { time = 0.0f; sequence = 0; }
+    void advanceSource(float deltaTime) { time += deltaTime; }
+    void describeSource(char* text, size_t size) const;
+
+private:
+    SyntheticPattern pattern;
+    float amplitude;
+    float period;
+    float time;
+    uint32_t sequence;
+};
+
+/*
+ * ReplayInput - plays back a CSV of stick samples on simulation time:
+ *   time,roll,pitch,yaw      (header line optional, '#' lines ignored)
+ * Times in seconds, ascending; each sample holds until the next one.
+ * Samples that fail validateJoystickPacket() are rejected at load.
+ */
+class ReplayInput : public InputSource<ReplayInput> {
+public:
+    ReplayInput();
+
+    // Replaces any loaded samples; false with getError() set on failure
+    bool load(const std::string& path);
+    const std::string& getError() const { return error; }
+    size_t getSampleCount() const { return samples.size(); }
+    float getDuration() const { return samples.empty() ? 0.0f : samples.back().time; }
+
+    // Start over from the first sample when the file runs out
+    void setLoop(bool enabled) { loop = enabled; }
+    bool isFinished() const { return !loop && !samples.empty() && time > getDuration(); }
+
+    bool getLatestInput(JoystickInputPacket& packet);
+    bool hasReceivedData() const { return cursor > 0; }
+    void reset() { time = 0.0f; cursor = 0; }
+    void advanceSource(float deltaTime);
+    void describeSource(char* text, size_t size) const;
+
+private:
+    struct Sample {
+        float time;
+        float roll, pitch, yaw;
+    };
+
+    std::string path;
+    std::string error;
+    std::vector<Sample> samples;
+    size_t cursor;              // Samples with time <= current time
+    float time;
+    bool loop;
+};
+
+#endif // INPUT_SOURCES_H
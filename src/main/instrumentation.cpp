@@ -0,0 +1,283 @@
+#include "instrumentation.h"
+#include "rendering.h"
+#include <imgui.h>
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <iostream>
+
+std::atomic<bool> profilerActive(false);
+
+static const char* ZONE_NAMES[ZONE_COUNT] = {
+    "Frame",
+    "Input poll",
+    "updateScenario",
+    "Physics substep",
+    "Fleet substep",
+    "Gauge drawing",
+    "Fleet update",
+    "Fleet drawing",
+    "ImGui::Render",
+    "Buffer swap"
+};
+
+static const char* COUNTER_NAMES[COUNTER_COUNT] = {
+    "Frames",
+    "Physics substeps",
+    "UDP packets"
+};
+
+// Zone history rings (written and read on the render thread only; other
+// threads contribute to the trace but not to the overlay histograms)
+static std::atomic<int> renderThreadSlot(-1);
+static uint64_t zoneSamples[ZONE_COUNT][PROFILER_HISTORY];
+static int zoneHead[ZONE_COUNT];
+static int zoneFilled[ZONE_COUNT];
+
+// Chrome trace capture. A recorder claims a slot with traceCount, fills it,
+// then publishes it by storing the capture it belongs to (release); the
+// export skips slots not yet published for the current capture.
+struct TraceEvent {
+    uint64_t start;
+    uint64_t end;
+    ProfileZone zone;
+    int thread;
+    std::atomic<int> capture;
+};
+
+static TraceEvent traceEvents[PROFILER_TRACE_CAPACITY];
+static std::atomic<int> traceCount(0);
+static std::atomic<int> traceCapture(0);
+static std::atomic<int> traceFramesRemaining(0);
+static bool overlayVisible = false;
+static char traceStatus[128] = "";
+static int traceWritten = 0;
+
+// Per-thread counter slots, padded so threads never share a cache line
+const int PROFILER_MAX_THREADS = 32;
+
+struct alignas(64) CounterSlot {
+    std::atomic<uint64_t> values[COUNTER_COUNT];
+};
+
+static CounterSlot counterSlots[PROFILER_MAX_THREADS];
+static std::atomic<int> counterSlotsUsed(0);
+static thread_local int threadSlot = -1;
+
+// TSC calibration against the steady clock
+static const uint64_t epochTicks = profilerTicks();
+static const std::chrono::steady_clock::time_point epochTime = std::chrono::steady_clock::now();
+static double ticksPerMicro = 0.0;
+
+static int currentThreadSlot() {
+    if (threadSlot < 0) {
+        int slot = counterSlotsUsed.fetch_add(1, std::memory_order_relaxed);
+        threadSlot = std::min(slot, PROFILER_MAX_THREADS - 1);
+    }
+    return threadSlot;
+}
+
+static void updateActive() {
+    profilerActive.store(overlayVisible || traceFramesRemaining.load() > 0,
+                         std::memory_order_relaxed);
+}
+
+void profilerSetVisible(bool visible) {
+    overlayVisible = visible;
+    updateActive();
+}
+
+void profilerRecord(ProfileZone zone, uint64_t start, uint64_t end) {
+    if (currentThreadSlot() == renderThreadSlot.load(std::memory_order_relaxed)) {
+        int head = zoneHead[zone];
+        zoneSamples[zone][head] = end - start;
+        zoneHead[zone] = (head + 1) % PROFILER_HISTORY;
+        if (zoneFilled[zone] < PROFILER_HISTORY) zoneFilled[zone]++;
+    }
+
+    if (traceFramesRemaining.load(std::memory_order_relaxed) > 0) {
+        int capture = traceCapture.load(std::memory_order_relaxed);
+        int index = traceCount.fetch_add(1, std::memory_order_relaxed);
+        if (index < PROFILER_TRACE_CAPACITY) {
+            TraceEvent& event = traceEvents[index];
+            event.start = start;
+            event.end = end;
+            event.zone = zone;
+            event.thread = currentThreadSlot();
+            event.capture.store(capture, std::memory_order_release);
+        }
+    }
+}
+
+void profilerCount(ProfileCounter counter, uint64_t amount) {
+    counterSlots[currentThreadSlot()].values[counter].fetch_add(amount, std::memory_order_relaxed);
+}
+
+uint64_t profilerCounterTotal(ProfileCounter counter) {
+    uint64_t total = 0;
+    for (int i = 0; i < PROFILER_MAX_THREADS; i++) {
+        total += counterSlots[i].values[counter].load(std::memory_order_relaxed);
+    }
+    return total;
+}
+
+double profilerTicksToMicros(uint64_t ticks) {
+#if defined(__x86_64__) || defined(__i386__)
+    if (ticksPerMicro == 0.0) {
+        double elapsedUs = std::chrono::duration<double, std::micro>(
+            std::chrono::steady_clock::now() - epochTime).count();
+        double rate = (profilerTicks() - epochTicks) / std::max(elapsedUs, 1.0);
+        // Lock in the calibration once enough wall time has passed
+        if (elapsedUs < 1.0e6) return ticks / rate;
+        ticksPerMicro = rate;
+    }
+    return ticks / ticksPerMicro;
+#else
+    return ticks / 1000.0;
+#endif
+}
+
+void profilerRequestTrace(int frames) {
+    traceCapture.fetch_add(1);
+    traceCount.store(0);
+    traceFramesRemaining.store(frames);
+    snprintf(traceStatus, sizeof(traceStatus), "Capturing %d frames...", frames);
+    updateActive();
+}
+
+bool profilerWriteChromeTrace(const char* path) {
+    FILE* file = fopen(path, "w");
+    if (!file) {
+        std::cerr << "Profiler: Failed to open " << path << " for writing" << std::endl;
+        return false;
+    }
+
+    int capture = traceCapture.load();
+    int count = std::min(traceCount.load(), PROFILER_TRACE_CAPACITY);
+    int written = 0;
+    fprintf(file, "{\"traceEvents\":[\n");
+    for (int i = 0; i < count; i++) {
+        const TraceEvent& event = traceEvents[i];
+        // Claimed by a worker that has not finished writing it
+        if (event.capture.load(std::memory_order_acquire) != capture) continue;
+
+        fprintf(file, "%s{\"name\":\"%s\",\"ph\":\"X\",\"ts\":%.3f,\"dur\":%.3f,\"pid\":1,\"tid\":%d}",
+                written > 0 ? ",\n" : "",
+                ZONE_NAMES[event.zone],
+                profilerTicksToMicros(event.start - epochTicks),
+                profilerTicksToMicros(event.end - event.start),
+                event.thread);
+        written++;
+    }
+    fprintf(file, "\n],\"displayTimeUnit\":\"ms\"}\n");
+    fclose(file);
+    traceWritten = written;
+    return true;
+}
+
+void profilerEndFrame() {
+    profilerCount(COUNTER_FRAMES);
+
+    int remaining = traceFramesRemaining.load();
+    if (remaining <= 0) return;
+
+    traceFramesRemaining.store(remaining - 1);
+    if (remaining == 1) {
+        const char* path = "frame_trace.json";
+        if (profilerWriteChromeTrace(path)) {
+            snprintf(traceStatus, sizeof(traceStatus), "Wrote %d events to %s", traceWritten, path);
+        } else {
+            snprintf(traceStatus, sizeof(traceStatus), "Failed to write %s", path);
+        }
+        updateActive();
+    }
+}
+
+void drawProfilerOverlay(bool* open) {
+    static uint64_t lastCounts[COUNTER_COUNT];
+    static double counterRates[COUNTER_COUNT];
+    static std::chrono::steady_clock::time_point lastRateTime = std::chrono::steady_clock::now();
+
+    renderThreadSlot.store(currentThreadSlot(), std::memory_order_relaxed);
+    profilerSetVisible(*open);
+    if (!*open) return;
+
+    // Refresh counter rates once per second
+    std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+    double elapsed = std::chrono::duration<double>(now - lastRateTime).count();
+    if (elapsed >= 1.0) {
+        for (int c = 0; c < COUNTER_COUNT; c++) {
+            uint64_t total = profilerCounterTotal(static_cast<ProfileCounter>(c));
+            counterRates[c] = (total - lastCounts[c]) / elapsed;
+            lastCounts[c] = total;
+        }
+        lastRateTime = now;
+    }
+
+    ImGuiIO& io = ImGui::GetIO();
+    ImGui::SetNextWindowPos(ImVec2(io.DisplaySize.x - 440, 60), ImGuiCond_FirstUseEver);
+    ImGui::SetNextWindowSize(ImVec2(420, 640), ImGuiCond_FirstUseEver);
+    if (ImGui::Begin("Frame Profiler", open)) {
+        ImGui::Text("%.1f FPS (%.2f ms/frame)", io.Framerate, 1000.0f / io.Framerate);
+
+        for (int c = 0; c < COUNTER_COUNT; c++) {
+            ImGui::Text("%-18s %10llu  (%.0f/s)", COUNTER_NAMES[c],
+                        (unsigned long long)profilerCounterTotal(static_cast<ProfileCounter>(c)),
+                        counterRates[c]);
+        }
+        ImGui::Separator();
+
+        float values[PROFILER_HISTORY];
+        float sorted[PROFILER_HISTORY];
+        for (int z = 0; z < ZONE_COUNT; z++) {
+            int count = zoneFilled[z];
+            if (count == 0) continue;
+
+            // Unroll the ring oldest-first
+            int first = (zoneHead[z] - count + PROFILER_HISTORY) % PROFILER_HISTORY;
+            float sum = 0.0f;
+            float maxValue = 0.0f;
+            for (int i = 0; i < count; i++) {
+                values[i] = static_cast<float>(
+                    profilerTicksToMicros(zoneSamples[z][(first + i) % PROFILER_HISTORY]));
+                sum += values[i];
+                maxValue = std::max(maxValue, values[i]);
+            }
+            std::copy(values, values + count, sorted);
+            int p99Index = (count * 99) / 100;
+            std::nth_element(sorted, sorted + p99Index, sorted + count);
+
+            ImGui::Text("%s", ZONE_NAMES[z]);
+            ImGui::Text("  last %.1f  avg %.1f  p99 %.1f  max %.1f us",
+                        values[count - 1], sum / count, sorted[p99Index], maxValue);
+            ImGui::PushID(z);
+            ImGui::PlotHistogram("##samples", values, count, 0, NULL,
+                                 0.0f, maxValue * 1.1f, ImVec2(-1, 36));
+            ImGui::PopID();
+        }
+
+        // Draw-list cost of the gauge panel, switchable for before/after
+        static double smoothedMicros = 0.0;
+        const GaugeDrawStats& gauges = getGaugeDrawStats();
+        smoothedMicros += (gauges.micros - smoothedMicros) * 0.05;
+        ImGui::Separator();
+        ImGui::Text("Gauge draw list: %d vtx, %d idx, %.1f us",
+                    gauges.vertices, gauges.indices, smoothedMicros);
+        if (ImGui::RadioButton("Legacy", getGaugeDrawPath() == GAUGE_PATH_LEGACY)) {
+            setGaugeDrawPath(GAUGE_PATH_LEGACY);
+        }
+        ImGui::SameLine();
+        if (ImGui::RadioButton("Compact", getGaugeDrawPath() == GAUGE_PATH_COMPACT)) {
+            setGaugeDrawPath(GAUGE_PATH_COMPACT);
+        }
+
+        ImGui::Separator();
+        if (ImGui::Button("Capture Trace (120 frames)")) {
+            profilerRequestTrace(120);
+        }
+        if (traceStatus[0] != '\0') {
+            ImGui::TextDisabled("%s", traceStatus);
+        }
+    }
+    ImGui::End();
+}
@@ -0,0 +1,103 @@
+#ifndef INSTRUMENTATION_H
+#define INSTRUMENTATION_H
+
+#include <atomic>
+#include <cstdint>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#else
+#include <chrono>
+#endif
+
+/**
+ * Frame Instrumentation Module
+ * Always compiled in. Scoped timers read the TSC and only record while the
+ * overlay is open or a trace capture is armed; counters are always live.
+ */
+
+// Timed regions of the main loop
+enum ProfileZone {
+    ZONE_FRAME,
+    ZONE_INPUT_POLL,
+    ZONE_UPDATE_SCENARIO,
+    ZONE_PHYSICS_SUBSTEP,
+    ZONE_FLEET_SUBSTEP,
+    ZONE_DRAW_GAUGES,
+    ZONE_FLEET_UPDATE,
+    ZONE_FLEET_DRAW,
+    ZONE_IMGUI_RENDER,
+    ZONE_SWAP_BUFFERS,
+    ZONE_COUNT
+};
+
+// Hot-path event counters
+enum ProfileCounter {
+    COUNTER_FRAMES,
+    COUNTER_PHYSICS_SUBSTEPS,
+    COUNTER_UDP_PACKETS,
+    COUNTER_COUNT
+};
+
+// Samples kept per zone for the overlay histograms
+const int PROFILER_HISTORY = 256;
+
+// Events kept for Chrome trace export
+const int PROFILER_TRACE_CAPACITY = 16384;
+
+extern std::atomic<bool> profilerActive;
+
+inline uint64_t profilerTicks() {
+#if defined(__x86_64__) || defined(__i386__)
+    return __rdtsc();
+#else
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+#endif
+}
+
+// Recording control
+void profilerSetVisible(bool visible);
+void profilerRecord(ProfileZone zone, uint64_t start, uint64_t end);
+
+// Lock-free counters (each thread owns a private slot)
+void profilerCount(ProfileCounter counter, uint64_t amount = 1);
+uint64_t profilerCounterTotal(ProfileCounter counter);
+
+// Conversion and export
+double profilerTicksToMicros(uint64_t ticks);
+void profilerRequestTrace(int frames);
+bool profilerWriteChromeTrace(const char* path);
+void profilerEndFrame();
+
+// ImGui overlay window
+void drawProfilerOverlay(bool* open);
+
+/**
+ * ScopedTimer - RAII zone timer, one relaxed load when recording is off
+ */
+class ScopedTimer {
+public:
+    explicit ScopedTimer(ProfileZone zone)
+        : zone(zone),
+          start(profilerActive.load(std::memory_order_relaxed) ? profilerTicks() : 0) {}
+
+    ~ScopedTimer() {
+        if (start != 0) {
+            profilerRecord(zone, start, profilerTicks());
+        }
+    }
+
+private:
+    ScopedTimer(const ScopedTimer&);
+    ScopedTimer& operator=(const ScopedTimer&);
+
+    ProfileZone zone;
+    uint64_t start;
+};
+
+#define PROFILE_CONCAT_INNER(a, b) a##b
+#define PROFILE_CONCAT(a, b) PROFILE_CONCAT_INNER(a, b)
+#define PROFILE_SCOPE(zone) ScopedTimer PROFILE_CONCAT(scopedTimer_, __LINE__)(zone)
+
+#endif // INSTRUMENTATION_H
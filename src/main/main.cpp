@@ -3,13 +3,282 @@
 #include <imgui_impl_opengl3.h>
 #include <GLFW/glfw3.h>
 #include <iostream>
+#include <cstring>
+#include <cstdlib>
 
 #include "state.h"
 #include "display.h"
 #include "rendering.h"
 #include "udp_receiver.h"
+#include "shm_input_receiver.h"
+#include "input_sources.h"
+#include "glfw_joystick_input.h"
+#include "instrumentation.h"
+#include "fleet.h"
+#include "dashboard.h"
+
+// Receiver counters and rates; totals since start
+static void drawUdpStatsWindow(const UDPReceiver& receiver, bool* open) {
+    if (!*open) return;
+
+    ImGui::SetNextWindowSize(ImVec2(320, 280), ImGuiCond_FirstUseEver);
+    if (!ImGui::Begin("UDP Receiver", open)) {
+        ImGui::End();
+        return;
+    }
+
+    UDPReceiverStats stats = receiver.getStats();
+    ImGui::Text("Port %d (%s)", receiver.getPort(), udpBackendName(receiver.getBackend()));
+    ImGui::Text("%.0f packets/s, %.1f kB/s", stats.packetsPerSec, stats.bytesPerSec / 1000.0);
+    ImGui::Text("Receive thread CPU %.2f s", stats.cpuSeconds);
+    ImGui::Text("Latency %.1f us mean, %.1f us max", stats.latencyMeanMicros, stats.latencyMaxMicros);
+    ImGui::Separator();
+
+    ImGui::Columns(2, "udpStats", false);
+    const char* names[] = {"Accepted", "Wrong size", "NaN/Inf", "Out of range",
+                           "Socket errors", "Kernel drops"};
+    const uint64_t values[] = {stats.accepted, stats.badSize, stats.notFinite,
+                               stats.outOfRange, stats.socketErrors, stats.kernelDrops};
+    for (int i = 0; i < 6; i++) {
+        ImGui::Text("%s", names[i]);
+        ImGui::NextColumn();
+        ImGui::Text("%llu", (unsigned long long)values[i]);
+        ImGui::NextColumn();
+    }
+    ImGui::Columns(1);
+    ImGui::End();
+}
+
+// Shared-memory transport counters; totals since start
+static void drawShmStatsWindow(const ShmInputReceiver& receiver, bool* open) {
+    if (!*open) return;
+
+    ImGui::SetNextWindowSize(ImVec2(320, 200), ImGuiCond_FirstUseEver);
+    if (!ImGui::Begin("Shared-Memory Input", open)) {
+        ImGui::End();
+        return;
+    }
+
+    ShmInputStats stats = receiver.getStats();
+    ImGui::Text("Segment %s", receiver.getName().c_str());
+    ImGui::Separator();
+
+    ImGui::Columns(2, "shmStats", false);
+    const char* names[] = {"Published", "Accepted", "Rejected", "Superseded", "Lapped polls"};
+    const uint64_t values[] = {stats.published, stats.accepted, stats.rejected,
+                               stats.superseded, stats.lapped};
+    for (int i = 0; i < 5; i++) {
+        ImGui::Text("%s", names[i]);
+        ImGui::NextColumn();
+        ImGui::Text("%llu", (unsigned long long)values[i]);
+        ImGui::NextColumn();
+    }
+    ImGui::Columns(1);
+    ImGui::End();
+}
+
+// Where stick inputs come from (--input)
+enum InputKind {
+    INPUT_UDP,
+    INPUT_SHM,
+    INPUT_REPLAY,
+    INPUT_SYNTHETIC,
+    INPUT_JOYSTICK
+};
+
+static const char* INPUT_KIND_NAMES[] = {"udp", "shm", "replay", "synthetic", "joystick"};
+
+static bool parseInputKind(const char* name, InputKind& kind) {
+    for (int i = 0; i <= INPUT_JOYSTICK; i++) {
+        if (strcmp(name, INPUT_KIND_NAMES[i]) == 0) {
+            kind = static_cast<InputKind>(i);
+            return true;
+        }
+    }
+    return false;
+}
+
+// Frame pacing with a local joystick, which turns vsync off (60 Hz)
+static const double JOYSTICK_FRAME_PERIOD = 1.0 / 60.0;
+
+// In place of a vsynced swap: wait for the next frame, reading the stick at
+// every PHYSICS_TIMESTEP boundary of the wall clock meanwhile. A frame that
+// runs long skips the ticks it covered and the grid restarts after it.
+static void waitForJoystickFrame(GlfwJoystickInput& joystick, double& nextSample, double& nextFrame) {
+    double now = glfwGetTime();
+    for (;;) {
+        if (now >= nextSample) {
+            joystick.sample(now);
+            nextSample += PHYSICS_TIMESTEP;
+            if (nextSample <= now) nextSample = now + PHYSICS_TIMESTEP;
+        }
+        if (now >= nextFrame) break;
+        glfwWaitEventsTimeout((nextSample < nextFrame ? nextSample : nextFrame) - now);
+        now = glfwGetTime();
+    }
+
+    nextFrame += JOYSTICK_FRAME_PERIOD;
+    if (nextFrame <= now) nextFrame = now + JOYSTICK_FRAME_PERIOD;
+}
+
+// Local controller: live axes and the current mode's curves, editable
+static void drawJoystickWindow(GlfwJoystickInput& joystick, bool* open) {
+    if (!*open) return;
+
+    ImGui::SetNextWindowSize(ImVec2(360, 300), ImGuiCond_FirstUseEver);
+    if (!ImGui::Begin("Joystick", open)) {
+        ImGui::End();
+        return;
+    }
+
+    static const char* modeNames[] = {"Manual", "Rate Command", "Fly-By-Wire", "Attitude Hold"};
+    static const char* axisNames[] = {"Roll", "Pitch", "Yaw"};
+    ControlMode mode = joystick.getControlMode();
+    StickProfile& profile = joystick.getProfile(mode);
+
+    ImGui::Text("%s curves, stick read at %.0f Hz", modeNames[mode], joystick.getSampleRate());
+    ImGui::Separator();
+    for (int i = 0; i < 3; i++) {
+        StickCurve& curve = profile.axes[i];
+        ImGui::PushID(i);
+        ImGui::Text("%-5s raw %+.2f  ->  %+.0f", axisNames[i], joystick.getRawAxis(i),
+                    shapeStickAxis(joystick.getRawAxis(i), curve));
+        ImGui::SliderFloat("Deadzone", &curve.deadzone, 0.0f, 0.5f, "%.2f");
+        ImGui::SliderFloat("Expo", &curve.expo, 0.0f, 1.0f, "%.2f");
+        ImGui::SliderFloat("Scale", &curve.scale, 0.1f, 1.0f, "%.2f");
+        ImGui::Checkbox("Invert", &curve.invert);
+        ImGui::PopID();
+        ImGui::Spacing();
+    }
+    ImGui::End();
+}
+
+// Thruster on-time, pulses and propellant since reset, per axis
+static void drawThrusterWindow(SpacecraftDynamics& dynamics, bool* open) {
+    if (!*open) return;
+
+    ImGui::SetNextWindowSize(ImVec2(380, 220), ImGuiCond_FirstUseEver);
+    if (!ImGui::Begin("Thrusters", open)) {
+        ImGui::End();
+        return;
+    }
+
+    static const char* axisNames[] = {"Roll", "Pitch", "Yaw"};
+    ThrusterUsage& usage = dynamics.thrusterUsage;
+
+    ImGui::Text("%.1f s under thrust control", usage.elapsedMicros * 1e-6);
+    ImGui::Separator();
+    ImGui::Columns(4, "thrusterColumns", false);
+    ImGui::Text("Axis");   ImGui::NextColumn();
+    ImGui::Text("Duty");   ImGui::NextColumn();
+    ImGui::Text("Pulses"); ImGui::NextColumn();
+    ImGui::Text("N*m*s");  ImGui::NextColumn();
+    for (int axis = 0; axis < 3; axis++) {
+        ImGui::Text("%s", axisNames[axis]);                     ImGui::NextColumn();
+        ImGui::Text("%.1f%%", usage.dutyCycle(axis) * 100.0);   ImGui::NextColumn();
+        ImGui::Text("%u", usage.pulses[axis]);                  ImGui::NextColumn();
+        ImGui::Text("%.1f", usage.axisImpulse(axis));           ImGui::NextColumn();
+    }
+    ImGui::Columns(1);
+    ImGui::Separator();
+
+    ImGui::Text("Propellant: %.3f kg (Isp %.0f s, arm %.2f m)", dynamics.getPropellantUsed(),
+                dynamics.thrusterIsp, dynamics.thrusterMomentArm);
+    if (ImGui::Button("Reset Counters")) {
+        usage.reset();
+    }
+    ImGui::End();
+}
+
+// Connected / waiting line in the header bar
+template <typename Source>
+static void drawInputStatus(InputSource<Source>& input) {
+    char description[96];
+    input.describe(description, sizeof(description));
+    if (input.connected()) {
+        ImGui::TextColored(ImVec4(0.2f, 0.8f, 0.2f, 1.0f), "%s: CONNECTED", description);
+        ImGui::SameLine();
+        if (ImGui::Button("Disconnect")) {
+            input.disconnect();
+        }
+    } else {
+        ImGui::TextColored(ImVec4(0.7f, 0.7f, 0.7f, 1.0f), "%s: WAITING", description);
+    }
+}
+
+int main(int argc, char* argv[]) {
+    // --udp-metrics FILE: keep a Prometheus textfile of the receiver counters
+    // --udp-backend recvmmsg|io_uring: how the receive thread reads the socket
+    // --udp-threads/--udp-rcvbuf/--udp-busy-poll/--udp-cpu/--udp-spin: UDPReceiverConfig
+    // --input udp|shm|replay|synthetic|joystick: where stick inputs come from
+    // --shm-name NAME, --replay FILE, --synthetic sine|step|hold: per-source options
+    // --joystick N [--stick-deadzone F] [--stick-expo F]: local controller and its curves
+    const char* udpMetricsPath = nullptr;
+    InputKind inputKind = INPUT_UDP;
+    const char* shmName = SHM_INPUT_DEFAULT_NAME;
+    const char* replayPath = nullptr;
+    SyntheticPattern syntheticPattern = SYNTHETIC_SINE;
+    int joystickIndex = GLFW_JOYSTICK_1;
+    StickCurve stickCurve;
+    bool stickCurveSet = false;
+    UDPReceiveBackend udpBackend = UDP_BACKEND_RECVMMSG;
+    UDPReceiverConfig udpConfig;
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--udp-metrics") == 0 && i + 1 < argc) {
+            udpMetricsPath = argv[++i];
+        } else if (strcmp(argv[i], "--udp-threads") == 0 && i + 1 < argc) {
+            udpConfig.threads = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--udp-rcvbuf") == 0 && i + 1 < argc) {
+            udpConfig.receiveBufferBytes = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--udp-busy-poll") == 0 && i + 1 < argc) {
+            udpConfig.busyPollMicros = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--udp-cpu") == 0 && i + 1 < argc) {
+            udpConfig.cpu = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--udp-spin") == 0) {
+            udpConfig.spinPoll = true;
+        } else if (strcmp(argv[i], "--input") == 0 && i + 1 < argc &&
+                   parseInputKind(argv[i + 1], inputKind)) {
+            i++;
+        } else if (strcmp(argv[i], "--shm-name") == 0 && i + 1 < argc) {
+            shmName = argv[++i];
+        } else if (strcmp(argv[i], "--replay") == 0 && i + 1 < argc) {
+            replayPath = argv[++i];
+            inputKind = INPUT_REPLAY;
+        } else if (strcmp(argv[i], "--synthetic") == 0 && i + 1 < argc &&
+                   parseSyntheticPattern(argv[i + 1], syntheticPattern)) {
+            i++;
+            inputKind = INPUT_SYNTHETIC;
+        } else if (strcmp(argv[i], "--joystick") == 0 && i + 1 < argc) {
+            joystickIndex = atoi(argv[++i]) - 1;
+            inputKind = INPUT_JOYSTICK;
+        } else if (strcmp(argv[i], "--stick-deadzone") == 0 && i + 1 < argc) {
+            stickCurve.deadzone = static_cast<float>(atof(argv[++i]));
+            stickCurveSet = true;
+        } else if (strcmp(argv[i], "--stick-expo") == 0 && i + 1 < argc) {
+            stickCurve.expo = static_cast<float>(atof(argv[++i]));
+            stickCurveSet = true;
+        } else if (strcmp(argv[i], "--udp-backend") == 0 && i + 1 < argc &&
+                   (strcmp(argv[i + 1], "recvmmsg") == 0 || strcmp(argv[i + 1], "io_uring") == 0)) {
+            udpBackend = strcmp(argv[++i], "io_uring") == 0 ? UDP_BACKEND_IO_URING : UDP_BACKEND_RECVMMSG;
+        } else {
+            std::cerr << "Usage: " << argv[0]
+                      << " [--udp-metrics FILE] [--udp-backend recvmmsg|io_uring]"
+                      << " [--udp-threads N] [--udp-rcvbuf BYTES] [--udp-busy-poll US]"
+                      << " [--udp-cpu N] [--udp-spin] [--input udp|shm|replay|synthetic|joystick]"
+                      << " [--shm-name NAME] [--replay FILE] [--synthetic sine|step|hold]"
+                      << " [--joystick N] [--stick-deadzone F] [--stick-expo F]" << std::endl;
+            return 1;
+        }
+    }
+    if (inputKind == INPUT_REPLAY && !replayPath) {
+        std::cerr << "--input replay needs --replay FILE" << std::endl;
+        return 1;
+    }
+    if (joystickIndex < GLFW_JOYSTICK_1 || joystickIndex > GLFW_JOYSTICK_LAST) {
+        std::cerr << "--joystick takes 1 to " << GLFW_JOYSTICK_LAST + 1 << std::endl;
+        return 1;
+    }
 
-int main() {
     // Initialize GLFW
     if (!glfwInit())
         return -1;
@@ -23,7 +292,8 @@ int main() {
     }
     
     glfwMakeContextCurrent(window);
-    glfwSwapInterval(1);
+    // A local joystick paces frames itself so it can read the stick between them
+    glfwSwapInterval(inputKind == INPUT_JOYSTICK ? 0 : 1);
     
     // Setup Dear ImGui
     IMGUI_CHECKVERSION();
@@ -38,39 +308,80 @@ int main() {
 
     // Initialize UDP receiver
     UDPReceiver udpReceiver(8888);
-    if (!udpReceiver.start()) {
+    if (udpMetricsPath) {
+        udpReceiver.setMetricsFile(udpMetricsPath);
+    }
+    udpReceiver.setBackend(udpBackend);
+    udpReceiver.setConfig(udpConfig);
+
+    // Or the shared-memory transport, for a controller on this machine,
+    // a recorded run, a generated pattern or a local joystick
+    ShmInputReceiver shmInput(shmName);
+    ReplayInput replayInput;
+    SyntheticInput syntheticInput(syntheticPattern);
+    GlfwJoystickInput joystickInput(joystickIndex);
+    if (stickCurveSet) {
+        joystickInput.setCurve(stickCurve);
+    }
+    if (inputKind == INPUT_UDP && !udpReceiver.start()) {
         std::cerr << "Warning: Failed to start UDP receiver. Continuing without UDP input." << std::endl;
+    } else if (inputKind == INPUT_SHM && !shmInput.start()) {
+        std::cerr << "Warning: Failed to open shared-memory input. Continuing without it." << std::endl;
+    } else if (inputKind == INPUT_REPLAY) {
+        if (replayInput.load(replayPath)) {
+            replayInput.setLoop(true);
+            std::cout << "Replaying " << replayInput.getSampleCount() << " samples from "
+                      << replayPath << std::endl;
+        } else {
+            std::cerr << "Warning: " << replayInput.getError() << ". Continuing without input." << std::endl;
+        }
     }
     
+    bool showProfiler = false;
+    bool showFleet = false;
+    bool showInputStats = false;
+    bool showThrusters = false;
+    FleetSimulator fleet;
+    double nextJoystickSample = glfwGetTime();
+    double nextJoystickFrame = nextJoystickSample;
+    
     while (!glfwWindowShouldClose(window)) {
-        glfwPollEvents();
+        PROFILE_SCOPE(ZONE_FRAME);
+
+        {
+            PROFILE_SCOPE(ZONE_INPUT_POLL);
+            glfwPollEvents();
+            if (inputKind == INPUT_JOYSTICK) {
+                waitForJoystickFrame(joystickInput, nextJoystickSample, nextJoystickFrame);
+            }
+        }
 
         // Calculate delta time
         float currentTime = glfwGetTime();
         float deltaTime = currentTime - state.lastUpdateTime;
         state.lastUpdateTime = currentTime;
 
-        // Check for UDP joystick inputs
-        JoystickInputPacket joystickInput;
-        if (udpReceiver.getLatestInput(joystickInput)) {
-            if (state.mode == MANUAL) {
-                state.rollRate = joystickInput.rollInput;
-                state.pitchRate = joystickInput.pitchInput;
-                state.yawRate = joystickInput.yawInput;
-            } else if (state.mode == RATE_COMMAND) {
-                state.rollCommand = joystickInput.rollInput;
-                state.pitchCommand = joystickInput.pitchInput;
-                state.yawCommand = joystickInput.yawInput;
-            } else if (state.mode == FLY_BY_WIRE) {
-                state.flyByWireRoll = joystickInput.rollInput;
-                state.flyByWirePitch = joystickInput.pitchInput;
-                state.flyByWireYaw = joystickInput.yawInput;
-            }
+        // Update physics; the selected source is polled on every substep,
+        // and each case is a direct call into it
+        {
+            PROFILE_SCOPE(ZONE_UPDATE_SCENARIO);
+            updateScenario(state, deltaTime);
+        }
+        joystickInput.setControlMode(state.mode);
+        // Wall time the physics has reached; each substep moves it on 10 ms
+        joystickInput.setClock(currentTime - deltaTime - state.physicsAccumulator);
+        switch (inputKind) {
+            case INPUT_UDP:       updateSpacecraft(state, deltaTime, udpReceiver); break;
+            case INPUT_SHM:       updateSpacecraft(state, deltaTime, shmInput); break;
+            case INPUT_REPLAY:    updateSpacecraft(state, deltaTime, replayInput); break;
+            case INPUT_SYNTHETIC: updateSpacecraft(state, deltaTime, syntheticInput); break;
+            case INPUT_JOYSTICK:  updateSpacecraft(state, deltaTime, joystickInput); break;
         }
 
-        // Update physics
-        updateScenario(state, deltaTime);
-        updateSpacecraft(state, deltaTime);
+        if (showFleet) {
+            PROFILE_SCOPE(ZONE_FLEET_UPDATE);
+            fleet.update(deltaTime);
+        }
         
         // Start ImGui frame
         ImGui_ImplOpenGL3_NewFrame();
@@ -82,22 +393,31 @@ int main() {
         ImGui::SetNextWindowSize(io.DisplaySize);
         ImGui::Begin("Mercury Attitude Indicator", nullptr, 
                     ImGuiWindowFlags_NoTitleBar | ImGuiWindowFlags_NoResize | 
-                    ImGuiWindowFlags_NoMove | ImGuiWindowFlags_NoCollapse);
+                    ImGuiWindowFlags_NoMove | ImGuiWindowFlags_NoCollapse |
+                    ImGuiWindowFlags_NoBringToFrontOnFocus);
         
         ImGui::SetWindowFontScale(1.2f);
         ImGui::Text("PROJECT MERCURY ATTITUDE INDICATOR");
 
-        // UDP status
+        // Diagnostic windows
+        ImGui::SameLine(0.0f, 40.0f);
+        ImGui::Checkbox("Profiler", &showProfiler);
+        ImGui::SameLine();
+        ImGui::Checkbox("Fleet", &showFleet);
+        ImGui::SameLine();
+        ImGui::Checkbox("Input", &showInputStats);
+        ImGui::SameLine();
+        ImGui::Checkbox("Thrusters", &showThrusters);
+
+        // Input status
         ImGui::SameLine();
         ImGui::SetCursorPosX(ImGui::GetWindowWidth() - 350);
-        if (udpReceiver.hasReceivedData()) {
-            ImGui::TextColored(ImVec4(0.2f, 0.8f, 0.2f, 1.0f), "UDP: CONNECTED");
-            ImGui::SameLine();
-            if (ImGui::Button("Disconnect UDP")) {
-                udpReceiver.reset();
-            }
-        } else {
-            ImGui::TextColored(ImVec4(0.7f, 0.7f, 0.7f, 1.0f), "UDP: WAITING (Port %d)", udpReceiver.getPort());
+        switch (inputKind) {
+            case INPUT_UDP:       drawInputStatus(udpReceiver); break;
+            case INPUT_SHM:       drawInputStatus(shmInput); break;
+            case INPUT_REPLAY:    drawInputStatus(replayInput); break;
+            case INPUT_SYNTHETIC: drawInputStatus(syntheticInput); break;
+            case INPUT_JOYSTICK:  drawInputStatus(joystickInput); break;
         }
 
         ImGui::Separator();
@@ -155,26 +475,10 @@ int main() {
         ImGui::Spacing();
         
         // Draw gauges
-        ImDrawList* drawList = ImGui::GetWindowDrawList();
-        
-        float gaugeRadius = 90.0f;
-        ImVec2 rollCenter(250, 200);
-        ImVec2 rateCenter(700, 200);
-        ImVec2 pitchCenter(1150, 200);
-        ImVec2 yawCenter(700, 500);
-        
-        const char* rollLabels[] = {"0", "90", "", "90"};
-        const char* pitchLabels[] = {"0", "90", "180", "-90"};
-        const char* yawLabels[] = {"0", "90", "180", "270"};
-        
-        drawAttitudeGauge(drawList, rollCenter, gaugeRadius, state.roll, 
-                         IM_COL32(255, 165, 0, 255), "ROLL", rollLabels);
-        drawAttitudeGauge(drawList, pitchCenter, gaugeRadius, state.pitch,
-                         IM_COL32(74, 144, 226, 255), "PITCH", pitchLabels);
-        drawAttitudeGauge(drawList, yawCenter, gaugeRadius, state.yaw,
-                         IM_COL32(76, 175, 80, 255), "YAW", yawLabels);
-        drawRateIndicator(drawList, rateCenter, 180, 
-                         state.rollRate, state.pitchRate, state.yawRate);
+        {
+            PROFILE_SCOPE(ZONE_DRAW_GAUGES);
+            drawInstrumentPanel(ImGui::GetWindowDrawList(), state);
+        }
         
         // Control mode selection
         ImGui::SetCursorPosY(630);
@@ -199,6 +503,12 @@ int main() {
             state.rollCommand = 0; state.pitchCommand = 0; state.yawCommand = 0;
             state.flyByWireRoll = 0; state.flyByWirePitch = 0; state.flyByWireYaw = 0;
         }
+        ImGui::SameLine();
+        if (ImGui::Button("ATTITUDE HOLD")) {
+            state.mode = ATTITUDE_HOLD;
+            state.rollCommand = 0; state.pitchCommand = 0; state.yawCommand = 0;
+            state.flyByWireRoll = 0; state.flyByWirePitch = 0; state.flyByWireYaw = 0;
+        }
         
         ImGui::Spacing();
         ImGui::Separator();
@@ -267,6 +577,32 @@ int main() {
             
             ImGui::Columns(1);
             
+        } else if (state.mode == ATTITUDE_HOLD) {
+            ImGui::TextColored(ImVec4(0.4f, 0.8f, 1.0f, 1.0f),
+                              "Attitude Hold - Autopilot holds the attitude captured on entry");
+            ImGui::Spacing();
+
+            ImGui::Columns(3, "holdColumns", false);
+
+            static const char* axisNames[] = {"Roll", "Pitch", "Yaw"};
+            static const ImVec4 axisColors[] = {ImVec4(1.0f, 0.65f, 0.0f, 1.0f),
+                                                ImVec4(0.29f, 0.56f, 0.89f, 1.0f),
+                                                ImVec4(0.3f, 0.69f, 0.31f, 1.0f)};
+            const float errors[] = {state.holdErrorRoll, state.holdErrorPitch, state.holdErrorYaw};
+            const float rates[] = {state.rollRate, state.pitchRate, state.yawRate};
+            for (int axis = 0; axis < 3; axis++) {
+                int level = state.holdPulseLevel[axis];
+                ImGui::TextColored(axisColors[axis], "%s", axisNames[axis]);
+                ImGui::Text("Error: %+.2f deg", errors[axis]);
+                ImGui::Text("Rate: %.2f deg/s", rates[axis]);
+                ImGui::Text("Pulse: %s %s %d/%d", level == 0 ? "--" : level > 0 ? "+" : "-",
+                            level == 0 ? "" : (level == 1 || level == -1) ? "LOW" : "HIGH",
+                            state.holdPulseTicks[axis], HOLD_PWM_FRAME);
+                ImGui::NextColumn();
+            }
+
+            ImGui::Columns(1);
+
         } else {
             ImGui::Text("Manual Mode - Direct control");
             ImGui::Spacing();
@@ -296,17 +632,36 @@ int main() {
         }
         
         ImGui::End();
+
+        drawFleetDashboard(fleet, &showFleet);
+        drawProfilerOverlay(&showProfiler);
+        drawThrusterWindow(state.dynamics, &showThrusters);
+        if (inputKind == INPUT_SHM) {
+            drawShmStatsWindow(shmInput, &showInputStats);
+        } else if (inputKind == INPUT_UDP) {
+            drawUdpStatsWindow(udpReceiver, &showInputStats);
+        } else if (inputKind == INPUT_JOYSTICK) {
+            drawJoystickWindow(joystickInput, &showInputStats);
+        }
         
         // Render
-        ImGui::Render();
-        int display_w, display_h;
-        glfwGetFramebufferSize(window, &display_w, &display_h);
-        glViewport(0, 0, display_w, display_h);
-        glClearColor(0.2f, 0.2f, 0.2f, 1.0f);
-        glClear(GL_COLOR_BUFFER_BIT);
-        ImGui_ImplOpenGL3_RenderDrawData(ImGui::GetDrawData());
+        {
+            PROFILE_SCOPE(ZONE_IMGUI_RENDER);
+            ImGui::Render();
+            int display_w, display_h;
+            glfwGetFramebufferSize(window, &display_w, &display_h);
+            glViewport(0, 0, display_w, display_h);
+            glClearColor(0.2f, 0.2f, 0.2f, 1.0f);
+            glClear(GL_COLOR_BUFFER_BIT);
+            ImGui_ImplOpenGL3_RenderDrawData(ImGui::GetDrawData());
+        }
         
-        glfwSwapBuffers(window);
+        {
+            PROFILE_SCOPE(ZONE_SWAP_BUFFERS);
+            glfwSwapBuffers(window);
+        }
+
+        profilerEndFrame();
     }
     
     // Cleanup
@@ -1,12 +1,166 @@
 #include "rendering.h"
+#include "state.h"
+#include "instrumentation.h"
+#include "gauge_lod.h"
+#include <algorithm>
 #include <cmath>
 
 const float PI = 3.14159265359f;
 const float DEG_TO_RAD = PI / 180.0f;
 
-void drawAttitudeGauge(ImDrawList* drawList, ImVec2 center, float radius, 
-                       float angle, ImU32 color, const char* label, 
-                       const char* labels[4]) {
+// Fixed tessellation for the compact path (face counts match gauge_lod.h)
+const int DIAL_SEGMENTS = 48;
+const int REDUCED_SEGMENTS = 24;
+const int MINIMAL_SEGMENTS = 16;
+const int TIP_SEGMENTS = 12;
+const int TICK_COUNT = 12;   // One tick every 30 degrees
+
+// Vertex/index budget per primitive
+const int QUAD_VTX = 4;
+const int QUAD_IDX = 6;
+const int AA_LINE_VTX = 8;
+const int AA_LINE_IDX = 18;
+
+static GaugeDrawPath drawPath = GAUGE_PATH_COMPACT;
+static GaugeDrawStats lastStats;
+
+void setGaugeDrawPath(GaugeDrawPath path) { drawPath = path; }
+GaugeDrawPath getGaugeDrawPath() { return drawPath; }
+const GaugeDrawStats& getGaugeDrawStats() { return lastStats; }
+
+// ============================================================================
+// PRE-TESSELLATED TABLES
+// ============================================================================
+
+struct UnitTables {
+    ImVec2 dial[DIAL_SEGMENTS];
+    ImVec2 reduced[REDUCED_SEGMENTS];
+    ImVec2 minimal[MINIMAL_SEGMENTS];
+    ImVec2 tip[TIP_SEGMENTS];
+    ImVec2 ticks[TICK_COUNT];   // Tick directions, 0 deg at top, clockwise
+
+    UnitTables() {
+        fill(dial, DIAL_SEGMENTS);
+        fill(reduced, REDUCED_SEGMENTS);
+        fill(minimal, MINIMAL_SEGMENTS);
+        fill(tip, TIP_SEGMENTS);
+        for (int i = 0; i < TICK_COUNT; i++) {
+            float rad = (i * 30.0f - 90.0f) * DEG_TO_RAD;
+            ticks[i] = ImVec2(std::cos(rad), std::sin(rad));
+        }
+    }
+
+    static void fill(ImVec2* table, int segments) {
+        for (int i = 0; i < segments; i++) {
+            float a = (2.0f * PI * i) / segments;
+            table[i] = ImVec2(std::cos(a), std::sin(a));
+        }
+    }
+
+    // Table for a gauge_lod.h face segment count
+    const ImVec2* face(int segments) const {
+        if (segments >= DIAL_SEGMENTS) return dial;
+        if (segments >= REDUCED_SEGMENTS) return reduced;
+        return minimal;
+    }
+};
+
+static const UnitTables unitTables;
+
+// ============================================================================
+// BATCHED PRIMITIVES (write into space reserved by the caller)
+// ============================================================================
+
+// Solid quad along a-b, no anti-aliasing
+static void primLine(ImDrawList* drawList, ImVec2 a, ImVec2 b, float thickness,
+                     ImU32 color, ImVec2 uv) {
+    float dx = b.x - a.x, dy = b.y - a.y;
+    float invLength = 1.0f / std::sqrt(dx * dx + dy * dy + 1e-12f);
+    float nx = -dy * invLength * thickness * 0.5f;
+    float ny =  dx * invLength * thickness * 0.5f;
+
+    ImDrawIdx base = static_cast<ImDrawIdx>(drawList->_VtxCurrentIdx);
+    drawList->PrimWriteVtx(ImVec2(a.x + nx, a.y + ny), uv, color);
+    drawList->PrimWriteVtx(ImVec2(b.x + nx, b.y + ny), uv, color);
+    drawList->PrimWriteVtx(ImVec2(b.x - nx, b.y - ny), uv, color);
+    drawList->PrimWriteVtx(ImVec2(a.x - nx, a.y - ny), uv, color);
+    drawList->PrimWriteIdx(base);     drawList->PrimWriteIdx(base + 1); drawList->PrimWriteIdx(base + 2);
+    drawList->PrimWriteIdx(base);     drawList->PrimWriteIdx(base + 2); drawList->PrimWriteIdx(base + 3);
+}
+
+// Quad with a 1px alpha fringe on both long edges (for diagonal strokes)
+static void primLineAA(ImDrawList* drawList, ImVec2 a, ImVec2 b, float thickness,
+                       ImU32 color, ImVec2 uv) {
+    float dx = b.x - a.x, dy = b.y - a.y;
+    float invLength = 1.0f / std::sqrt(dx * dx + dy * dy + 1e-12f);
+    float ux = -dy * invLength, uy = dx * invLength;
+    float core = std::max(thickness * 0.5f - 0.5f, 0.0f);
+    float fringe = core + 1.0f;
+    ImU32 clear = color & ~IM_COL32_A_MASK;
+
+    ImDrawIdx base = static_cast<ImDrawIdx>(drawList->_VtxCurrentIdx);
+    drawList->PrimWriteVtx(ImVec2(a.x + ux * core, a.y + uy * core), uv, color);
+    drawList->PrimWriteVtx(ImVec2(b.x + ux * core, b.y + uy * core), uv, color);
+    drawList->PrimWriteVtx(ImVec2(b.x - ux * core, b.y - uy * core), uv, color);
+    drawList->PrimWriteVtx(ImVec2(a.x - ux * core, a.y - uy * core), uv, color);
+    drawList->PrimWriteVtx(ImVec2(a.x + ux * fringe, a.y + uy * fringe), uv, clear);
+    drawList->PrimWriteVtx(ImVec2(b.x + ux * fringe, b.y + uy * fringe), uv, clear);
+    drawList->PrimWriteVtx(ImVec2(b.x - ux * fringe, b.y - uy * fringe), uv, clear);
+    drawList->PrimWriteVtx(ImVec2(a.x - ux * fringe, a.y - uy * fringe), uv, clear);
+
+    static const ImDrawIdx order[AA_LINE_IDX] = {
+        0, 1, 2,  0, 2, 3,     // Core
+        4, 5, 1,  4, 1, 0,     // Upper fringe
+        3, 2, 6,  3, 6, 7      // Lower fringe
+    };
+    for (int i = 0; i < AA_LINE_IDX; i++) drawList->PrimWriteIdx(base + order[i]);
+}
+
+// Triangle fan from a unit-circle table, optionally with an alpha fringe ring
+static int fanVtxCount(int segments, bool antiAliased) { return 1 + segments * (antiAliased ? 2 : 1); }
+static int fanIdxCount(int segments, bool antiAliased) { return segments * (antiAliased ? 9 : 3); }
+
+static void primFan(ImDrawList* drawList, ImVec2 center, float radius, ImU32 color,
+                    const ImVec2* unit, int segments, bool antiAliased, ImVec2 uv) {
+    ImDrawIdx base = static_cast<ImDrawIdx>(drawList->_VtxCurrentIdx);
+    float inner = antiAliased ? radius - 0.5f : radius;
+
+    drawList->PrimWriteVtx(center, uv, color);
+    for (int i = 0; i < segments; i++) {
+        drawList->PrimWriteVtx(ImVec2(center.x + unit[i].x * inner,
+                                      center.y + unit[i].y * inner), uv, color);
+    }
+    for (int i = 0; i < segments; i++) {
+        int next = (i + 1) % segments;
+        drawList->PrimWriteIdx(base);
+        drawList->PrimWriteIdx(base + 1 + i);
+        drawList->PrimWriteIdx(base + 1 + next);
+    }
+
+    if (!antiAliased) return;
+
+    ImU32 clear = color & ~IM_COL32_A_MASK;
+    float outer = radius + 0.5f;
+    for (int i = 0; i < segments; i++) {
+        drawList->PrimWriteVtx(ImVec2(center.x + unit[i].x * outer,
+                                      center.y + unit[i].y * outer), uv, clear);
+    }
+    for (int i = 0; i < segments; i++) {
+        int next = (i + 1) % segments;
+        ImDrawIdx in0 = base + 1 + i, in1 = base + 1 + next;
+        ImDrawIdx out0 = base + 1 + segments + i, out1 = base + 1 + segments + next;
+        drawList->PrimWriteIdx(in0);  drawList->PrimWriteIdx(out0); drawList->PrimWriteIdx(out1);
+        drawList->PrimWriteIdx(in0);  drawList->PrimWriteIdx(out1); drawList->PrimWriteIdx(in1);
+    }
+}
+
+// ============================================================================
+// LEGACY PATH
+// ============================================================================
+
+static void drawAttitudeGaugeLegacy(ImDrawList* drawList, ImVec2 center, float radius, 
+                                    float angle, ImU32 color, const char* label, 
+                                    const char* labels[4]) {
     drawList->AddCircleFilled(center, radius, IM_COL32(26, 26, 26, 255));
 
     float majorAngles[] = {0, 90, 180, 270};
@@ -57,8 +211,8 @@ void drawAttitudeGauge(ImDrawList* drawList, ImVec2 center, float radius,
                      IM_COL32(255, 255, 255, 255), label);
 }
 
-void drawRateIndicator(ImDrawList* drawList, ImVec2 center, float size,
-                       float rollRate, float pitchRate, float yawRate) {
+static void drawRateIndicatorLegacy(ImDrawList* drawList, ImVec2 center, float size,
+                                    float rollRate, float pitchRate, float yawRate) {
     drawList->AddRectFilled(ImVec2(center.x - size/2, center.y - size/2),
                            ImVec2(center.x + size/2, center.y + size/2),
                            IM_COL32(26, 26, 26, 255));
@@ -107,4 +261,183 @@ void drawRateIndicator(ImDrawList* drawList, ImVec2 center, float size,
                                ImVec2(center.x - 30, center.y - yawBarLength),
                                IM_COL32(76, 175, 80, 255));
     }
-}
\ No newline at end of file
+}
+
+// ============================================================================
+// COMPACT PATH
+// ============================================================================
+
+static void drawAttitudeGaugeCompact(ImDrawList* drawList, ImVec2 center, float radius, 
+                                     float angle, ImU32 color, const char* label, 
+                                     const char* labels[4]) {
+    const ImU32 white = IM_COL32(255, 255, 255, 255);
+    const ImVec2 uv = ImGui::GetFontTexUvWhitePixel();
+    const ImVec2* ticks = unitTables.ticks;
+    const GaugeLod lod = selectGaugeLod(radius);
+    const int segments = std::min(lod.faceSegments, DIAL_SEGMENTS);
+
+    // Dial face and ticks in a single reservation. The face edge is
+    // dark-on-dark and the cardinal ticks are axis-aligned, so neither needs
+    // AA. Without ticks a light rim fan under the face marks the edge.
+    const bool outline = !lod.majorTicks;
+    const int majorTicks = lod.majorTicks ? 4 : 0;
+    const int minorTicks = lod.minorTicks ? TICK_COUNT - 4 : 0;
+    const int faces = outline ? 2 : 1;
+    drawList->PrimReserve(faces * fanIdxCount(segments, false) + majorTicks * QUAD_IDX + minorTicks * AA_LINE_IDX,
+                          faces * fanVtxCount(segments, false) + majorTicks * QUAD_VTX + minorTicks * AA_LINE_VTX);
+    if (outline) {
+        primFan(drawList, center, radius, IM_COL32(110, 110, 110, 255),
+                unitTables.face(segments), segments, false, uv);
+    }
+    primFan(drawList, center, outline ? radius - 1.0f : radius, IM_COL32(26, 26, 26, 255),
+            unitTables.face(segments), segments, false, uv);
+
+    for (int i = 0; i < TICK_COUNT; i++) {
+        bool isMajor = (i % 3 == 0);
+        if (isMajor ? !lod.majorTicks : !lod.minorTicks) continue;
+
+        float inner = radius - (isMajor ? 15.0f : 8.0f);
+        ImVec2 a(center.x + inner * ticks[i].x, center.y + inner * ticks[i].y);
+        ImVec2 b(center.x + radius * ticks[i].x, center.y + radius * ticks[i].y);
+        if (isMajor) {
+            primLine(drawList, a, b, 2.0f, white, uv);
+        } else {
+            primLineAA(drawList, a, b, 1.0f, white, uv);
+        }
+    }
+
+    if (lod.labels) {
+        for (int i = 0; i < 4; i++) {
+            const ImVec2& dir = ticks[i * 3];
+            float labelX = center.x + (radius - 30) * dir.x;
+            float labelY = center.y + (radius - 30) * dir.y;
+
+            ImVec2 textSize = ImGui::CalcTextSize(labels[i]);
+            drawList->AddText(ImVec2(labelX - textSize.x/2, labelY - textSize.y/2), white, labels[i]);
+        }
+    }
+
+    // Needle: shaft plus tip disc at full detail, one tapered quad otherwise
+    float pointerRad = (angle - 90) * DEG_TO_RAD;
+    if (lod.needleTip) {
+        float pointerLength = radius - 25;
+        ImVec2 tip(center.x + pointerLength * std::cos(pointerRad),
+                   center.y + pointerLength * std::sin(pointerRad));
+
+        drawList->PrimReserve(AA_LINE_IDX + fanIdxCount(TIP_SEGMENTS, true),
+                              AA_LINE_VTX + fanVtxCount(TIP_SEGMENTS, true));
+        primLineAA(drawList, center, tip, 4.0f, color, uv);
+        primFan(drawList, tip, 8.0f, color, unitTables.tip, TIP_SEGMENTS, true, uv);
+    } else {
+        float pointerLength = radius - (lod.majorTicks ? 8.0f : 2.0f);
+        ImVec2 tip(center.x + pointerLength * std::cos(pointerRad),
+                   center.y + pointerLength * std::sin(pointerRad));
+
+        drawList->PrimReserve(AA_LINE_IDX, AA_LINE_VTX);
+        primLineAA(drawList, center, tip, lod.majorTicks ? 3.0f : 2.0f, color, uv);
+    }
+    
+    if (lod.caption) {
+        ImVec2 textSize = ImGui::CalcTextSize(label);
+        drawList->AddText(ImVec2(center.x - textSize.x/2, center.y + radius + 10), white, label);
+    }
+}
+
+static void drawRateIndicatorCompact(ImDrawList* drawList, ImVec2 center, float size,
+                                     float rollRate, float pitchRate, float yawRate) {
+    const ImU32 orange = IM_COL32(255, 165, 0, 255);
+    const ImU32 blue = IM_COL32(74, 144, 226, 255);
+    const ImU32 green = IM_COL32(76, 175, 80, 255);
+    const ImU32 white = IM_COL32(255, 255, 255, 255);
+    
+    float maxBarLength = 60.0f;
+    float rollBarLength = (rollRate / 100.0f) * maxBarLength;
+    float pitchBarLength = (pitchRate / 100.0f) * maxBarLength;
+    float yawBarLength = (yawRate / 100.0f) * maxBarLength;
+
+    // Everything is axis-aligned, so one batch of plain quads covers it
+    int rects = 7 + (rollBarLength != 0) + (pitchBarLength != 0) + (yawBarLength != 0);
+    drawList->PrimReserve(rects * QUAD_IDX, rects * QUAD_VTX);
+
+    drawList->PrimRect(ImVec2(center.x - size/2, center.y - size/2),
+                       ImVec2(center.x + size/2, center.y + size/2),
+                       IM_COL32(26, 26, 26, 255));
+    drawList->PrimRect(ImVec2(center.x - 70, center.y - 0.5f),
+                       ImVec2(center.x + 70, center.y + 1.5f), white);
+    drawList->PrimRect(ImVec2(center.x - 0.5f, center.y - 70),
+                       ImVec2(center.x + 1.5f, center.y + 70), white);
+
+    // Roll rate
+    drawList->PrimRect(ImVec2(center.x - 2, center.y - 40), ImVec2(center.x + 2, center.y - 25), orange);
+    drawList->PrimRect(ImVec2(center.x - 2, center.y + 25), ImVec2(center.x + 2, center.y + 40), orange);
+    if (rollBarLength != 0) {
+        drawList->PrimRect(ImVec2(center.x, center.y - 35),
+                           ImVec2(center.x + rollBarLength, center.y - 30), orange);
+    }
+
+    // Pitch rate
+    drawList->PrimRect(ImVec2(center.x + 25, center.y - 2), ImVec2(center.x + 40, center.y + 2), blue);
+    if (pitchBarLength != 0) {
+        drawList->PrimRect(ImVec2(center.x + 30, center.y),
+                           ImVec2(center.x + 35, center.y - pitchBarLength), blue);
+    }
+
+    // Yaw rate
+    drawList->PrimRect(ImVec2(center.x - 40, center.y - 2), ImVec2(center.x - 25, center.y + 2), green);
+    if (yawBarLength != 0) {
+        drawList->PrimRect(ImVec2(center.x - 35, center.y),
+                           ImVec2(center.x - 30, center.y - yawBarLength), green);
+    }
+}
+
+// ============================================================================
+// PUBLIC ENTRY POINTS
+// ============================================================================
+
+void drawAttitudeGauge(ImDrawList* drawList, ImVec2 center, float radius, 
+                       float angle, ImU32 color, const char* label, 
+                       const char* labels[4]) {
+    if (drawPath == GAUGE_PATH_COMPACT) {
+        drawAttitudeGaugeCompact(drawList, center, radius, angle, color, label, labels);
+    } else {
+        drawAttitudeGaugeLegacy(drawList, center, radius, angle, color, label, labels);
+    }
+}
+
+void drawRateIndicator(ImDrawList* drawList, ImVec2 center, float size,
+                       float rollRate, float pitchRate, float yawRate) {
+    if (drawPath == GAUGE_PATH_COMPACT) {
+        drawRateIndicatorCompact(drawList, center, size, rollRate, pitchRate, yawRate);
+    } else {
+        drawRateIndicatorLegacy(drawList, center, size, rollRate, pitchRate, yawRate);
+    }
+}
+
+void drawInstrumentPanel(ImDrawList* drawList, const SpacecraftState& state) {
+    int startVertices = drawList->VtxBuffer.Size;
+    int startIndices = drawList->IdxBuffer.Size;
+    uint64_t startTicks = profilerTicks();
+
+    float gaugeRadius = 90.0f;
+    ImVec2 rollCenter(250, 200);
+    ImVec2 rateCenter(700, 200);
+    ImVec2 pitchCenter(1150, 200);
+    ImVec2 yawCenter(700, 500);
+    
+    const char* rollLabels[] = {"0", "90", "", "90"};
+    const char* pitchLabels[] = {"0", "90", "180", "-90"};
+    const char* yawLabels[] = {"0", "90", "180", "270"};
+    
+    drawAttitudeGauge(drawList, rollCenter, gaugeRadius, state.roll, 
+                     IM_COL32(255, 165, 0, 255), "ROLL", rollLabels);
+    drawAttitudeGauge(drawList, pitchCenter, gaugeRadius, state.pitch,
+                     IM_COL32(74, 144, 226, 255), "PITCH", pitchLabels);
+    drawAttitudeGauge(drawList, yawCenter, gaugeRadius, state.yaw,
+                     IM_COL32(76, 175, 80, 255), "YAW", yawLabels);
+    drawRateIndicator(drawList, rateCenter, 180, 
+                     state.rollRate, state.pitchRate, state.yawRate);
+
+    lastStats.vertices = drawList->VtxBuffer.Size - startVertices;
+    lastStats.indices = drawList->IdxBuffer.Size - startIndices;
+    lastStats.micros = profilerTicksToMicros(profilerTicks() - startTicks);
+}
@@ -3,7 +3,27 @@
 
 #include <imgui.h>
 
-// Drawing functions
+// Forward declaration - only the panel needs the full definition
+struct SpacecraftState;
+
+// Gauge tessellation paths (legacy kept for before/after comparison)
+enum GaugeDrawPath {
+    GAUGE_PATH_LEGACY,   // Individual AddLine/AddCircleFilled calls
+    GAUGE_PATH_COMPACT   // Pre-tessellated, batched PrimReserve meshes
+};
+
+// Draw-list cost of the most recent drawInstrumentPanel() call
+struct GaugeDrawStats {
+    int vertices = 0;
+    int indices = 0;
+    double micros = 0.0;
+};
+
+void setGaugeDrawPath(GaugeDrawPath path);
+GaugeDrawPath getGaugeDrawPath();
+const GaugeDrawStats& getGaugeDrawStats();
+
+// Drawing functions (the compact path drops detail by radius, see gauge_lod.h)
 void drawAttitudeGauge(ImDrawList* drawList, ImVec2 center, float radius, 
                        float angle, ImU32 color, const char* label, 
                        const char* labels[4]);
@@ -11,4 +31,7 @@ void drawAttitudeGauge(ImDrawList* drawList, ImVec2 center, float radius,
 void drawRateIndicator(ImDrawList* drawList, ImVec2 center, float size,
                        float rollRate, float pitchRate, float yawRate);
 
+// Full gauge layout: roll, pitch, yaw dials and the rate indicator
+void drawInstrumentPanel(ImDrawList* drawList, const SpacecraftState& state);
+
 #endif // RENDERING_H
\ No newline at end of file
@@ -0,0 +1,104 @@
+#include "shm_input_receiver.h"
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+
+ShmInputReceiver::ShmInputReceiver(const std::string& name)
+    : name(name), ring(nullptr), dataReceived(false), nextIndex(0), startIndex(0) {
+    memset(&latestPacket, 0, sizeof(JoystickInputPacket));
+}
+
+ShmInputReceiver::~ShmInputReceiver() {
+    stop();
+}
+
+bool ShmInputReceiver::start() {
+    if (ring) {
+        std::cerr << "Shared-memory input already running" << std::endl;
+        return false;
+    }
+
+    std::string error;
+    ring = shmInputMap(name.c_str(), error);
+    if (!ring) {
+        std::cerr << "Failed to open shared-memory input: " << error << std::endl;
+        return false;
+    }
+
+    // Whatever a previous writer left behind is not new input
+    nextIndex = ring->published.load(std::memory_order_acquire);
+    startIndex = nextIndex;
+    stats = ShmInputStats();
+
+    std::cout << "Shared-memory input started on " << name << std::endl;
+    return true;
+}
+
+void ShmInputReceiver::stop() {
+    if (!ring) {
+        return;
+    }
+
+    shmInputUnmap(ring);
+    ring = nullptr;
+    std::cout << "Shared-memory input stopped" << std::endl;
+}
+
+bool ShmInputReceiver::getLatestInput(JoystickInputPacket& packet) {
+    if (ring) {
+        JoystickInputPacket candidate;
+        uint64_t index;
+        if (shmInputReadLatest(ring, candidate, index)) {
+            if (index >= nextIndex) {
+                stats.superseded += index - nextIndex;
+                nextIndex = index + 1;
+
+                if (validateJoystickPacket(candidate, sizeof(candidate)) == PACKET_OK) {
+                    stats.accepted++;
+                    latestPacket = candidate;
+                    if (!dataReceived) {
+                        dataReceived = true;
+                        std::cout << "Shared-memory input: First joystick packet received on "
+                                  << name << std::endl;
+                    }
+                } else {
+                    stats.rejected++;
+                }
+            }
+        } else if (ring->published.load(std::memory_order_relaxed) != 0) {
+            stats.lapped++;
+        }
+    }
+
+    if (!dataReceived) {
+        return false;
+    }
+    packet = latestPacket;
+    return true;
+}
+
+void ShmInputReceiver::reset() {
+    dataReceived = false;
+    memset(&latestPacket, 0, sizeof(JoystickInputPacket));
+    if (ring) {
+        nextIndex = ring->published.load(std::memory_order_acquire);
+    }
+    std::cout << "Shared-memory input: Reset (cleared received data)" << std::endl;
+}
+
+bool ShmInputReceiver::waitForInput(int timeoutMs) {
+    if (!ring) {
+        return false;
+    }
+    return shmInputWait(ring, nextIndex, timeoutMs) > nextIndex;
+}
+
+ShmInputStats ShmInputReceiver::getStats() const {
+    ShmInputStats snapshot = stats;
+    snapshot.published = ring ? ring->published.load(std::memory_order_relaxed) - startIndex : 0;
+    return snapshot;
+}
+
+void ShmInputReceiver::describeSource(char* text, size_t size) const {
+    snprintf(text, size, "SHM %s", name.c_str());
+}
@@ -0,0 +1,58 @@
+#ifndef SHM_INPUT_RECEIVER_H
+#define SHM_INPUT_RECEIVER_H
+
+#include "shm_input.h"
+#include "input_source.h"
+#include <string>
+
+// Counters since start(); read from the thread that polls
+struct ShmInputStats {
+    uint64_t published = 0;      // Packets the writer has completed
+    uint64_t accepted = 0;
+    uint64_t rejected = 0;       // Failed validateJoystickPacket()
+    uint64_t superseded = 0;     // Overwritten by a newer packet before a poll saw them
+    uint64_t lapped = 0;         // Polls that gave up after the writer lapped the ring
+};
+
+/**
+ * ShmInputReceiver - the GUI side of the shared-memory transport
+ * getLatestInput() is a seqlock read of the newest slot: no lock, no system
+ * call, so it can run every frame or physics tick. Packets go through the
+ * same validateJoystickPacket() as UDP datagrams. Single consumer thread.
+ */
+class ShmInputReceiver : public InputSource<ShmInputReceiver> {
+public:
+    explicit ShmInputReceiver(const std::string& name = SHM_INPUT_DEFAULT_NAME);
+    ~ShmInputReceiver();
+
+    // Map (creating if needed) / unmap the segment
+    bool start();
+    void stop();
+    bool isRunning() const { return ring != nullptr; }
+
+    bool getLatestInput(JoystickInputPacket& packet);
+    bool hasReceivedData() const { return dataReceived; }
+
+    // Forget the current packet; only packets published after this count
+    void reset();
+
+    // Block until the writer publishes something newer than the last packet
+    // read (futex); false on timeout. For consumers without their own clock.
+    bool waitForInput(int timeoutMs);
+
+    const std::string& getName() const { return name; }
+    ShmInputStats getStats() const;
+    void describeSource(char* text, size_t size) const;
+
+private:
+    std::string name;
+    ShmInputRing* ring;
+
+    bool dataReceived;
+    JoystickInputPacket latestPacket;
+    uint64_t nextIndex;          // Oldest packet index not yet looked at
+    uint64_t startIndex;         // Packets published before start()
+    ShmInputStats stats;
+};
+
+#endif // SHM_INPUT_RECEIVER_H
@@ -0,0 +1,101 @@
+#ifndef UDP_BATCH_H
+#define UDP_BATCH_H
+
+#include "udp_protocol.h"
+#include <cstring>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+/**
+ * Batch Packet Validation
+ * Validates a recvmmsg() batch of JoystickInputPackets without per-packet
+ * branches. Four packets (one 128-bit register each: three float axes and
+ * the timestamp) are transposed so each register holds one axis of all
+ * four, then tested on their IEEE-754 bits:
+ *   - non-finite: exponent field all ones, (bits & 0x7F800000) == 0x7F800000
+ *   - out of range: for finite values |x| > limit is the same as
+ *     (bits & 0x7FFFFFFF) > bits(limit) as integers
+ * and folded into four statuses with the same priority as
+ * validateJoystickPacket() (size, finiteness, range), which remains the
+ * reference; src/test/bench_packet_validate checks the two agree and times
+ * them.
+ *
+ * SSE2 is part of x86-64, so no extra compiler flags. The remainder of a
+ * batch, and every packet on other targets, goes through
+ * validateJoystickPacket() itself (scalar bit tests measured slower than
+ * its float compares).
+ */
+
+// One accept-mask bit per packet
+const int UDP_BATCH_MAX = 64;
+
+// Statuses are stored four at a time as 32-bit lanes
+static_assert(sizeof(JoystickPacketStatus) == sizeof(uint32_t),
+              "JoystickPacketStatus must be 32 bits for the vector store");
+
+// Bit pattern of a float limit for the integer compares
+inline uint32_t floatBits(float value) {
+    uint32_t bits;
+    memcpy(&bits, &value, sizeof(bits));
+    return bits;
+}
+
+/*
+ * Validate count (<= UDP_BATCH_MAX) packets; lengths are the datagram sizes.
+ * Fills status[i] and returns the accept mask (bit i set = PACKET_OK).
+ */
+inline uint64_t validateJoystickBatch(const JoystickInputPacket* packets, const uint32_t* lengths,
+                                      int count, JoystickPacketStatus* status) {
+    uint64_t accepted = 0;
+    int i = 0;
+
+#if defined(__SSE2__)
+    const __m128i exponentMask = _mm_set1_epi32(0x7F800000);
+    const __m128i magnitudeMask = _mm_set1_epi32(0x7FFFFFFF);
+    const __m128i limit = _mm_set1_epi32(static_cast<int>(floatBits(JOYSTICK_INPUT_TOLERANCE)));
+    const __m128i packetSize = _mm_set1_epi32(sizeof(JoystickInputPacket));
+    const __m128i zero = _mm_setzero_si128();
+
+    for (; i + 4 <= count; i += 4) {
+        // Rows: packets i..i+3. After the transpose: roll, pitch, yaw, timestamp
+        __m128 a = _mm_loadu_ps(reinterpret_cast<const float*>(&packets[i]));
+        __m128 b = _mm_loadu_ps(reinterpret_cast<const float*>(&packets[i + 1]));
+        __m128 c = _mm_loadu_ps(reinterpret_cast<const float*>(&packets[i + 2]));
+        __m128 d = _mm_loadu_ps(reinterpret_cast<const float*>(&packets[i + 3]));
+        _MM_TRANSPOSE4_PS(a, b, c, d);
+        const __m128i axes[3] = {_mm_castps_si128(a), _mm_castps_si128(b), _mm_castps_si128(c)};
+
+        __m128i nonFinite = zero, outOfRange = zero;
+        for (int axis = 0; axis < 3; axis++) {
+            nonFinite = _mm_or_si128(nonFinite,
+                _mm_cmpeq_epi32(_mm_and_si128(axes[axis], exponentMask), exponentMask));
+            outOfRange = _mm_or_si128(outOfRange,
+                _mm_cmpgt_epi32(_mm_and_si128(axes[axis], magnitudeMask), limit));
+        }
+        __m128i length = _mm_loadu_si128(reinterpret_cast<const __m128i*>(&lengths[i]));
+        __m128i badSize = _mm_xor_si128(_mm_cmpeq_epi32(length, packetSize), _mm_set1_epi32(-1));
+
+        // Lanes are all-ones masks: later selects override earlier ones
+        __m128i result = _mm_and_si128(outOfRange, _mm_set1_epi32(PACKET_OUT_OF_RANGE));
+        result = _mm_or_si128(_mm_andnot_si128(nonFinite, result),
+                              _mm_and_si128(nonFinite, _mm_set1_epi32(PACKET_NOT_FINITE)));
+        result = _mm_or_si128(_mm_andnot_si128(badSize, result),
+                              _mm_and_si128(badSize, _mm_set1_epi32(PACKET_BAD_SIZE)));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(&status[i]), result);
+
+        int ok = _mm_movemask_ps(_mm_castsi128_ps(_mm_cmpeq_epi32(result, zero)));
+        accepted |= static_cast<uint64_t>(ok) << i;
+    }
+#endif
+
+    for (; i < count; i++) {
+        status[i] = validateJoystickPacket(packets[i], lengths[i]);
+        accepted |= static_cast<uint64_t>(status[i] == PACKET_OK) << i;
+    }
+
+    return accepted;
+}
+
+#endif // UDP_BATCH_H
@@ -0,0 +1,257 @@
+/*
+ * UDP Receive Backend Benchmark
+ *
+ * Sends joystick packets over loopback at a fixed rate to a UDPReceiver
+ * running each receive backend in turn, and reports the receive threads'
+ * CPU time per million packets alongside the achieved rate, kernel drops
+ * and receive latency (kernel timestamp to input handoff). Both backends
+ * see the same offered load, so the CPU column is the comparison; drops
+ * show where a backend stops keeping up. The tuning options map onto
+ * UDPReceiverConfig, so each one can be measured on its own.
+ *
+ * Usage: ./udp_bench [--rate PPS] [--packets N] [--port P] [--sources N]
+ *                    [--backend recvmmsg|io_uring|both]
+ *                    [--threads N] [--rcvbuf BYTES] [--busy-poll US]
+ *                    [--cpu N] [--spin]
+ */
+
+#include "udp_receiver.h"
+
+#include <arpa/inet.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <iostream>
+#include <thread>
+
+// Packets per sendmmsg() call; the sender sleeps between batches
+const int SEND_BATCH = 64;
+
+// After the last send, how long the receiver gets to drain its queue
+const double DRAIN_SECONDS = 1.0;
+
+struct BenchResult {
+    UDPReceiveBackend backend;
+    uint64_t sent;
+    double sendSeconds;
+    double latencyMeanMicros;
+    double latencyMaxMicros;
+    UDPReceiverStats stats;
+};
+
+static double threadCpuSeconds() {
+    struct timespec ts;
+    clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+// Most sender sockets; each is a separate source port for SO_REUSEPORT
+const int MAX_SOURCES = 64;
+
+// Paced sendmmsg() of valid packets, batches rotating over the sources;
+// returns how many the kernel took
+static uint64_t sendPackets(int port, int sources, double rate, uint64_t count, double& seconds) {
+    struct sockaddr_in dest;
+    memset(&dest, 0, sizeof(dest));
+    dest.sin_family = AF_INET;
+    dest.sin_port = htons(port);
+    dest.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+
+    int fds[MAX_SOURCES];
+    for (int s = 0; s < sources; s++) {
+        fds[s] = socket(AF_INET, SOCK_DGRAM, 0);
+        if (fds[s] < 0 || connect(fds[s], reinterpret_cast<struct sockaddr*>(&dest), sizeof(dest)) < 0) {
+            std::cerr << "sender socket: " << strerror(errno) << std::endl;
+            for (int i = 0; i <= s; i++) {
+                if (fds[i] >= 0) close(fds[i]);
+            }
+            return 0;
+        }
+    }
+
+    JoystickInputPacket packets[SEND_BATCH];
+    struct iovec iovs[SEND_BATCH];
+    struct mmsghdr messages[SEND_BATCH];
+    memset(messages, 0, sizeof(messages));
+    for (int i = 0; i < SEND_BATCH; i++) {
+        packets[i].rollInput = 10.0f;
+        packets[i].pitchInput = -5.0f;
+        packets[i].yawInput = 2.5f;
+        packets[i].timestamp = 0;
+        iovs[i].iov_base = &packets[i];
+        iovs[i].iov_len = sizeof(JoystickInputPacket);
+        messages[i].msg_hdr.msg_iov = &iovs[i];
+        messages[i].msg_hdr.msg_iovlen = 1;
+    }
+
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    uint64_t sent = 0;
+    int source = 0;
+    while (sent < count) {
+        int batch = static_cast<int>(std::min<uint64_t>(SEND_BATCH, count - sent));
+        for (int i = 0; i < batch; i++) {
+            packets[i].timestamp = static_cast<uint32_t>(sent + i);
+        }
+
+        int done = sendmmsg(fds[source], messages, batch, 0);
+        if (done < 0) {
+            if (errno == EINTR || errno == ENOBUFS || errno == EAGAIN) continue;
+            std::cerr << "sendmmsg: " << strerror(errno) << std::endl;
+            break;
+        }
+        sent += done;
+        source = (source + 1) % sources;
+
+        // Pace against the schedule, not the previous batch, so late
+        // batches catch up instead of lowering the rate
+        std::this_thread::sleep_until(start + std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+                                                  std::chrono::duration<double>(sent / rate)));
+    }
+    seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    for (int s = 0; s < sources; s++) {
+        close(fds[s]);
+    }
+    return sent;
+}
+
+static bool runBackend(UDPReceiveBackend backend, const UDPReceiverConfig& config, int port,
+                       int sources, double rate, uint64_t count, BenchResult& result) {
+    UDPReceiver receiver(port);
+    receiver.setConfig(config);
+    receiver.setBackend(backend);
+    if (!receiver.start()) {
+        return false;
+    }
+    if (receiver.getBackend() != backend) {
+        receiver.stop();
+        return false;
+    }
+
+    result.backend = backend;
+    result.sent = sendPackets(port, sources, rate, count, result.sendSeconds);
+    result.latencyMeanMicros = 0.0;
+    result.latencyMaxMicros = 0.0;
+
+    // Let the receiver drain; every packet is either counted or dropped.
+    // Latency is a per-second gauge: keep the last reading taken under load.
+    std::chrono::steady_clock::time_point deadline =
+        std::chrono::steady_clock::now() + std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+                                               std::chrono::duration<double>(DRAIN_SECONDS));
+    while (std::chrono::steady_clock::now() < deadline) {
+        UDPReceiverStats stats = receiver.getStats();
+        if (stats.latencyMeanMicros > 0.0) {
+            result.latencyMeanMicros = stats.latencyMeanMicros;
+            result.latencyMaxMicros = stats.latencyMaxMicros;
+        }
+        if (stats.accepted + stats.kernelDrops >= result.sent) break;
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+
+    receiver.stop();
+    result.stats = receiver.getStats();
+    return true;
+}
+
+static void printResult(const BenchResult& r) {
+    double received = static_cast<double>(r.stats.accepted);
+    printf("%-10s %10llu %10llu %9llu %12.0f %12.3f %14.3f %10.1f %10.1f\n",
+           udpBackendName(r.backend),
+           (unsigned long long)r.sent,
+           (unsigned long long)r.stats.accepted,
+           (unsigned long long)r.stats.kernelDrops,
+           r.sendSeconds > 0.0 ? received / r.sendSeconds : 0.0,
+           r.stats.cpuSeconds,
+           received > 0.0 ? r.stats.cpuSeconds * 1e6 / received : 0.0,
+           r.latencyMeanMicros, r.latencyMaxMicros);
+}
+
+int main(int argc, char* argv[]) {
+    double rate = 200000.0;
+    uint64_t count = 1000000;
+    int port = 9898;
+    int sources = 1;
+    UDPReceiverConfig config;
+    bool runRecvmmsg = true;
+    bool runUring = true;
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--rate") == 0 && i + 1 < argc) {
+            rate = atof(argv[++i]);
+        } else if (strcmp(argv[i], "--packets") == 0 && i + 1 < argc) {
+            count = strtoull(argv[++i], nullptr, 10);
+        } else if (strcmp(argv[i], "--port") == 0 && i + 1 < argc) {
+            port = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--sources") == 0 && i + 1 < argc) {
+            sources = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--threads") == 0 && i + 1 < argc) {
+            config.threads = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--rcvbuf") == 0 && i + 1 < argc) {
+            config.receiveBufferBytes = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--busy-poll") == 0 && i + 1 < argc) {
+            config.busyPollMicros = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--cpu") == 0 && i + 1 < argc) {
+            config.cpu = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--spin") == 0) {
+            config.spinPoll = true;
+        } else if (strcmp(argv[i], "--backend") == 0 && i + 1 < argc) {
+            const char* name = argv[++i];
+            runRecvmmsg = strcmp(name, "recvmmsg") == 0 || strcmp(name, "both") == 0;
+            runUring = strcmp(name, "io_uring") == 0 || strcmp(name, "both") == 0;
+            if (!runRecvmmsg && !runUring) {
+                std::cerr << "Unknown backend: " << name << std::endl;
+                return 1;
+            }
+        } else {
+            std::cerr << "Usage: " << argv[0] << " [--rate PPS] [--packets N] [--port P] [--sources N]"
+                      << " [--backend recvmmsg|io_uring|both] [--threads N] [--rcvbuf BYTES]"
+                      << " [--busy-poll US] [--cpu N] [--spin]" << std::endl;
+            return 1;
+        }
+    }
+    if (rate <= 0.0 || count == 0) {
+        std::cerr << "Rate and packet count must be positive" << std::endl;
+        return 1;
+    }
+    if (sources < 1 || sources > MAX_SOURCES) {
+        std::cerr << "Sources must be 1 to " << MAX_SOURCES << std::endl;
+        return 1;
+    }
+
+    const UDPReceiveBackend backends[] = {UDP_BACKEND_RECVMMSG, UDP_BACKEND_IO_URING};
+    const bool enabled[] = {runRecvmmsg, runUring};
+    BenchResult results[2];
+    bool ok[2] = {false, false};
+
+    for (int b = 0; b < 2; b++) {
+        if (!enabled[b]) continue;
+        double senderCpu = threadCpuSeconds();
+        ok[b] = runBackend(backends[b], config, port, sources, rate, count, results[b]);
+        if (!ok[b]) {
+            std::cerr << udpBackendName(backends[b]) << ": backend unavailable, skipped" << std::endl;
+            continue;
+        }
+        std::cerr << udpBackendName(backends[b]) << ": sender used "
+                  << threadCpuSeconds() - senderCpu << " s CPU" << std::endl;
+    }
+
+    printf("\n%llu packets at %.0f pps offered from %d source(s), loopback port %d\n",
+           (unsigned long long)count, rate, sources, port);
+    printf("%d receive thread(s)%s, rcvbuf %d, busy poll %d us, cpu %d\n\n",
+           config.threads, config.spinPoll ? " spinning" : "", config.receiveBufferBytes,
+           config.busyPollMicros, config.cpu);
+    printf("%-10s %10s %10s %9s %12s %12s %14s %10s %10s\n",
+           "backend", "sent", "received", "dropped", "recv pps", "cpu s", "cpu s / Mpkt",
+           "lat us", "max us");
+    for (int b = 0; b < 2; b++) {
+        if (ok[b]) printResult(results[b]);
+    }
+    return 0;
+}
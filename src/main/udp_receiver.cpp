@@ -1,33 +1,57 @@
 #include "udp_receiver.h"
+#include "instrumentation.h"
 #include <sys/socket.h>
 #include <netinet/in.h>
 #include <arpa/inet.h>
+#include <pthread.h>
+#include <sched.h>
 #include <unistd.h>
 #include <cstring>
 #include <iostream>
 #include <cerrno>
 #include <cmath>
+#include <cstdio>
+#include <ctime>
+
+// At most one line per rejection reason per interval
+const double UDP_LOG_INTERVAL_SECONDS = 1.0;
+const double UDP_RATE_WINDOW_SECONDS = 1.0;
 
 UDPReceiver::UDPReceiver(int port)
-    : port(port), sockfd(-1), running(false), dataReceived(false) {
+    : port(port), running(false), dataReceived(false),
+      socketErrors(0), bytesReceived(0),
+      packetsPerSec(0.0), bytesPerSec(0.0),
+      latencySumNs(0), latencyCount(0), latencyMaxNs(0),
+      latencyMeanMicros(0.0), latencyMaxMicros(0.0),
+      rateWindowStartPackets(0), rateWindowStartBytes(0),
+      retiredKernelDrops(0), retiredCpuSeconds(0.0),
+      requestedBackend(UDP_BACKEND_RECVMMSG), activeBackend(UDP_BACKEND_RECVMMSG) {
     memset(&latestPacket, 0, sizeof(JoystickInputPacket));
+    for (int i = 0; i <= PACKET_OUT_OF_RANGE; i++) {
+        statusCounts[i] = 0;
+        lastLogNs[i] = 0;
+        suppressedLogs[i] = 0;
+    }
+}
+
+const char* udpBackendName(UDPReceiveBackend backend) {
+    switch (backend) {
+        case UDP_BACKEND_IO_URING: return "io_uring";
+        default: return "recvmmsg";
+    }
 }
 
 UDPReceiver::~UDPReceiver() {
     stop();
 }
 
-bool UDPReceiver::start() {
-    if (running) {
-        std::cerr << "UDP Receiver already running" << std::endl;
-        return false;
-    }
-
+// One bound socket with the configured options; -1 on failure
+int UDPReceiver::openSocket() {
     // Create UDP socket
-    sockfd = socket(AF_INET, SOCK_DGRAM, 0);
+    int sockfd = socket(AF_INET, SOCK_DGRAM, 0);
     if (sockfd < 0) {
         std::cerr << "Failed to create socket: " << strerror(errno) << std::endl;
-        return false;
+        return -1;
     }
 
     // Set socket options to allow reuse
@@ -35,8 +59,15 @@ bool UDPReceiver::start() {
     if (setsockopt(sockfd, SOL_SOCKET, SO_REUSEADDR, &optval, sizeof(optval)) < 0) {
         std::cerr << "Failed to set SO_REUSEADDR: " << strerror(errno) << std::endl;
         close(sockfd);
-        sockfd = -1;
-        return false;
+        return -1;
+    }
+
+    // Every thread binds the same port; the kernel hashes sources across them
+    if (config.threads > 1 &&
+        setsockopt(sockfd, SOL_SOCKET, SO_REUSEPORT, &optval, sizeof(optval)) < 0) {
+        std::cerr << "Failed to set SO_REUSEPORT: " << strerror(errno) << std::endl;
+        close(sockfd);
+        return -1;
     }
 
     // Set non-blocking mode with timeout
@@ -46,8 +77,45 @@ bool UDPReceiver::start() {
     if (setsockopt(sockfd, SOL_SOCKET, SO_RCVTIMEO, &tv, sizeof(tv)) < 0) {
         std::cerr << "Failed to set socket timeout: " << strerror(errno) << std::endl;
         close(sockfd);
-        sockfd = -1;
-        return false;
+        return -1;
+    }
+
+    // Ask for the socket's kernel drop count with every datagram
+    if (setsockopt(sockfd, SOL_SOCKET, SO_RXQ_OVFL, &optval, sizeof(optval)) < 0) {
+        std::cerr << "Failed to set SO_RXQ_OVFL (kernel drops not counted): "
+                  << strerror(errno) << std::endl;
+    }
+
+    // Kernel receive time with every datagram, for the latency stats
+    if (config.timestamps &&
+        setsockopt(sockfd, SOL_SOCKET, SO_TIMESTAMPNS, &optval, sizeof(optval)) < 0) {
+        std::cerr << "Failed to set SO_TIMESTAMPNS (latency not measured): "
+                  << strerror(errno) << std::endl;
+    }
+
+    // SO_RCVBUF is capped at net.core.rmem_max; SO_RCVBUFFORCE is not, but
+    // needs CAP_NET_ADMIN. The kernel doubles either for bookkeeping.
+    if (config.receiveBufferBytes > 0) {
+        int bytes = config.receiveBufferBytes;
+        if (setsockopt(sockfd, SOL_SOCKET, SO_RCVBUFFORCE, &bytes, sizeof(bytes)) < 0 &&
+            setsockopt(sockfd, SOL_SOCKET, SO_RCVBUF, &bytes, sizeof(bytes)) < 0) {
+            std::cerr << "Failed to set SO_RCVBUF: " << strerror(errno) << std::endl;
+        }
+        int granted = 0;
+        socklen_t length = sizeof(granted);
+        if (getsockopt(sockfd, SOL_SOCKET, SO_RCVBUF, &granted, &length) == 0 && granted / 2 < bytes) {
+            std::cerr << "UDP Receiver: receive buffer capped at " << granted / 2
+                      << " bytes (asked for " << bytes << "; raise net.core.rmem_max)" << std::endl;
+        }
+    }
+
+    // Spin in the driver's receive queue before sleeping; only helps on a
+    // NAPI device (not loopback), and above net.core.busy_read needs CAP_NET_ADMIN
+    if (config.busyPollMicros > 0) {
+        int micros = config.busyPollMicros;
+        if (setsockopt(sockfd, SOL_SOCKET, SO_BUSY_POLL, &micros, sizeof(micros)) < 0) {
+            std::cerr << "Failed to set SO_BUSY_POLL: " << strerror(errno) << std::endl;
+        }
     }
 
     // Bind socket to port
@@ -61,15 +129,77 @@ bool UDPReceiver::start() {
         std::cerr << "Failed to bind socket to port " << port << ": "
                   << strerror(errno) << std::endl;
         close(sockfd);
-        sockfd = -1;
+        return -1;
+    }
+    return sockfd;
+}
+
+bool UDPReceiver::start() {
+    if (running) {
+        std::cerr << "UDP Receiver already running" << std::endl;
         return false;
     }
 
-    // Start receive thread
+    int threads = config.threads > 1 ? config.threads : 1;
+    for (int i = 0; i < threads; i++) {
+        std::unique_ptr<Shard> shard(new Shard);
+        shard->index = i;
+        shard->sockfd = openSocket();
+        if (shard->sockfd < 0) {
+            closeShards();
+            return false;
+        }
+        shards.push_back(std::move(shard));
+    }
+
+    activeBackend = requestedBackend;
+    if (activeBackend == UDP_BACKEND_IO_URING) {
+        for (size_t i = 0; i < shards.size(); i++) {
+            if (!shards[i]->uring.open(shards[i]->sockfd)) {
+                std::cerr << "UDP Receiver: io_uring unavailable (" << shards[i]->uring.getError()
+                          << "), using recvmmsg" << std::endl;
+                activeBackend = UDP_BACKEND_RECVMMSG;
+                break;
+            }
+        }
+        if (activeBackend != UDP_BACKEND_IO_URING) {
+            for (size_t i = 0; i < shards.size(); i++) shards[i]->uring.close();
+        }
+    }
+
+    // Start receive threads
+    rateWindowStart = std::chrono::steady_clock::now();
+    rateWindowStartPackets = 0;
+    rateWindowStartBytes = bytesReceived.load(std::memory_order_relaxed);
+    for (int s = 0; s <= PACKET_OUT_OF_RANGE; s++) {
+        rateWindowStartPackets += statusCounts[s].load(std::memory_order_relaxed);
+    }
     running = true;
-    receiveThread = std::thread(&UDPReceiver::receiveLoop, this);
+    for (size_t i = 0; i < shards.size(); i++) {
+        Shard* shard = shards[i].get();
+        shard->thread = std::thread(&UDPReceiver::receiveLoop, this, shard);
+
+        if (config.cpu >= 0) {
+            cpu_set_t cpus;
+            CPU_ZERO(&cpus);
+            CPU_SET(config.cpu + shard->index, &cpus);
+            int err = pthread_setaffinity_np(shard->thread.native_handle(), sizeof(cpus), &cpus);
+            if (err != 0) {
+                std::cerr << "Failed to pin receive thread to CPU " << config.cpu + shard->index
+                          << ": " << strerror(err) << std::endl;
+            }
+        }
+    }
 
-    std::cout << "UDP Receiver started on port " << port << std::endl;
+    if (!metricsPath.empty()) {
+        metricsThread = std::thread(&UDPReceiver::metricsLoop, this);
+    }
+
+    std::cout << "UDP Receiver started on port " << port << " ("
+              << udpBackendName(activeBackend);
+    if (shards.size() > 1) std::cout << ", " << shards.size() << " threads";
+    if (config.spinPoll) std::cout << ", spin poll";
+    std::cout << ")" << std::endl;
     return true;
 }
 
@@ -78,84 +208,402 @@ void UDPReceiver::stop() {
         return;
     }
 
-    running = false;
+    {
+        std::lock_guard<std::mutex> lock(metricsMutex);
+        running = false;
+    }
+    metricsWake.notify_all();
+    if (metricsThread.joinable()) {
+        metricsThread.join();
+    }
+    closeShards();
+
+    std::cout << "UDP Receiver stopped" << std::endl;
+}
 
-    // Wait for thread to finish
-    if (receiveThread.joinable()) {
-        receiveThread.join();
+// Join the threads (they notice !running within a second), then close
+void UDPReceiver::closeShards() {
+    for (size_t i = 0; i < shards.size(); i++) {
+        if (shards[i]->thread.joinable()) {
+            shards[i]->thread.join();
+        }
     }
 
-    // Close socket
-    if (sockfd >= 0) {
-        close(sockfd);
-        sockfd = -1;
+    // Totals outlive the shards
+    for (size_t i = 0; i < shards.size(); i++) {
+        retiredKernelDrops.fetch_add(shards[i]->kernelDrops.load(std::memory_order_relaxed),
+                                     std::memory_order_relaxed);
+        retiredCpuSeconds.store(retiredCpuSeconds.load(std::memory_order_relaxed) +
+                                shards[i]->cpuSeconds.load(std::memory_order_relaxed),
+                                std::memory_order_relaxed);
+        shards[i]->uring.close();
+        if (shards[i]->sockfd >= 0) {
+            close(shards[i]->sockfd);
+        }
     }
+    shards.clear();
+}
 
-    std::cout << "UDP Receiver stopped" << std::endl;
+void UDPReceiver::receiveLoop(Shard* shard) {
+    if (activeBackend == UDP_BACKEND_IO_URING) {
+        receiveLoopUring(shard);
+    } else {
+        receiveLoopRecvmmsg(shard);
+    }
+    updateCpuTime(shard);
 }
 
-void UDPReceiver::receiveLoop() {
-    struct sockaddr_in clientAddr;
-    socklen_t clientAddrLen = sizeof(clientAddr);
-    JoystickInputPacket packet;
+void UDPReceiver::receiveLoopRecvmmsg(Shard* shard) {
+    // One recvmmsg() batch: datagrams land straight in the packet array
+    JoystickInputPacket packets[UDP_RECV_BATCH];
+    struct sockaddr_in clientAddrs[UDP_RECV_BATCH];
+    char controls[UDP_RECV_BATCH][CMSG_SPACE(sizeof(uint32_t)) + CMSG_SPACE(sizeof(struct timespec))];
+    struct iovec iovs[UDP_RECV_BATCH];
+    struct mmsghdr messages[UDP_RECV_BATCH];
+    uint32_t lengths[UDP_RECV_BATCH];
+    int64_t rxTimes[UDP_RECV_BATCH];
+
+    for (int i = 0; i < UDP_RECV_BATCH; i++) {
+        iovs[i].iov_base = &packets[i];
+        iovs[i].iov_len = sizeof(JoystickInputPacket);
+    }
+
+    // Blocks (up to SO_RCVTIMEO) for the first datagram only, then takes
+    // whatever else is queued; spin polling never blocks. MSG_TRUNC: the
+    // full datagram length even when it didn't fit, so oversized packets
+    // are rejected instead of read as their first 16 bytes.
+    int flags = (config.spinPoll ? MSG_DONTWAIT : MSG_WAITFORONE) | MSG_TRUNC;
 
     while (running) {
-        // Receive data
-        ssize_t bytesReceived = recvfrom(sockfd, &packet, sizeof(JoystickInputPacket),
-                                         0, (struct sockaddr*)&clientAddr,
-                                         &clientAddrLen);
+        memset(messages, 0, sizeof(messages));
+        for (int i = 0; i < UDP_RECV_BATCH; i++) {
+            messages[i].msg_hdr.msg_name = &clientAddrs[i];
+            messages[i].msg_hdr.msg_namelen = sizeof(clientAddrs[i]);
+            messages[i].msg_hdr.msg_iov = &iovs[i];
+            messages[i].msg_hdr.msg_iovlen = 1;
+            messages[i].msg_hdr.msg_control = controls[i];
+            messages[i].msg_hdr.msg_controllen = sizeof(controls[i]);
+        }
+
+        int received = recvmmsg(shard->sockfd, messages, UDP_RECV_BATCH, flags, nullptr);
+        updatePeriodic(shard);
 
-        if (bytesReceived < 0) {
+        if (received < 0) {
             if (errno == EAGAIN || errno == EWOULDBLOCK) {
                 // Timeout, continue loop
                 continue;
+            } else if (errno == EINTR) {
+                continue;
             } else {
+                socketErrors.fetch_add(1, std::memory_order_relaxed);
                 std::cerr << "Error receiving data: " << strerror(errno) << std::endl;
                 break;
             }
         }
+        if (received == 0) {
+            continue;
+        }
 
-        if (bytesReceived == sizeof(JoystickInputPacket)) {
-            // Validate packet data
-            bool valid = true;
-
-            // Check for NaN or infinity in float values
-            if (std::isnan(packet.rollInput) || std::isinf(packet.rollInput) ||
-                std::isnan(packet.pitchInput) || std::isinf(packet.pitchInput) ||
-                std::isnan(packet.yawInput) || std::isinf(packet.yawInput)) {
-                std::cerr << "UDP Receiver: Invalid float values (NaN/Inf) detected" << std::endl;
-                valid = false;
+        for (int i = 0; i < received; i++) {
+            lengths[i] = messages[i].msg_len;
+            if ((messages[i].msg_hdr.msg_flags & MSG_TRUNC) && lengths[i] <= sizeof(JoystickInputPacket)) {
+                lengths[i] = sizeof(JoystickInputPacket) + 1;
             }
 
-            // Check range validation (allow slightly beyond expected range for tolerance)
-            if (std::abs(packet.rollInput) > JOYSTICK_INPUT_TOLERANCE ||
-                std::abs(packet.pitchInput) > JOYSTICK_INPUT_TOLERANCE ||
-                std::abs(packet.yawInput) > JOYSTICK_INPUT_TOLERANCE) {
-                std::cerr << "UDP Receiver: Input values out of acceptable range (>"
-                          << JOYSTICK_INPUT_TOLERANCE << ")" << std::endl;
-                valid = false;
+            // Drop count is cumulative for the socket; the last one wins
+            rxTimes[i] = 0;
+            struct msghdr* header = &messages[i].msg_hdr;
+            for (struct cmsghdr* cmsg = CMSG_FIRSTHDR(header); cmsg != nullptr;
+                 cmsg = CMSG_NXTHDR(header, cmsg)) {
+                if (cmsg->cmsg_level != SOL_SOCKET) continue;
+                if (cmsg->cmsg_type == SO_RXQ_OVFL) {
+                    uint32_t drops;
+                    memcpy(&drops, CMSG_DATA(cmsg), sizeof(drops));
+                    shard->kernelDrops.store(drops, std::memory_order_relaxed);
+                } else if (cmsg->cmsg_type == SCM_TIMESTAMPNS) {
+                    struct timespec stamp;
+                    memcpy(&stamp, CMSG_DATA(cmsg), sizeof(stamp));
+                    rxTimes[i] = stamp.tv_sec * 1000000000LL + stamp.tv_nsec;
+                }
             }
+        }
 
-            // Only update if packet is valid
-            if (valid) {
-                // Update latest packet (thread-safe)
-                {
-                    std::lock_guard<std::mutex> lock(dataMutex);
-                    latestPacket = packet;
-                }
+        processBatch(packets, lengths, clientAddrs, rxTimes, received);
+    }
+}
 
-                if (!dataReceived) {
-                    dataReceived = true;
-                    std::cout << "UDP Receiver: First joystick packet received from "
-                              << inet_ntoa(clientAddr.sin_addr) << ":"
-                              << ntohs(clientAddr.sin_port) << std::endl;
-                }
+// Completions come straight off the shared ring; the one-second wait keeps
+// updatePeriodic() and the running check on the same cadence as SO_RCVTIMEO
+void UDPReceiver::receiveLoopUring(Shard* shard) {
+    JoystickInputPacket packets[UDP_RECV_BATCH];
+    struct sockaddr_in clientAddrs[UDP_RECV_BATCH];
+    uint32_t lengths[UDP_RECV_BATCH];
+    int64_t rxTimes[UDP_RECV_BATCH];
+    int timeoutMs = config.spinPoll ? 0 : 1000;
+
+    while (running) {
+        uint32_t drops = static_cast<uint32_t>(shard->kernelDrops.load(std::memory_order_relaxed));
+        int received = shard->uring.receive(packets, lengths, clientAddrs, rxTimes,
+                                            UDP_RECV_BATCH, timeoutMs, drops);
+        updatePeriodic(shard);
+
+        if (received < 0) {
+            socketErrors.fetch_add(1, std::memory_order_relaxed);
+            std::cerr << "Error receiving data: " << strerror(-received) << std::endl;
+            break;
+        }
+        shard->kernelDrops.store(drops, std::memory_order_relaxed);
+        if (received > 0) {
+            processBatch(packets, lengths, clientAddrs, rxTimes, received);
+        }
+    }
+}
+
+// Validate, count and publish one batch, whichever backend filled it
+void UDPReceiver::processBatch(const JoystickInputPacket* packets, const uint32_t* lengths,
+                               const sockaddr_in* clientAddrs, const int64_t* rxTimesNs,
+                               int received) {
+    JoystickPacketStatus statuses[UDP_RECV_BATCH];
+    uint64_t accepted = validateJoystickBatch(packets, lengths, received, statuses);
+    countBatch(statuses, lengths, received);
+
+    if (accepted != ~0ull >> (64 - received)) {
+        // One throttle check per reason per batch, with the first length seen
+        uint64_t rejected[PACKET_OUT_OF_RANGE + 1] = {0, 0, 0, 0};
+        uint32_t firstLength[PACKET_OUT_OF_RANGE + 1] = {0, 0, 0, 0};
+        for (int i = 0; i < received; i++) {
+            if (statuses[i] != PACKET_OK && rejected[statuses[i]]++ == 0) {
+                firstLength[statuses[i]] = lengths[i];
             }
-        } else {
-            std::cerr << "Received invalid packet size: " << bytesReceived
-                      << " (expected " << sizeof(JoystickInputPacket) << ")" << std::endl;
         }
+        int64_t nowNs = std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count();
+        for (int s = PACKET_OK + 1; s <= PACKET_OUT_OF_RANGE; s++) {
+            if (rejected[s] != 0) {
+                logRejected(static_cast<JoystickPacketStatus>(s), firstLength[s], rejected[s], nowNs);
+            }
+        }
+    }
+
+    if (accepted != 0) {
+        // Newest accepted packet wins; earlier ones in the batch are superseded
+        int newest = 63 - __builtin_clzll(accepted);
+        profilerCount(COUNTER_UDP_PACKETS, __builtin_popcountll(accepted));
+
+        // Update latest packet (thread-safe)
+        {
+            std::lock_guard<std::mutex> lock(dataMutex);
+            latestPacket = packets[newest];
+        }
+        if (rxTimesNs[newest] != 0) recordLatency(rxTimesNs[newest]);
+
+        if (!dataReceived.exchange(true)) {
+            std::cout << "UDP Receiver: First joystick packet received from "
+                      << inet_ntoa(clientAddrs[newest].sin_addr) << ":"
+                      << ntohs(clientAddrs[newest].sin_port) << std::endl;
+        }
+    }
+}
+
+// Counters are bumped once per batch, not once per packet
+void UDPReceiver::countBatch(const JoystickPacketStatus* statuses, const uint32_t* lengths, int count) {
+    uint64_t perStatus[PACKET_OUT_OF_RANGE + 1] = {0, 0, 0, 0};
+    uint64_t bytes = 0;
+    for (int i = 0; i < count; i++) {
+        perStatus[statuses[i]]++;
+        bytes += lengths[i];
+    }
+
+    for (int s = 0; s <= PACKET_OUT_OF_RANGE; s++) {
+        if (perStatus[s] != 0) statusCounts[s].fetch_add(perStatus[s], std::memory_order_relaxed);
     }
+    bytesReceived.fetch_add(bytes, std::memory_order_relaxed);
+}
+
+// Kernel receive timestamp to the packet being handed out by getLatestInput()
+void UDPReceiver::recordLatency(int64_t rxTimeNs) {
+    struct timespec now;
+    clock_gettime(CLOCK_REALTIME, &now);
+    int64_t latency = now.tv_sec * 1000000000LL + now.tv_nsec - rxTimeNs;
+    if (latency < 0) return;
+
+    uint64_t ns = static_cast<uint64_t>(latency);
+    latencySumNs.fetch_add(ns, std::memory_order_relaxed);
+    latencyCount.fetch_add(1, std::memory_order_relaxed);
+    uint64_t max = latencyMaxNs.load(std::memory_order_relaxed);
+    while (ns > max && !latencyMaxNs.compare_exchange_weak(max, ns, std::memory_order_relaxed)) {
+    }
+}
+
+// A flood of bad packets must not turn this thread into a terminal writer:
+// one line per reason per UDP_LOG_INTERVAL_SECONDS, with the number folded
+// in. count packets of this reason arrived in the batch. Deciding who logs is
+// a load and a compare-exchange, so shards in a flood never queue on a lock;
+// only the winner takes logMutex, to write its line.
+void UDPReceiver::logRejected(JoystickPacketStatus status, size_t length, uint64_t count,
+                              int64_t nowNs) {
+    const int64_t intervalNs = static_cast<int64_t>(UDP_LOG_INTERVAL_SECONDS * 1e9);
+    int64_t last = lastLogNs[status].load(std::memory_order_relaxed);
+    if ((last != 0 && nowNs - last < intervalNs) ||
+        !lastLogNs[status].compare_exchange_strong(last, nowNs, std::memory_order_relaxed)) {
+        suppressedLogs[status].fetch_add(count, std::memory_order_relaxed);
+        return;
+    }
+    uint64_t suppressed = suppressedLogs[status].exchange(0, std::memory_order_relaxed) + count - 1;
+    double sinceLast = (nowNs - last) * 1e-9;
+
+    std::lock_guard<std::mutex> lock(logMutex);
+
+    if (status == PACKET_BAD_SIZE) {
+        std::cerr << "Received invalid packet size: " << length
+                  << " (expected " << sizeof(JoystickInputPacket) << ")";
+    } else if (status == PACKET_NOT_FINITE) {
+        std::cerr << "UDP Receiver: Invalid float values (NaN/Inf) detected";
+    } else {
+        std::cerr << "UDP Receiver: Input values out of acceptable range (>"
+                  << JOYSTICK_INPUT_TOLERANCE << ")";
+    }
+    if (suppressed != 0) {
+        std::cerr << " [" << suppressed << " more";
+        if (last != 0) std::cerr << " in the last " << sinceLast << " s";
+        std::cerr << "]";
+    }
+    std::cerr << std::endl;
+}
+
+// Every receive thread wakes at least once a second (SO_RCVTIMEO or the
+// io_uring wait): each refreshes its own CPU time, the first one the rates
+void UDPReceiver::updatePeriodic(Shard* shard) {
+    if (shard->index == 0) updateRates();
+
+    std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+    if (std::chrono::duration<double>(now - shard->cpuSampleTime).count() >= UDP_RATE_WINDOW_SECONDS) {
+        shard->cpuSampleTime = now;
+        updateCpuTime(shard);
+    }
+}
+
+// Refresh the per-second gauges from the shared totals, so they decay to
+// zero when traffic stops
+void UDPReceiver::updateRates() {
+    std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+    double elapsed = std::chrono::duration<double>(now - rateWindowStart).count();
+    if (elapsed < UDP_RATE_WINDOW_SECONDS) return;
+
+    uint64_t packets = 0;
+    for (int s = 0; s <= PACKET_OUT_OF_RANGE; s++) {
+        packets += statusCounts[s].load(std::memory_order_relaxed);
+    }
+    uint64_t bytes = bytesReceived.load(std::memory_order_relaxed);
+    packetsPerSec.store((packets - rateWindowStartPackets) / elapsed, std::memory_order_relaxed);
+    bytesPerSec.store((bytes - rateWindowStartBytes) / elapsed, std::memory_order_relaxed);
+    rateWindowStartPackets = packets;
+    rateWindowStartBytes = bytes;
+    rateWindowStart = now;
+
+    uint64_t latencies = latencyCount.exchange(0, std::memory_order_relaxed);
+    uint64_t latencySum = latencySumNs.exchange(0, std::memory_order_relaxed);
+    uint64_t latencyMax = latencyMaxNs.exchange(0, std::memory_order_relaxed);
+    latencyMeanMicros.store(latencies != 0 ? latencySum / 1000.0 / latencies : 0.0,
+                            std::memory_order_relaxed);
+    latencyMaxMicros.store(latencyMax / 1000.0, std::memory_order_relaxed);
+}
+
+// From the shard's own thread: CPU time it has used so far, for comparing
+// backends and tuning
+void UDPReceiver::updateCpuTime(Shard* shard) {
+    struct timespec ts;
+    if (clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts) == 0) {
+        shard->cpuSeconds.store(ts.tv_sec + ts.tv_nsec * 1e-9, std::memory_order_relaxed);
+    }
+}
+
+UDPReceiverStats UDPReceiver::getStats() const {
+    UDPReceiverStats stats;
+    stats.accepted = statusCounts[PACKET_OK].load(std::memory_order_relaxed);
+    stats.badSize = statusCounts[PACKET_BAD_SIZE].load(std::memory_order_relaxed);
+    stats.notFinite = statusCounts[PACKET_NOT_FINITE].load(std::memory_order_relaxed);
+    stats.outOfRange = statusCounts[PACKET_OUT_OF_RANGE].load(std::memory_order_relaxed);
+    stats.socketErrors = socketErrors.load(std::memory_order_relaxed);
+    stats.kernelDrops = retiredKernelDrops.load(std::memory_order_relaxed);
+    stats.cpuSeconds = retiredCpuSeconds.load(std::memory_order_relaxed);
+    for (size_t i = 0; i < shards.size(); i++) {
+        stats.kernelDrops += shards[i]->kernelDrops.load(std::memory_order_relaxed);
+        stats.cpuSeconds += shards[i]->cpuSeconds.load(std::memory_order_relaxed);
+    }
+    stats.bytes = bytesReceived.load(std::memory_order_relaxed);
+    stats.packetsPerSec = packetsPerSec.load(std::memory_order_relaxed);
+    stats.bytesPerSec = bytesPerSec.load(std::memory_order_relaxed);
+    stats.latencyMeanMicros = latencyMeanMicros.load(std::memory_order_relaxed);
+    stats.latencyMaxMicros = latencyMaxMicros.load(std::memory_order_relaxed);
+    return stats;
+}
+
+// Once a second until stop(), on its own thread so file I/O never stalls a
+// receive thread (not even a spinning one)
+void UDPReceiver::metricsLoop() {
+    std::unique_lock<std::mutex> lock(metricsMutex);
+    while (running) {
+        metricsWake.wait_for(lock, std::chrono::duration<double>(UDP_RATE_WINDOW_SECONDS));
+        if (!running) break;
+        lock.unlock();
+        writeMetrics(getStats());
+        lock.lock();
+    }
+}
+
+// Written to a temporary file and renamed, so a scraper never reads half a file
+bool UDPReceiver::writeMetrics(const UDPReceiverStats& stats) {
+    std::string tempPath = metricsPath + ".tmp";
+    FILE* file = fopen(tempPath.c_str(), "w");
+    if (!file) {
+        return false;
+    }
+
+    const char* results[] = {"accepted", "bad_size", "not_finite", "out_of_range"};
+    const uint64_t counts[] = {stats.accepted, stats.badSize, stats.notFinite, stats.outOfRange};
+
+    fprintf(file, "# HELP mercury_udp_packets_total Datagrams received, by validation result\n");
+    fprintf(file, "# TYPE mercury_udp_packets_total counter\n");
+    for (int i = 0; i < 4; i++) {
+        fprintf(file, "mercury_udp_packets_total{port=\"%d\",result=\"%s\"} %llu\n",
+                port, results[i], (unsigned long long)counts[i]);
+    }
+    fprintf(file, "# HELP mercury_udp_bytes_total Datagram bytes received\n");
+    fprintf(file, "# TYPE mercury_udp_bytes_total counter\n");
+    fprintf(file, "mercury_udp_bytes_total{port=\"%d\"} %llu\n",
+            port, (unsigned long long)stats.bytes);
+    fprintf(file, "# HELP mercury_udp_socket_errors_total Failed receive calls\n");
+    fprintf(file, "# TYPE mercury_udp_socket_errors_total counter\n");
+    fprintf(file, "mercury_udp_socket_errors_total{port=\"%d\"} %llu\n",
+            port, (unsigned long long)stats.socketErrors);
+    fprintf(file, "# HELP mercury_udp_kernel_drops_total Datagrams dropped by the kernel, receive queue full\n");
+    fprintf(file, "# TYPE mercury_udp_kernel_drops_total counter\n");
+    fprintf(file, "mercury_udp_kernel_drops_total{port=\"%d\"} %llu\n",
+            port, (unsigned long long)stats.kernelDrops);
+    fprintf(file, "# HELP mercury_udp_packets_per_second Datagrams received over the last second\n");
+    fprintf(file, "# TYPE mercury_udp_packets_per_second gauge\n");
+    fprintf(file, "mercury_udp_packets_per_second{port=\"%d\"} %.1f\n", port, stats.packetsPerSec);
+    fprintf(file, "# HELP mercury_udp_bytes_per_second Datagram bytes received over the last second\n");
+    fprintf(file, "# TYPE mercury_udp_bytes_per_second gauge\n");
+    fprintf(file, "mercury_udp_bytes_per_second{port=\"%d\"} %.1f\n", port, stats.bytesPerSec);
+    fprintf(file, "# HELP mercury_udp_receive_cpu_seconds_total CPU time used by the receive thread\n");
+    fprintf(file, "# TYPE mercury_udp_receive_cpu_seconds_total counter\n");
+    fprintf(file, "mercury_udp_receive_cpu_seconds_total{port=\"%d\",backend=\"%s\"} %.3f\n",
+            port, udpBackendName(activeBackend), stats.cpuSeconds);
+    fprintf(file, "# HELP mercury_udp_receive_latency_seconds Kernel receive to input handoff over the last second\n");
+    fprintf(file, "# TYPE mercury_udp_receive_latency_seconds gauge\n");
+    fprintf(file, "mercury_udp_receive_latency_seconds{port=\"%d\",stat=\"mean\"} %.9f\n",
+            port, stats.latencyMeanMicros * 1e-6);
+    fprintf(file, "mercury_udp_receive_latency_seconds{port=\"%d\",stat=\"max\"} %.9f\n",
+            port, stats.latencyMaxMicros * 1e-6);
+
+    bool ok = (fclose(file) == 0);
+    if (!ok || rename(tempPath.c_str(), metricsPath.c_str()) != 0) {
+        remove(tempPath.c_str());
+        return false;
+    }
+    return true;
 }
 
 bool UDPReceiver::getLatestInput(JoystickInputPacket& packet) {
@@ -168,6 +616,10 @@ bool UDPReceiver::getLatestInput(JoystickInputPacket& packet) {
     return true;
 }
 
+void UDPReceiver::describeSource(char* text, size_t size) const {
+    snprintf(text, size, "UDP port %d", port);
+}
+
 void UDPReceiver::reset() {
     std::lock_guard<std::mutex> lock(dataMutex);
     dataReceived = false;
@@ -2,12 +2,59 @@
 #define UDP_RECEIVER_H
 
 #include "udp_protocol.h"
+#include "udp_batch.h"
+#include "udp_uring.h"
+#include "input_source.h"
 #include <string>
 #include <atomic>
 #include <thread>
 #include <mutex>
+#include <condition_variable>
+#include <chrono>
+#include <memory>
+#include <vector>
 
-class UDPReceiver {
+// Counter snapshot: totals since start(), rates over the last second
+struct UDPReceiverStats {
+    uint64_t accepted = 0;
+    uint64_t badSize = 0;        // Truncated or oversized datagrams
+    uint64_t notFinite = 0;      // NaN/Inf axis
+    uint64_t outOfRange = 0;     // |axis| > JOYSTICK_INPUT_TOLERANCE
+    uint64_t socketErrors = 0;
+    uint64_t kernelDrops = 0;    // Dropped by the kernel, socket queue full (SO_RXQ_OVFL)
+    uint64_t bytes = 0;          // All datagrams, valid or not
+    double packetsPerSec = 0.0;
+    double bytesPerSec = 0.0;
+    double cpuSeconds = 0.0;     // Receive thread CPU time, all threads
+    // Kernel receive timestamp to getLatestInput() handoff of each batch's
+    // newest packet, over the last second (needs config.timestamps)
+    double latencyMeanMicros = 0.0;
+    double latencyMaxMicros = 0.0;
+};
+
+// How the receive thread gets datagrams out of the socket
+enum UDPReceiveBackend {
+    UDP_BACKEND_RECVMMSG,        // Blocking recvmmsg() batches (default, portable fallback)
+    UDP_BACKEND_IO_URING         // Multishot recvmsg on io_uring, Linux 6.0+
+};
+
+const char* udpBackendName(UDPReceiveBackend backend);
+
+// Socket and thread tuning applied by start(); the defaults are the plain
+// blocking receiver. Options the kernel refuses are logged and skipped.
+struct UDPReceiverConfig {
+    int receiveBufferBytes = 0;  // SO_RCVBUF request (0: kernel default); SO_RCVBUFFORCE past rmem_max
+    int busyPollMicros = 0;      // SO_BUSY_POLL: poll the device queue this long before sleeping
+    int threads = 1;             // >1: one SO_REUSEPORT socket and thread each, kernel shards by source
+    int cpu = -1;                // Pin receive thread i to CPU cpu + i (-1: unpinned)
+    bool spinPoll = false;       // Never sleep; a receive thread owns its core
+    bool timestamps = true;      // SO_TIMESTAMPNS, feeds the latency stats
+};
+
+// Datagrams taken per recvmmsg() call
+const int UDP_RECV_BATCH = 32;
+
+class UDPReceiver : public InputSource<UDPReceiver> {
 public:
     UDPReceiver(int port = UDP_DEFAULT_PORT);
     ~UDPReceiver();
@@ -30,19 +77,99 @@ public:
 
     // Get port number
     int getPort() const { return port; }
+    void describeSource(char* text, size_t size) const;
+
+    // Counters are lock-free; safe to call from any thread (not during start/stop)
+    UDPReceiverStats getStats() const;
+
+    // Set before start()
+    void setConfig(const UDPReceiverConfig& newConfig) { config = newConfig; }
+    const UDPReceiverConfig& getConfig() const { return config; }
+
+    // Backend to try at start(); io_uring falls back to recvmmsg() when
+    // the kernel refuses it. getBackend() reports the one in use.
+    void setBackend(UDPReceiveBackend backend) { requestedBackend = backend; }
+    UDPReceiveBackend getBackend() const { return activeBackend; }
+
+    // Rewrite this file once a second with the counters in Prometheus text
+    // format (node_exporter textfile collector or any scraper); set before start()
+    void setMetricsFile(const std::string& path) { metricsPath = path; }
 
 private:
-    void receiveLoop();
+    // One socket and the thread draining it; several with SO_REUSEPORT
+    struct Shard {
+        int index = 0;
+        int sockfd = -1;
+        std::thread thread;
+        UringUdpReceive uring;
+        std::atomic<uint64_t> kernelDrops{0};  // SO_RXQ_OVFL counts are per socket
+        std::atomic<double> cpuSeconds{0.0};
+        std::chrono::steady_clock::time_point cpuSampleTime;  // Own thread only
+    };
+
+    int openSocket();
+    void closeShards();
+    void receiveLoop(Shard* shard);
+    void receiveLoopRecvmmsg(Shard* shard);
+    void receiveLoopUring(Shard* shard);
+    void updatePeriodic(Shard* shard);
+    void updateCpuTime(Shard* shard);
+    void processBatch(const JoystickInputPacket* packets, const uint32_t* lengths,
+                      const sockaddr_in* clientAddrs, const int64_t* rxTimesNs, int count);
+    void countBatch(const JoystickPacketStatus* statuses, const uint32_t* lengths, int count);
+    void recordLatency(int64_t rxTimeNs);
+    void logRejected(JoystickPacketStatus status, size_t length, uint64_t count, int64_t nowNs);
+    void updateRates();
+    void metricsLoop();
+    bool writeMetrics(const UDPReceiverStats& stats);
 
     int port;
-    int sockfd;
+    UDPReceiverConfig config;
+    std::vector<std::unique_ptr<Shard>> shards;
     std::atomic<bool> running;
     std::atomic<bool> dataReceived;
-    std::thread receiveThread;
 
     // Thread-safe data storage
     std::mutex dataMutex;
     JoystickInputPacket latestPacket;
+
+    // Per JoystickPacketStatus, added to by every receive thread
+    std::atomic<uint64_t> statusCounts[PACKET_OUT_OF_RANGE + 1];
+    std::atomic<uint64_t> socketErrors;
+    std::atomic<uint64_t> bytesReceived;
+    std::atomic<double> packetsPerSec;
+    std::atomic<double> bytesPerSec;
+
+    // Latency over the current window, folded into the gauges by updateRates()
+    std::atomic<uint64_t> latencySumNs;
+    std::atomic<uint64_t> latencyCount;
+    std::atomic<uint64_t> latencyMaxNs;
+    std::atomic<double> latencyMeanMicros;
+    std::atomic<double> latencyMaxMicros;
+
+    // First receive thread only: rate window (from the shared totals)
+    std::chrono::steady_clock::time_point rateWindowStart;
+    uint64_t rateWindowStartPackets;
+    uint64_t rateWindowStartBytes;
+
+    // Log throttling, shared by the receive threads: the interval check is
+    // lock-free, logMutex only keeps the lines that do get written whole
+    std::mutex logMutex;
+    std::atomic<int64_t> lastLogNs[PACKET_OUT_OF_RANGE + 1];       // steady_clock, 0: never
+    std::atomic<uint64_t> suppressedLogs[PACKET_OUT_OF_RANGE + 1];
+
+    // Metrics file writer, off the receive threads
+    std::string metricsPath;
+    std::thread metricsThread;
+    std::mutex metricsMutex;
+    std::condition_variable metricsWake;
+
+    // Totals of shards closed by stop()
+    std::atomic<uint64_t> retiredKernelDrops;
+    std::atomic<double> retiredCpuSeconds;
+
+    UDPReceiveBackend requestedBackend;
+    UDPReceiveBackend activeBackend;
 };
 
 #endif // UDP_RECEIVER_H
@@ -0,0 +1,302 @@
+#include "udp_uring.h"
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#include <signal.h>
+#include <cerrno>
+#include <cstring>
+#include <ctime>
+
+#if UDP_URING_AVAILABLE
+
+// Provided buffer group used for the receive
+const uint16_t URING_BUFFER_GROUP = 0;
+
+static int uringSetup(unsigned entries, io_uring_params* params) {
+    return static_cast<int>(syscall(__NR_io_uring_setup, entries, params));
+}
+
+static int uringEnter(int fd, unsigned toSubmit, unsigned minComplete, unsigned flags,
+                      const void* arg, size_t argSize) {
+    return static_cast<int>(syscall(__NR_io_uring_enter, fd, toSubmit, minComplete, flags, arg, argSize));
+}
+
+static int uringRegister(int fd, unsigned opcode, const void* arg, unsigned count) {
+    return static_cast<int>(syscall(__NR_io_uring_register, fd, opcode, arg, count));
+}
+
+template <typename T>
+static T* ringField(void* base, uint32_t offset) {
+    return reinterpret_cast<T*>(static_cast<uint8_t*>(base) + offset);
+}
+
+UringUdpReceive::UringUdpReceive()
+    : ringFd(-1), sockfd(-1), ringMemory(MAP_FAILED), ringSize(0),
+      sqes(static_cast<io_uring_sqe*>(MAP_FAILED)), sqesSize(0),
+      sqHead(nullptr), sqTail(nullptr), sqMask(0), sqArray(nullptr),
+      cqHead(nullptr), cqTail(nullptr), cqMask(0), cqes(nullptr),
+      bufferRing(static_cast<io_uring_buf*>(MAP_FAILED)),
+      buffers(static_cast<uint8_t*>(MAP_FAILED)), bufferTail(0),
+      armed(false), pendingSubmit(0) {
+    memset(&recvTemplate, 0, sizeof(recvTemplate));
+}
+
+UringUdpReceive::~UringUdpReceive() {
+    close();
+}
+
+bool UringUdpReceive::fail(const char* what, int err) {
+    error = std::string(what) + ": " + strerror(err);
+    close();
+    return false;
+}
+
+bool UringUdpReceive::open(int socket) {
+    close();
+    sockfd = socket;
+
+    io_uring_params params;
+    memset(&params, 0, sizeof(params));
+    params.flags = IORING_SETUP_CQSIZE;
+    params.cq_entries = URING_CQ_ENTRIES;
+    ringFd = uringSetup(8, &params);
+    if (ringFd < 0) {
+        ringFd = -1;
+        return fail("io_uring_setup", errno);
+    }
+
+    // Single mmap for both rings (5.4+) and timed waits (5.11+)
+    if (!(params.features & IORING_FEAT_SINGLE_MMAP) || !(params.features & IORING_FEAT_EXT_ARG)) {
+        return fail("io_uring features", ENOTSUP);
+    }
+
+    size_t sqSize = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+    size_t cqSize = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+    ringSize = sqSize > cqSize ? sqSize : cqSize;
+    ringMemory = mmap(nullptr, ringSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+                      ringFd, IORING_OFF_SQ_RING);
+    if (ringMemory == MAP_FAILED) {
+        return fail("mmap rings", errno);
+    }
+
+    sqesSize = params.sq_entries * sizeof(io_uring_sqe);
+    sqes = static_cast<io_uring_sqe*>(mmap(nullptr, sqesSize, PROT_READ | PROT_WRITE,
+                                           MAP_SHARED | MAP_POPULATE, ringFd, IORING_OFF_SQES));
+    if (sqes == MAP_FAILED) {
+        return fail("mmap sqes", errno);
+    }
+
+    sqHead = ringField<unsigned>(ringMemory, params.sq_off.head);
+    sqTail = ringField<unsigned>(ringMemory, params.sq_off.tail);
+    sqMask = *ringField<unsigned>(ringMemory, params.sq_off.ring_mask);
+    sqArray = ringField<unsigned>(ringMemory, params.sq_off.array);
+    cqHead = ringField<unsigned>(ringMemory, params.cq_off.head);
+    cqTail = ringField<unsigned>(ringMemory, params.cq_off.tail);
+    cqMask = *ringField<unsigned>(ringMemory, params.cq_off.ring_mask);
+    cqes = ringField<io_uring_cqe>(ringMemory, params.cq_off.cqes);
+
+    // Provided buffer ring (5.19+): page-aligned entries plus the buffers
+    bufferRing = static_cast<io_uring_buf*>(mmap(nullptr, URING_BUFFER_COUNT * sizeof(io_uring_buf),
+                                                 PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0));
+    buffers = static_cast<uint8_t*>(mmap(nullptr, URING_BUFFER_COUNT * URING_BUFFER_SIZE,
+                                         PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0));
+    if (bufferRing == MAP_FAILED || buffers == MAP_FAILED) {
+        return fail("mmap buffers", errno);
+    }
+
+    io_uring_buf_reg reg;
+    memset(&reg, 0, sizeof(reg));
+    reg.ring_addr = reinterpret_cast<uint64_t>(bufferRing);
+    reg.ring_entries = URING_BUFFER_COUNT;
+    reg.bgid = URING_BUFFER_GROUP;
+    if (uringRegister(ringFd, IORING_REGISTER_PBUF_RING, &reg, 1) < 0) {
+        return fail("register buffer ring", errno);
+    }
+
+    bufferTail = 0;
+    for (unsigned i = 0; i < URING_BUFFER_COUNT; i++) {
+        recycle(static_cast<uint16_t>(i));
+    }
+
+    // Sizes the kernel lays out in each buffer: name, then control, then payload
+    recvTemplate.msg_namelen = sizeof(sockaddr_in);
+    recvTemplate.msg_controllen = CMSG_SPACE(sizeof(uint32_t)) + CMSG_SPACE(sizeof(timespec));
+
+    if (!arm()) {
+        return fail("arm recvmsg", ENOSPC);
+    }
+
+    // Submit now so an unsupported opcode/flag shows up here, not in the loop
+    if (uringEnter(ringFd, pendingSubmit, 0, 0, nullptr, 0) < 0) {
+        return fail("io_uring_enter", errno);
+    }
+    pendingSubmit = 0;
+
+    // Invalid requests complete inline during submission
+    if (*cqHead != __atomic_load_n(cqTail, __ATOMIC_ACQUIRE)) {
+        const io_uring_cqe* cqe = &cqes[*cqHead & cqMask];
+        if (cqe->res < 0 && cqe->res != -ENOBUFS) {
+            return fail("multishot recvmsg", -cqe->res);
+        }
+    }
+    return true;
+}
+
+void UringUdpReceive::close() {
+    if (bufferRing != MAP_FAILED) munmap(bufferRing, URING_BUFFER_COUNT * sizeof(io_uring_buf));
+    if (buffers != MAP_FAILED) munmap(buffers, URING_BUFFER_COUNT * URING_BUFFER_SIZE);
+    if (sqes != MAP_FAILED) munmap(sqes, sqesSize);
+    if (ringMemory != MAP_FAILED) munmap(ringMemory, ringSize);
+    if (ringFd >= 0) ::close(ringFd);
+
+    bufferRing = static_cast<io_uring_buf*>(MAP_FAILED);
+    buffers = static_cast<uint8_t*>(MAP_FAILED);
+    sqes = static_cast<io_uring_sqe*>(MAP_FAILED);
+    ringMemory = MAP_FAILED;
+    ringFd = -1;
+    armed = false;
+    pendingSubmit = 0;
+}
+
+// Queue the multishot recvmsg; submitted with the next io_uring_enter()
+bool UringUdpReceive::arm() {
+    unsigned tail = *sqTail;
+    if (tail - __atomic_load_n(sqHead, __ATOMIC_ACQUIRE) > sqMask) return false;
+
+    unsigned index = tail & sqMask;
+    io_uring_sqe* sqe = &sqes[index];
+    memset(sqe, 0, sizeof(*sqe));
+    sqe->opcode = IORING_OP_RECVMSG;
+    sqe->fd = sockfd;
+    sqe->addr = reinterpret_cast<uint64_t>(&recvTemplate);
+    sqe->len = 1;
+    sqe->ioprio = IORING_RECV_MULTISHOT;
+    sqe->flags = IOSQE_BUFFER_SELECT;
+    sqe->buf_group = URING_BUFFER_GROUP;
+
+    sqArray[index] = index;
+    __atomic_store_n(sqTail, tail + 1, __ATOMIC_RELEASE);
+    pendingSubmit++;
+    armed = true;
+    return true;
+}
+
+// Hand a buffer back to the kernel
+void UringUdpReceive::recycle(uint16_t bufferId) {
+    io_uring_buf* entry = &bufferRing[bufferTail & (URING_BUFFER_COUNT - 1)];
+    entry->addr = reinterpret_cast<uint64_t>(buffers + static_cast<size_t>(bufferId) * URING_BUFFER_SIZE);
+    entry->len = URING_BUFFER_SIZE;
+    entry->bid = bufferId;
+    bufferTail++;
+
+    // The ring tail overlays the first entry's resv field
+    __atomic_store_n(&bufferRing[0].resv, bufferTail, __ATOMIC_RELEASE);
+}
+
+int UringUdpReceive::receive(JoystickInputPacket* packets, uint32_t* lengths, sockaddr_in* from,
+                             int64_t* rxTimesNs, int max, int timeoutMs, uint32_t& kernelDrops) {
+    unsigned head = *cqHead;
+    unsigned tail = __atomic_load_n(cqTail, __ATOMIC_ACQUIRE);
+
+    // Spin polling: nothing to submit, so nothing to enter the kernel for
+    if (head == tail && timeoutMs == 0 && armed && pendingSubmit == 0) {
+        return 0;
+    }
+
+    // Sleep only when nothing is waiting (and re-arm on the way in)
+    if (head == tail && (max > 0 || pendingSubmit > 0)) {
+        if (!armed && !arm()) return -ENOSPC;
+
+        __kernel_timespec timeout;
+        timeout.tv_sec = timeoutMs / 1000;
+        timeout.tv_nsec = (timeoutMs % 1000) * 1000000LL;
+        io_uring_getevents_arg arg;
+        memset(&arg, 0, sizeof(arg));
+        arg.sigmask_sz = _NSIG / 8;
+        arg.ts = reinterpret_cast<uint64_t>(&timeout);
+
+        unsigned flags = IORING_ENTER_EXT_ARG | (max > 0 ? IORING_ENTER_GETEVENTS : 0);
+        int result = uringEnter(ringFd, pendingSubmit, max > 0 ? 1 : 0, flags, &arg, sizeof(arg));
+        if (result < 0 && errno != ETIME && errno != EINTR) return -errno;
+        if (result >= 0) pendingSubmit = 0;
+        tail = __atomic_load_n(cqTail, __ATOMIC_ACQUIRE);
+    }
+
+    int count = 0;
+    int failure = 0;
+    while (head != tail && count < max) {
+        const io_uring_cqe* cqe = &cqes[head & cqMask];
+        head++;
+
+        if (!(cqe->flags & IORING_CQE_F_MORE)) {
+            // Multishot ended (buffers ran out, error); re-armed before the next wait
+            armed = false;
+        }
+        if (cqe->res < 0) {
+            if (cqe->res != -ENOBUFS) failure = cqe->res;
+            continue;
+        }
+        if (!(cqe->flags & IORING_CQE_F_BUFFER)) continue;
+
+        uint16_t bufferId = static_cast<uint16_t>(cqe->flags >> IORING_CQE_BUFFER_SHIFT);
+        const uint8_t* buffer = buffers + static_cast<size_t>(bufferId) * URING_BUFFER_SIZE;
+        const io_uring_recvmsg_out* out = reinterpret_cast<const io_uring_recvmsg_out*>(buffer);
+        const uint8_t* name = buffer + sizeof(io_uring_recvmsg_out);
+        const uint8_t* control = name + recvTemplate.msg_namelen;
+        const uint8_t* payload = control + recvTemplate.msg_controllen;
+
+        // payloadlen is the datagram's full length even when it was truncated
+        size_t available = static_cast<size_t>(cqe->res) - (payload - buffer);
+        size_t copy = out->payloadlen < sizeof(JoystickInputPacket) ? out->payloadlen
+                                                                    : sizeof(JoystickInputPacket);
+        if (copy > available) copy = available;
+        memset(&packets[count], 0, sizeof(JoystickInputPacket));
+        memcpy(&packets[count], payload, copy);
+        lengths[count] = out->payloadlen;
+        memcpy(&from[count], name, sizeof(sockaddr_in));
+
+        // Walk the control messages with a msghdr view of this buffer
+        msghdr view;
+        memset(&view, 0, sizeof(view));
+        view.msg_control = const_cast<uint8_t*>(control);
+        view.msg_controllen = out->controllen;
+        rxTimesNs[count] = 0;
+        for (cmsghdr* cmsg = CMSG_FIRSTHDR(&view); cmsg != nullptr; cmsg = CMSG_NXTHDR(&view, cmsg)) {
+            if (cmsg->cmsg_level != SOL_SOCKET) continue;
+            if (cmsg->cmsg_type == SO_RXQ_OVFL) {
+                memcpy(&kernelDrops, CMSG_DATA(cmsg), sizeof(kernelDrops));
+            } else if (cmsg->cmsg_type == SCM_TIMESTAMPNS) {
+                timespec stamp;
+                memcpy(&stamp, CMSG_DATA(cmsg), sizeof(stamp));
+                rxTimesNs[count] = stamp.tv_sec * 1000000000LL + stamp.tv_nsec;
+            }
+        }
+
+        recycle(bufferId);
+        count++;
+    }
+    __atomic_store_n(cqHead, head, __ATOMIC_RELEASE);
+
+    if (count == 0 && failure != 0) return failure;
+    return count;
+}
+
+#else // !UDP_URING_AVAILABLE
+
+UringUdpReceive::UringUdpReceive() : ringFd(-1) {}
+
+UringUdpReceive::~UringUdpReceive() {}
+
+bool UringUdpReceive::open(int) {
+    error = "built without io_uring support (needs Linux 6.0 uapi headers)";
+    return false;
+}
+
+void UringUdpReceive::close() {}
+
+int UringUdpReceive::receive(JoystickInputPacket*, uint32_t*, sockaddr_in*, int64_t*, int, int,
+                             uint32_t&) {
+    return -ENOSYS;
+}
+
+#endif // UDP_URING_AVAILABLE
@@ -0,0 +1,110 @@
+#ifndef UDP_URING_H
+#define UDP_URING_H
+
+#include "udp_protocol.h"
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <string>
+
+#if defined(__has_include)
+#if __has_include(<linux/io_uring.h>)
+#include <linux/io_uring.h>
+#endif
+#endif
+
+// Multishot recvmsg and io_uring_recvmsg_out arrived with the 6.0 uapi
+// headers. Older headers build a stub whose open() always fails, so
+// UDPReceiver logs it and stays on recvmmsg().
+#ifdef IORING_RECV_MULTISHOT
+#define UDP_URING_AVAILABLE 1
+#else
+#define UDP_URING_AVAILABLE 0
+#endif
+
+/**
+ * io_uring Receive Backend
+ * One multishot IORING_OP_RECVMSG stays armed on the socket and the kernel
+ * picks a receive buffer for each datagram from a provided buffer ring, so
+ * a busy receiver reaps completions straight from shared memory: no system
+ * call per datagram or per batch while the completion queue has entries,
+ * one io_uring_enter() to sleep when it is empty.
+ *
+ * Raw system calls against <linux/io_uring.h>, no liburing dependency.
+ * Needs Linux 6.0 (multishot recvmsg), at build time for the headers and at
+ * run time for the kernel; open() fails cleanly on older kernels, where
+ * io_uring is disabled or in a build without it (UDP_URING_AVAILABLE 0),
+ * and UDPReceiver falls back to recvmmsg().
+ */
+
+// Provided receive buffers (power of two) and the completion queue depth
+const unsigned URING_BUFFER_COUNT = 512;
+const unsigned URING_CQ_ENTRIES = 4096;
+
+// recvmsg header + sockaddr_in + SO_RXQ_OVFL and SO_TIMESTAMPNS cmsgs +
+// payload; oversized datagrams are truncated and flagged, the full length
+// still reported
+const unsigned URING_BUFFER_SIZE = 128;
+
+class UringUdpReceive {
+public:
+    UringUdpReceive();
+    ~UringUdpReceive();
+
+    // Set up the rings and arm the multishot receive on sockfd
+    bool open(int sockfd);
+    void close();
+    bool isOpen() const { return ringFd >= 0; }
+
+    // Why open() failed
+    const std::string& getError() const { return error; }
+
+    /*
+     * Up to max datagrams, waiting at most timeoutMs for the first one
+     * (0: only look at the completion queue, no system call while armed).
+     * lengths are the full datagram sizes, rxTimesNs the SO_TIMESTAMPNS
+     * kernel receive times (0 when not enabled); kernelDrops is updated when
+     * a datagram carried the socket's SO_RXQ_OVFL count. Returns the count,
+     * 0 on timeout, -errno on failure.
+     */
+    int receive(JoystickInputPacket* packets, uint32_t* lengths, sockaddr_in* from,
+                int64_t* rxTimesNs, int max, int timeoutMs, uint32_t& kernelDrops);
+
+private:
+    int ringFd;
+    std::string error;
+
+#if UDP_URING_AVAILABLE
+    bool fail(const char* what, int err);
+    bool arm();
+    void recycle(uint16_t bufferId);
+
+    int sockfd;
+
+    // Mapped ring memory
+    void* ringMemory;
+    size_t ringSize;
+    io_uring_sqe* sqes;
+    size_t sqesSize;
+
+    unsigned* sqHead;
+    unsigned* sqTail;
+    unsigned sqMask;
+    unsigned* sqArray;
+    unsigned* cqHead;
+    unsigned* cqTail;
+    unsigned cqMask;
+    io_uring_cqe* cqes;
+
+    // Provided buffer ring and the buffers it hands out
+    io_uring_buf* bufferRing;
+    uint8_t* buffers;
+    uint16_t bufferTail;
+
+    // Template the multishot recvmsg reads; must outlive the request
+    msghdr recvTemplate;
+    bool armed;
+    unsigned pendingSubmit;
+#endif
+};
+
+#endif // UDP_URING_H
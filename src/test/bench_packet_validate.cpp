@@ -0,0 +1,121 @@
+// Benchmark: scalar validateJoystickPacket() vs the batch validator
+// Compile: make (see Makefile)
+// Usage: ./bench_packet_validate [--packets N] [--faults F] [--rounds N]
+//
+// Builds N packets with a fraction F of faults spread over wrong size,
+// NaN/Inf and out-of-range, then validates them in UDP_RECV_BATCH-sized
+// batches both ways. Every status must match; reports packets/s for each
+// path. Faults make the scalar branches unpredictable, so try --faults 0
+// and --faults 0.1.
+
+#include "udp_batch.h"
+#include "udp_receiver.h"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+#include <vector>
+
+static uint32_t nextRandom(uint32_t& state) {
+    state ^= state << 13;
+    state ^= state >> 17;
+    state ^= state << 5;
+    return state;
+}
+
+static void setAxis(JoystickInputPacket& packet, int axis, float value) {
+    if (axis == 0) packet.rollInput = value;
+    else if (axis == 1) packet.pitchInput = value;
+    else packet.yawInput = value;
+}
+
+static double secondsSince(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+int main(int argc, char* argv[]) {
+    int count = 1 << 20;
+    double faults = 0.1;
+    int rounds = 20;
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--packets") == 0 && i + 1 < argc) {
+            count = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--faults") == 0 && i + 1 < argc) {
+            faults = atof(argv[++i]);
+        } else if (strcmp(argv[i], "--rounds") == 0 && i + 1 < argc) {
+            rounds = atoi(argv[++i]);
+        } else {
+            fprintf(stderr, "Usage: %s [--packets N] [--faults F] [--rounds N]\n", argv[0]);
+            return 1;
+        }
+    }
+    if (count < UDP_RECV_BATCH || rounds < 1 || faults < 0.0 || faults > 1.0) {
+        fprintf(stderr, "Need at least %d packets, one round and 0 <= faults <= 1\n", UDP_RECV_BATCH);
+        return 1;
+    }
+    count -= count % UDP_RECV_BATCH;
+
+    std::vector<JoystickInputPacket> packets(count);
+    std::vector<uint32_t> lengths(count, sizeof(JoystickInputPacket));
+    uint32_t rng = 12345;
+    for (int i = 0; i < count; i++) {
+        JoystickInputPacket& packet = packets[i];
+        packet.rollInput = (nextRandom(rng) % 20001) / 100.0f - 100.0f;
+        packet.pitchInput = (nextRandom(rng) % 20001) / 100.0f - 100.0f;
+        packet.yawInput = (nextRandom(rng) % 20001) / 100.0f - 100.0f;
+        packet.timestamp = i;
+
+        if ((nextRandom(rng) % 1000000) >= faults * 1000000) continue;
+        int axis = nextRandom(rng) % 3;
+        switch (nextRandom(rng) % 4) {
+            case 0: lengths[i] = nextRandom(rng) % 64; break;
+            case 1: setAxis(packet, axis, std::numeric_limits<float>::quiet_NaN()); break;
+            case 2: setAxis(packet, axis, -std::numeric_limits<float>::infinity()); break;
+            default: setAxis(packet, axis, (nextRandom(rng) & 1) ? 150.5f : -1e30f); break;
+        }
+    }
+
+    std::vector<JoystickPacketStatus> scalar(count), batch(count);
+    uint64_t scalarAccepted = 0, batchAccepted = 0;
+
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    for (int round = 0; round < rounds; round++) {
+        for (int i = 0; i < count; i++) {
+            scalar[i] = validateJoystickPacket(packets[i], lengths[i]);
+            scalarAccepted += scalar[i] == PACKET_OK;
+        }
+    }
+    double scalarSeconds = secondsSince(start);
+
+    start = std::chrono::steady_clock::now();
+    for (int round = 0; round < rounds; round++) {
+        for (int i = 0; i < count; i += UDP_RECV_BATCH) {
+            uint64_t mask = validateJoystickBatch(&packets[i], &lengths[i], UDP_RECV_BATCH, &batch[i]);
+            batchAccepted += __builtin_popcountll(mask);
+        }
+    }
+    double batchSeconds = secondsSince(start);
+
+    int mismatches = 0;
+    for (int i = 0; i < count; i++) {
+        if (scalar[i] != batch[i]) mismatches++;
+    }
+
+    double total = static_cast<double>(count) * rounds;
+    printf("Packet validation: %d packets x %d rounds, %.1f%% faults, batches of %d (%s)\n",
+           count, rounds, faults * 100.0, UDP_RECV_BATCH,
+#if defined(__SSE2__)
+           "SSE2"
+#else
+           "scalar bit tests"
+#endif
+           );
+    printf("  %-8s %10.1f Mpps %8.2f ns/packet  accepted %llu\n", "scalar",
+           total / scalarSeconds / 1e6, scalarSeconds * 1e9 / total, (unsigned long long)scalarAccepted);
+    printf("  %-8s %10.1f Mpps %8.2f ns/packet  accepted %llu  (%.2fx)\n", "batch",
+           total / batchSeconds / 1e6, batchSeconds * 1e9 / total, (unsigned long long)batchAccepted,
+           scalarSeconds / batchSeconds);
+    printf("  %d status mismatches\n", mismatches);
+    return mismatches == 0 && scalarAccepted == batchAccepted ? 0 : 1;
+}
@@ -0,0 +1,194 @@
+// Shared-memory vs UDP input latency benchmark
+// Compile: make (see Makefile)
+// Usage: ./bench_shm_input [--packets N]
+//
+// Ping-pong between a writer and a reader thread: the writer hands over one
+// JoystickInputPacket, the reader timestamps its arrival and acknowledges,
+// then the next one goes. Three transports:
+//   shm-spin   ShmInputReceiver::getLatestInput() in a loop (the GUI polls)
+//   shm-futex  ShmInputReceiver::waitForInput() then getLatestInput()
+//   udp        loopback sendto() / blocking recv()
+// plus the per-call cost of publish() and of a poll with nothing new.
+// Cross-thread numbers include the scheduler: on a machine with fewer than
+// two free cores the spin figures are dominated by time slicing.
+
+#include "shm_input_receiver.h"
+#include <algorithm>
+#include <arpa/inet.h>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <netinet/in.h>
+#include <sched.h>
+#include <sys/socket.h>
+#include <thread>
+#include <unistd.h>
+#include <vector>
+
+const char* BENCH_SHM_NAME = "/mercury_input_bench";
+const int BENCH_UDP_PORT = 9899;
+
+static double nowNanos() {
+    return static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+
+static JoystickInputPacket makePacket(uint32_t sequence) {
+    JoystickInputPacket packet;
+    packet.rollInput = 10.0f;
+    packet.pitchInput = -20.0f;
+    packet.yawInput = 30.0f;
+    packet.timestamp = sequence;
+    return packet;
+}
+
+static void report(const char* name, std::vector<double>& samples) {
+    if (samples.empty()) {
+        printf("%-10s %10s\n", name, "failed");
+        return;
+    }
+    std::sort(samples.begin(), samples.end());
+    double sum = 0.0;
+    for (double s : samples) sum += s;
+    size_t n = samples.size();
+    printf("%-10s %10zu %10.2f %10.2f %10.2f %10.2f\n", name, n, sum / n / 1000.0,
+           samples[n / 2] / 1000.0, samples[n * 99 / 100] / 1000.0, samples[n - 1] / 1000.0);
+}
+
+// Writer publishes packet i, reader marks its arrival and acknowledges
+static std::vector<double> runShm(int packets, bool block) {
+    std::vector<double> latencies;
+    ShmInputReceiver receiver(BENCH_SHM_NAME);
+    ShmInputWriter writer;
+    if (!receiver.start() || !writer.open(BENCH_SHM_NAME)) {
+        std::cerr << "shared memory: " << writer.getError() << std::endl;
+        return latencies;
+    }
+
+    std::vector<double> sendTimes(packets);
+    std::atomic<int> acknowledged(-1);
+    std::thread reader([&]() {
+        JoystickInputPacket packet;
+        for (int i = 0; i < packets; i++) {
+            for (;;) {
+                if (block) receiver.waitForInput(100);
+                if (receiver.getLatestInput(packet) && packet.timestamp == static_cast<uint32_t>(i)) break;
+                if (!block) sched_yield();
+            }
+            latencies.push_back(nowNanos() - sendTimes[i]);
+            acknowledged.store(i, std::memory_order_release);
+        }
+    });
+
+    for (int i = 0; i < packets; i++) {
+        sendTimes[i] = nowNanos();
+        writer.publish(makePacket(i));
+        while (acknowledged.load(std::memory_order_acquire) != i) sched_yield();
+    }
+    reader.join();
+    return latencies;
+}
+
+static std::vector<double> runUdp(int packets) {
+    std::vector<double> latencies;
+    int rx = socket(AF_INET, SOCK_DGRAM, 0);
+    int tx = socket(AF_INET, SOCK_DGRAM, 0);
+    sockaddr_in addr;
+    memset(&addr, 0, sizeof(addr));
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons(BENCH_UDP_PORT);
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    if (rx < 0 || tx < 0 || bind(rx, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) < 0 ||
+        connect(tx, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) < 0) {
+        std::cerr << "udp: " << strerror(errno) << std::endl;
+        if (rx >= 0) close(rx);
+        if (tx >= 0) close(tx);
+        return latencies;
+    }
+
+    std::vector<double> sendTimes(packets);
+    std::atomic<int> acknowledged(-1);
+    std::thread reader([&]() {
+        JoystickInputPacket packet;
+        for (int i = 0; i < packets; i++) {
+            do {
+                if (recv(rx, &packet, sizeof(packet), 0) != sizeof(packet)) continue;
+            } while (packet.timestamp != static_cast<uint32_t>(i));
+            latencies.push_back(nowNanos() - sendTimes[i]);
+            acknowledged.store(i, std::memory_order_release);
+        }
+    });
+
+    for (int i = 0; i < packets; i++) {
+        JoystickInputPacket packet = makePacket(i);
+        sendTimes[i] = nowNanos();
+        send(tx, &packet, sizeof(packet), 0);
+        while (acknowledged.load(std::memory_order_acquire) != i) sched_yield();
+    }
+    reader.join();
+    close(rx);
+    close(tx);
+    return latencies;
+}
+
+// Single-thread cost of the two hot-path calls
+static void runCallCosts(int calls) {
+    ShmInputReceiver receiver(BENCH_SHM_NAME);
+    ShmInputWriter writer;
+    if (!receiver.start() || !writer.open(BENCH_SHM_NAME)) return;
+
+    JoystickInputPacket packet = makePacket(0);
+    double start = nowNanos();
+    for (int i = 0; i < calls; i++) {
+        packet.timestamp = i;
+        writer.publish(packet);
+    }
+    double publishNs = (nowNanos() - start) / calls;
+
+    receiver.getLatestInput(packet);
+    start = nowNanos();
+    int delivered = 0;
+    for (int i = 0; i < calls; i++) {
+        delivered += receiver.getLatestInput(packet);
+    }
+    double pollNs = (nowNanos() - start) / calls;
+
+    printf("publish()                  %8.1f ns/call\n", publishNs);
+    printf("getLatestInput(), no news  %8.1f ns/call (%d)\n", pollNs, delivered > 0);
+}
+
+int main(int argc, char* argv[]) {
+    int packets = 20000;
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--packets") == 0 && i + 1 < argc) {
+            packets = atoi(argv[++i]);
+        } else {
+            std::cerr << "Usage: " << argv[0] << " [--packets N]" << std::endl;
+            return 1;
+        }
+    }
+    if (packets < 1) packets = 1;
+
+    // The receivers' start/stop lines would interleave with the table
+    std::streambuf* coutBuffer = std::cout.rdbuf(nullptr);
+    std::vector<double> spin = runShm(packets, false);
+    std::vector<double> futex = runShm(packets, true);
+    std::vector<double> udp = runUdp(packets);
+    std::cout.rdbuf(coutBuffer);
+
+    printf("%d packets, one in flight, %u CPU(s)\n\n", packets, std::thread::hardware_concurrency());
+    printf("%-10s %10s %10s %10s %10s %10s\n", "transport", "packets", "mean us", "p50 us", "p99 us", "max us");
+    report("shm-spin", spin);
+    report("shm-futex", futex);
+    report("udp", udp);
+    printf("\n");
+
+    std::cout.rdbuf(nullptr);
+    runCallCosts(1000000);
+    std::cout.rdbuf(coutBuffer);
+    shm_unlink(BENCH_SHM_NAME);
+    return 0;
+}
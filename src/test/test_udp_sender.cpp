@@ -1,88 +1,518 @@
-// Test program to send joystick inputs to the GUI via UDP
-// Compile: g++ -o test_udp_sender test_udp_sender.cpp -I ../main
-// Usage: ./test_udp_sender [host] [port]
+// UDP load generator for the joystick receivers (desktop UDPReceiver, ESP32)
+// Compile: make (see Makefile; Linux only, uses sendmmsg)
+// Usage: ./test_udp_sender [options] [host] [port]
+//
+// Each source is a thread with its own socket (own source port) sending
+// JoystickInputPackets at --rate packets/s, paced against CLOCK_MONOTONIC
+// and handed to the kernel in sendmmsg() batches. The timestamp field
+// carries a per-source sequence number so a receiver can count loss and
+// reordering. Optional faults, each a fraction of packets:
+//   --malformed  truncated datagram (0..15 bytes)        -> PACKET_BAD_SIZE
+//   --oversize   datagram longer than the packet         -> PACKET_BAD_SIZE
+//   --nan        NaN or infinity in an axis              -> PACKET_NOT_FINITE
+//   --range      axis beyond JOYSTICK_INPUT_TOLERANCE    -> PACKET_OUT_OF_RANGE
+//   --reorder    swapped with the next packet in its batch
+// Achieved rate and per-kind counts are reported every second and at exit,
+// for comparison with what the receiver accepted.
+//
+// --shm NAME publishes into the shared-memory input ring instead (one
+// source; datagram-size faults don't apply), for gui_app --input shm.
 
-#include "../main/udp_protocol.h"
+#include "udp_protocol.h"
+#include "shm_input.h"
 #include <iostream>
+#include <vector>
+#include <thread>
+#include <atomic>
 #include <sys/socket.h>
 #include <netinet/in.h>
 #include <arpa/inet.h>
 #include <unistd.h>
+#include <signal.h>
 #include <cstring>
+#include <cerrno>
 #include <cmath>
+#include <cstdio>
 #include <cstdlib>
 #include <ctime>
+#include <limits>
 
-int main(int argc, char* argv[]) {
-    const char* host = (argc > 1) ? argv[1] : "127.0.0.1";
-    int port = (argc > 2) ? atoi(argv[2]) : UDP_DEFAULT_PORT;
+const int SENDER_MAX_BATCH = 1024;
+const size_t SENDER_OVERSIZE_MAX = 512;   // Largest oversized datagram
+const double SENDER_MAX_RATE = 1e6;
+
+// What goes into one datagram
+enum PacketKind {
+    KIND_VALID,
+    KIND_MALFORMED,
+    KIND_OVERSIZE,
+    KIND_NAN,
+    KIND_RANGE,
+    KIND_COUNT
+};
+
+static const char* KIND_NAMES[KIND_COUNT] = {"valid", "malformed", "oversize", "nan", "range"};
+
+struct SenderConfig {
+    const char* host = "127.0.0.1";
+    int port = UDP_DEFAULT_PORT;
+    double rate = 50.0;         // Packets/s per source
+    double duration = 0.0;      // Seconds, 0 = until Ctrl+C
+    int sources = 1;
+    int batch = 0;              // sendmmsg batch, 0 = from rate
+    int burst = 1;              // Packets per burst (bursts keep the average rate)
+    double faults[KIND_COUNT] = {0.0, 0.0, 0.0, 0.0, 0.0};
+    double reorder = 0.0;
+    unsigned seed = 0;
+    int sendBuffer = 0;         // SO_SNDBUF bytes, 0 = system default
+    const char* shmName = nullptr;  // Shared-memory ring instead of UDP
+};
+
+// Counters one source publishes; the main thread sums them for reports
+struct SourceStats {
+    std::atomic<uint64_t> sent{0};
+    std::atomic<uint64_t> bytes{0};
+    std::atomic<uint64_t> kinds[KIND_COUNT];
+    std::atomic<uint64_t> reordered{0};
+    std::atomic<uint64_t> sendErrors{0};    // Packets the kernel refused (ENOBUFS, ...)
+
+    SourceStats() {
+        for (int k = 0; k < KIND_COUNT; k++) kinds[k] = 0;
+    }
+};
+
+static std::atomic<bool> stopRequested(false);
+
+static void onSignal(int) {
+    stopRequested = true;
+}
+
+static double nowSeconds() {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+static void sleepSeconds(double seconds) {
+    if (seconds <= 0.0) return;
+    struct timespec ts;
+    ts.tv_sec = static_cast<time_t>(seconds);
+    ts.tv_nsec = static_cast<long>((seconds - ts.tv_sec) * 1e9);
+    nanosleep(&ts, nullptr);
+}
+
+// xorshift32: cheap, per source, reproducible with --seed
+static uint32_t nextRandom(uint32_t& state) {
+    state ^= state << 13;
+    state ^= state >> 17;
+    state ^= state << 5;
+    return state;
+}
+
+static double randomUnit(uint32_t& state) {
+    return nextRandom(state) / 4294967296.0;
+}
+
+static PacketKind pickKind(const SenderConfig& config, uint32_t& rng) {
+    double draw = randomUnit(rng);
+    for (int k = KIND_MALFORMED; k < KIND_COUNT; k++) {
+        if (draw < config.faults[k]) return static_cast<PacketKind>(k);
+        draw -= config.faults[k];
+    }
+    return KIND_VALID;
+}
+
+// Packed struct: assign the members, no pointers to them
+static void setAxis(JoystickInputPacket& packet, int axis, float value) {
+    if (axis == 0) packet.rollInput = value;
+    else if (axis == 1) packet.pitchInput = value;
+    else packet.yawInput = value;
+}
+
+// Fill one datagram; returns its length
+static size_t buildPacket(uint8_t* buffer, PacketKind kind, uint32_t sequence,
+                          double rate, uint32_t& rng) {
+    // Same sinusoids as the old test sender: slow roll, medium pitch, fast yaw
+    float time = static_cast<float>(sequence / rate);
+    JoystickInputPacket packet;
+    packet.rollInput = 50.0f * std::sin(time * 0.5f);
+    packet.pitchInput = 50.0f * std::sin(time * 1.0f);
+    packet.yawInput = 50.0f * std::sin(time * 2.0f);
+    packet.timestamp = sequence;
+
+    size_t length = sizeof(packet);
+
+    switch (kind) {
+        case KIND_MALFORMED:
+            length = nextRandom(rng) % sizeof(packet);
+            break;
+        case KIND_OVERSIZE:
+            length = sizeof(packet) + 1 + nextRandom(rng) % (SENDER_OVERSIZE_MAX - sizeof(packet));
+            memset(buffer + sizeof(packet), 0xA5, length - sizeof(packet));
+            break;
+        case KIND_NAN:
+            setAxis(packet, nextRandom(rng) % 3, (nextRandom(rng) & 1)
+                    ? std::numeric_limits<float>::quiet_NaN()
+                    : std::numeric_limits<float>::infinity());
+            break;
+        case KIND_RANGE:
+            setAxis(packet, nextRandom(rng) % 3, (nextRandom(rng) & 1) ? 1000.0f : -1000.0f);
+            break;
+        default:
+            break;
+    }
+
+    memcpy(buffer, &packet, sizeof(packet));
+    return length;
+}
 
-    // Create UDP socket
+static int openSocket(const SenderConfig& config, sockaddr_in& dest) {
     int sockfd = socket(AF_INET, SOCK_DGRAM, 0);
     if (sockfd < 0) {
-        std::cerr << "Failed to create socket" << std::endl;
-        return 1;
+        std::cerr << "Failed to create socket: " << strerror(errno) << std::endl;
+        return -1;
     }
 
-    // Setup server address
-    struct sockaddr_in serverAddr;
-    memset(&serverAddr, 0, sizeof(serverAddr));
-    serverAddr.sin_family = AF_INET;
-    serverAddr.sin_port = htons(port);
+    if (config.sendBuffer > 0 &&
+        setsockopt(sockfd, SOL_SOCKET, SO_SNDBUF, &config.sendBuffer, sizeof(config.sendBuffer)) < 0) {
+        std::cerr << "Failed to set SO_SNDBUF: " << strerror(errno) << std::endl;
+    }
 
-    if (inet_pton(AF_INET, host, &serverAddr.sin_addr) <= 0) {
-        std::cerr << "Invalid address: " << host << std::endl;
+    // Connected: the destination lives in the socket, not in every mmsghdr
+    if (connect(sockfd, reinterpret_cast<sockaddr*>(&dest), sizeof(dest)) < 0) {
+        std::cerr << "Failed to connect socket: " << strerror(errno) << std::endl;
         close(sockfd);
-        return 1;
+        return -1;
+    }
+    return sockfd;
+}
+
+// One source: pace against the clock, send whatever is due in batches
+static void runSource(const SenderConfig& config, sockaddr_in dest, int index, SourceStats& stats) {
+    int sockfd = openSocket(config, dest);
+    if (sockfd < 0) {
+        stopRequested = true;
+        return;
     }
 
-    std::cout << "UDP Joystick Test Sender" << std::endl;
-    std::cout << "========================" << std::endl;
-    std::cout << "Sending to " << host << ":" << port << std::endl;
-    std::cout << "Press Ctrl+C to stop" << std::endl;
-    std::cout << std::endl;
-    std::cout << "Sending sinusoidal joystick inputs..." << std::endl;
-    std::cout << "  - Roll:  Slow sine wave" << std::endl;
-    std::cout << "  - Pitch: Medium sine wave" << std::endl;
-    std::cout << "  - Yaw:   Fast sine wave" << std::endl;
-    std::cout << std::endl;
+    int batch = config.batch;
+    std::vector<uint8_t> buffers(static_cast<size_t>(batch) * SENDER_OVERSIZE_MAX);
+    std::vector<iovec> iov(batch);
+    std::vector<mmsghdr> messages(batch);
+    std::vector<PacketKind> kinds(batch);
+    memset(messages.data(), 0, messages.size() * sizeof(mmsghdr));
+    for (int i = 0; i < batch; i++) {
+        iov[i].iov_base = &buffers[static_cast<size_t>(i) * SENDER_OVERSIZE_MAX];
+        messages[i].msg_hdr.msg_iov = &iov[i];
+        messages[i].msg_hdr.msg_iovlen = 1;
+    }
 
-    // Seed random number generator and randomize initial time
-    srand(time(NULL));
-    float time = ((float)rand() / RAND_MAX) * 10.0f;  // Random time between 0 and 10
-    std::cout << "Starting with random time offset: " << time << std::endl;
-    std::cout << std::endl;
+    uint32_t rng = config.seed * 2654435761u + index * 40503u + 1u;
+    if (rng == 0) rng = 1;
+    uint32_t sequence = 0;
+    uint64_t total = 0;                       // Packets taken off the schedule
+    const double start = nowSeconds();
+    const double burstPeriod = config.burst / config.rate;
 
-    JoystickInputPacket packet;
-    uint32_t frameCount = 0;
+    while (!stopRequested) {
+        double elapsed = nowSeconds() - start;
+        if (config.duration > 0.0 && elapsed >= config.duration) break;
 
-    while (true) {
-        // Generate sinusoidal joystick inputs at different frequencies
-        packet.rollInput = 50.0f * sin(time * 0.5f);        // Slow oscillation
-        packet.pitchInput = 50.0f * sin(time * 1.0f);       // Medium oscillation
-        packet.yawInput = 50.0f * sin(time * 2.0f);         // Fast oscillation
-        packet.timestamp = frameCount++;
+        // Bursts: all of a burst's packets fall due at its start
+        uint64_t due = (static_cast<uint64_t>(elapsed / burstPeriod) + 1) * config.burst;
+        if (due <= total) {
+            sleepSeconds(std::min(burstPeriod * (total / config.burst) - elapsed, 0.001));
+            continue;
+        }
 
-        // Send packet
-        ssize_t bytesSent = sendto(sockfd, &packet, sizeof(packet), 0,
-                                   (struct sockaddr*)&serverAddr, sizeof(serverAddr));
+        int count = static_cast<int>(std::min<uint64_t>(due - total, batch));
+        for (int i = 0; i < count; i++) {
+            kinds[i] = pickKind(config, rng);
+            iov[i].iov_len = buildPacket(static_cast<uint8_t*>(iov[i].iov_base), kinds[i],
+                                         sequence++, config.rate, rng);
+        }
 
-        if (bytesSent < 0) {
-            std::cerr << "Failed to send packet" << std::endl;
-            break;
+        // Swap neighbours; the receiver sees their sequence numbers out of order
+        uint64_t reordered = 0;
+        for (int i = 0; i + 1 < count; i++) {
+            if (config.reorder > 0.0 && randomUnit(rng) < config.reorder) {
+                std::swap(iov[i], iov[i + 1]);
+                std::swap(kinds[i], kinds[i + 1]);
+                reordered += 2;
+                i++;
+            }
         }
 
-        // Print status for every packet
-        std::cout << "Sent packet " << frameCount
-                  << " - Roll: " << packet.rollInput
-                  << ", Pitch: " << packet.pitchInput
-                  << ", Yaw: " << packet.yawInput << std::endl;
+        int done = 0;
+        while (done < count && !stopRequested) {
+            int result = sendmmsg(sockfd, &messages[done], count - done, 0);
+            if (result < 0) {
+                if (errno == EINTR) continue;
+                // ENOBUFS, ECONNREFUSED (nobody listening) ...: count the
+                // packet as refused and carry on with the next one
+                stats.sendErrors.fetch_add(1, std::memory_order_relaxed);
+                done++;
+                continue;
+            }
+            uint64_t bytes = 0;
+            for (int i = done; i < done + result; i++) {
+                bytes += iov[i].iov_len;
+                stats.kinds[kinds[i]].fetch_add(1, std::memory_order_relaxed);
+            }
+            stats.sent.fetch_add(result, std::memory_order_relaxed);
+            stats.bytes.fetch_add(bytes, std::memory_order_relaxed);
+            done += result;
+        }
+        stats.reordered.fetch_add(reordered, std::memory_order_relaxed);
+        total += count;
 
-        // Increment time and sleep (every 5 minutes)
-        time += 0.2f;
-        sleep(300); // 300 seconds = 5 minutes
+        // Restore the iovec order for the next batch's buffers
+        for (int i = 0; i < count; i++) {
+            iov[i].iov_base = &buffers[static_cast<size_t>(i) * SENDER_OVERSIZE_MAX];
+        }
     }
 
     close(sockfd);
+}
+
+// The shared-memory writer: same pacing and packets, published one by one
+static void runShmSource(const SenderConfig& config, SourceStats& stats) {
+    ShmInputWriter writer;
+    if (!writer.open(config.shmName)) {
+        std::cerr << "Failed to open shared memory: " << writer.getError() << std::endl;
+        stopRequested = true;
+        return;
+    }
+
+    uint8_t buffer[sizeof(JoystickInputPacket)];
+    uint32_t rng = config.seed * 2654435761u + 1u;
+    if (rng == 0) rng = 1;
+    uint32_t sequence = 0;
+    uint64_t total = 0;
+    const double start = nowSeconds();
+    const double burstPeriod = config.burst / config.rate;
+
+    while (!stopRequested) {
+        double elapsed = nowSeconds() - start;
+        if (config.duration > 0.0 && elapsed >= config.duration) break;
+
+        uint64_t due = (static_cast<uint64_t>(elapsed / burstPeriod) + 1) * config.burst;
+        if (due <= total) {
+            sleepSeconds(std::min(burstPeriod * (total / config.burst) - elapsed, 0.001));
+            continue;
+        }
+
+        for (; total < due && !stopRequested; total++) {
+            PacketKind kind = pickKind(config, rng);
+            buildPacket(buffer, kind, sequence++, config.rate, rng);
+            JoystickInputPacket packet;
+            memcpy(&packet, buffer, sizeof(packet));
+            writer.publish(packet);
+            stats.kinds[kind].fetch_add(1, std::memory_order_relaxed);
+            stats.sent.fetch_add(1, std::memory_order_relaxed);
+            stats.bytes.fetch_add(sizeof(packet), std::memory_order_relaxed);
+        }
+    }
+}
+
+static void printUsage(const char* name) {
+    std::cerr << "Usage: " << name << " [options] [host] [port]\n"
+              << "  --rate PPS        packets per second per source (1 to 1000000, default 50)\n"
+              << "  --duration SEC    stop after SEC seconds (default: run until Ctrl+C)\n"
+              << "  --sources N       concurrent sources, one socket each (default 1)\n"
+              << "  --burst N         send in bursts of N back-to-back packets (same average rate)\n"
+              << "  --batch N         packets per sendmmsg call (default from rate, max "
+              << SENDER_MAX_BATCH << ")\n"
+              << "  --malformed F     fraction of truncated packets\n"
+              << "  --oversize F      fraction of oversized packets\n"
+              << "  --nan F           fraction of packets with a NaN/Inf axis\n"
+              << "  --range F         fraction of packets with an out-of-range axis\n"
+              << "  --reorder F       fraction of packets swapped with their neighbour\n"
+              << "  --sndbuf BYTES    socket send buffer size\n"
+              << "  --shm NAME        publish to shared memory NAME instead (e.g. "
+              << SHM_INPUT_DEFAULT_NAME << ")\n"
+              << "  --seed N          fault/reorder random seed (default 0)" << std::endl;
+}
+
+static bool parseArguments(int argc, char* argv[], SenderConfig& config) {
+    int positional = 0;
+    for (int i = 1; i < argc; i++) {
+        const char* arg = argv[i];
+        bool hasValue = i + 1 < argc;
+        if (strcmp(arg, "--rate") == 0 && hasValue) {
+            config.rate = atof(argv[++i]);
+        } else if (strcmp(arg, "--duration") == 0 && hasValue) {
+            config.duration = atof(argv[++i]);
+        } else if (strcmp(arg, "--sources") == 0 && hasValue) {
+            config.sources = atoi(argv[++i]);
+        } else if (strcmp(arg, "--burst") == 0 && hasValue) {
+            config.burst = atoi(argv[++i]);
+        } else if (strcmp(arg, "--batch") == 0 && hasValue) {
+            config.batch = atoi(argv[++i]);
+        } else if (strcmp(arg, "--malformed") == 0 && hasValue) {
+            config.faults[KIND_MALFORMED] = atof(argv[++i]);
+        } else if (strcmp(arg, "--oversize") == 0 && hasValue) {
+            config.faults[KIND_OVERSIZE] = atof(argv[++i]);
+        } else if (strcmp(arg, "--nan") == 0 && hasValue) {
+            config.faults[KIND_NAN] = atof(argv[++i]);
+        } else if (strcmp(arg, "--range") == 0 && hasValue) {
+            config.faults[KIND_RANGE] = atof(argv[++i]);
+        } else if (strcmp(arg, "--reorder") == 0 && hasValue) {
+            config.reorder = atof(argv[++i]);
+        } else if (strcmp(arg, "--sndbuf") == 0 && hasValue) {
+            config.sendBuffer = atoi(argv[++i]);
+        } else if (strcmp(arg, "--shm") == 0 && hasValue) {
+            config.shmName = argv[++i];
+        } else if (strcmp(arg, "--seed") == 0 && hasValue) {
+            config.seed = static_cast<unsigned>(strtoul(argv[++i], nullptr, 10));
+        } else if (arg[0] != '-' && positional == 0) {
+            config.host = arg;
+            positional++;
+        } else if (arg[0] != '-' && positional == 1) {
+            config.port = atoi(arg);
+            positional++;
+        } else {
+            return false;
+        }
+    }
+
+    double faultTotal = 0.0;
+    for (int k = KIND_MALFORMED; k < KIND_COUNT; k++) {
+        if (config.faults[k] < 0.0) return false;
+        faultTotal += config.faults[k];
+    }
+    if (config.rate < 1.0 || config.rate > SENDER_MAX_RATE) {
+        std::cerr << "--rate must be between 1 and " << SENDER_MAX_RATE << std::endl;
+        return false;
+    }
+    if (faultTotal > 1.0 || config.reorder < 0.0 || config.reorder > 1.0) {
+        std::cerr << "Fault fractions must add up to at most 1" << std::endl;
+        return false;
+    }
+    if (config.sources < 1 || config.burst < 1 || config.batch < 0 ||
+        config.batch > SENDER_MAX_BATCH || config.port <= 0 || config.port > 65535) {
+        return false;
+    }
+
+    if (config.shmName && (config.sources != 1 || config.faults[KIND_MALFORMED] > 0.0 ||
+                           config.faults[KIND_OVERSIZE] > 0.0 || config.reorder > 0.0)) {
+        std::cerr << "--shm takes one source and no size or reorder faults" << std::endl;
+        return false;
+    }
+
+    // Default batch: about a millisecond of packets, at least a burst
+    if (config.batch == 0) {
+        config.batch = static_cast<int>(std::ceil(config.rate / 1000.0));
+        config.batch = std::max(config.batch, config.burst);
+        config.batch = std::min(config.batch, SENDER_MAX_BATCH);
+    }
+    return true;
+}
+
+struct Totals {
+    uint64_t sent = 0;
+    uint64_t bytes = 0;
+    uint64_t kinds[KIND_COUNT] = {0, 0, 0, 0, 0};
+    uint64_t reordered = 0;
+    uint64_t sendErrors = 0;
+};
+
+static Totals sumStats(const std::vector<SourceStats>& stats) {
+    Totals totals;
+    for (const SourceStats& s : stats) {
+        totals.sent += s.sent.load(std::memory_order_relaxed);
+        totals.bytes += s.bytes.load(std::memory_order_relaxed);
+        for (int k = 0; k < KIND_COUNT; k++) {
+            totals.kinds[k] += s.kinds[k].load(std::memory_order_relaxed);
+        }
+        totals.reordered += s.reordered.load(std::memory_order_relaxed);
+        totals.sendErrors += s.sendErrors.load(std::memory_order_relaxed);
+    }
+    return totals;
+}
+
+int main(int argc, char* argv[]) {
+    SenderConfig config;
+    if (!parseArguments(argc, argv, config)) {
+        printUsage(argv[0]);
+        return 1;
+    }
+
+    // Setup server address
+    sockaddr_in serverAddr;
+    memset(&serverAddr, 0, sizeof(serverAddr));
+    serverAddr.sin_family = AF_INET;
+    serverAddr.sin_port = htons(config.port);
+    if (inet_pton(AF_INET, config.host, &serverAddr.sin_addr) <= 0) {
+        std::cerr << "Invalid address: " << config.host << std::endl;
+        return 1;
+    }
+
+    signal(SIGINT, onSignal);
+    signal(SIGTERM, onSignal);
+
+    std::cout << "UDP Joystick Load Generator" << std::endl;
+    std::cout << "===========================" << std::endl;
+    if (config.shmName) {
+        std::cout << "Publishing to shared memory " << config.shmName << ": " << config.rate
+                  << " pps, bursts of " << config.burst << std::endl;
+    } else {
+        std::cout << "Sending to " << config.host << ":" << config.port << ": " << config.sources
+                  << " source(s) x " << config.rate << " pps, bursts of " << config.burst
+                  << ", sendmmsg batch " << config.batch << std::endl;
+    }
+    if (config.duration <= 0.0) {
+        std::cout << "Press Ctrl+C to stop" << std::endl;
+    }
+    std::cout << std::endl;
+
+    std::vector<SourceStats> stats(config.sources);
+    std::vector<std::thread> threads;
+    if (config.shmName) {
+        threads.emplace_back(runShmSource, std::cref(config), std::ref(stats[0]));
+    } else {
+        for (int i = 0; i < config.sources; i++) {
+            threads.emplace_back(runSource, std::cref(config), serverAddr, i, std::ref(stats[i]));
+        }
+    }
+
+    // Once-a-second report from the summed counters
+    const double start = nowSeconds();
+    double lastReport = start;
+    Totals last;
+    while (!stopRequested) {
+        sleepSeconds(0.05);
+        double now = nowSeconds();
+        if (config.duration > 0.0 && now - start >= config.duration) break;
+        if (now - lastReport < 1.0) continue;
+
+        Totals current = sumStats(stats);
+        double interval = now - lastReport;
+        printf("%7.1f s  %10.0f pps  %8.2f Mbit/s  sent %llu  refused %llu\n",
+               now - start, (current.sent - last.sent) / interval,
+               (current.bytes - last.bytes) * 8.0 / interval / 1e6,
+               (unsigned long long)current.sent, (unsigned long long)current.sendErrors);
+        fflush(stdout);
+        last = current;
+        lastReport = now;
+    }
+
+    stopRequested = true;
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+
+    Totals totals = sumStats(stats);
+    double elapsed = nowSeconds() - start;
+    double target = config.rate * config.sources;
+    double achieved = totals.sent / elapsed;
+    printf("\nSent %llu packets (%llu bytes) in %.2f s: %.0f pps of %.0f target (%.1f%%)\n",
+           (unsigned long long)totals.sent, (unsigned long long)totals.bytes, elapsed,
+           achieved, target, 100.0 * achieved / target);
+    for (int k = 0; k < KIND_COUNT; k++) {
+        printf("  %-10s %llu\n", KIND_NAMES[k], (unsigned long long)totals.kinds[k]);
+    }
+    printf("  %-10s %llu\n", "reordered", (unsigned long long)totals.reordered);
+    printf("  %-10s %llu\n", "refused", (unsigned long long)totals.sendErrors);
     return 0;
 }